@@ -0,0 +1,220 @@
+#include "ARAStar_Solver.h"
+#include "Checkpoint.h"
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+ARAStar_Solver::ARAStar_Solver(const Maze& maze, double initialEpsilon, double epsilonStep,
+                               sf::Time deadline, const atomic<bool>* cancel)
+    : Solver(maze, 'R'),
+      m_cols(maze.getCols()),
+      m_epsilon(max(1.0, initialEpsilon)),
+      m_epsilonStep(max(0.01, epsilonStep)),
+      m_deadline(deadline),
+      m_cancel(cancel)
+{
+    size_t cells = (size_t)maze.getRows() * m_cols;
+    m_g.assign(cells, INF);
+    m_parentId.assign(cells, -1);
+    m_closedIteration.assign(cells, 0);
+    m_inOpen.assign(cells, 0);
+    m_inIncons.assign(cells, 0);
+
+    m_startId = start.first * m_cols + start.second;
+    m_goalId = goal.first * m_cols + goal.second;
+    m_g[m_startId] = 0;
+    push(m_startId);
+
+    // Start the algorithm's timer
+    m_clock.restart();
+}
+
+int ARAStar_Solver::heuristic(int cell) const {
+    // Manhattan distance
+    return abs(goal.first - cell / m_cols) + abs(goal.second - cell % m_cols);
+}
+
+void ARAStar_Solver::push(int cell) {
+    m_inOpen[cell] = 1;
+    m_open.push({key(cell), m_g[cell], cell});
+}
+
+bool ARAStar_Solver::expandOne() {
+    while (!m_open.empty()) {
+        Entry top = m_open.top();
+
+        // A newer entry for this cell was pushed, or it was already expanded
+        if (!m_inOpen[top.cell] || top.g != m_g[top.cell]) {
+            m_open.pop();
+            continue;
+        }
+
+        // Iteration done once no open node could still improve the goal
+        if (m_g[m_goalId] <= top.key) return false;
+
+        m_open.pop();
+        int cell = top.cell;
+        m_inOpen[cell] = 0;
+        m_closedIteration[cell] = m_iteration;
+
+        int r = cell / m_cols, c = cell % m_cols;
+        m_nodesExplored++;
+        if (grid[r][c] == ' ')
+            grid[r][c] = symbol;
+        logEvent(EventLog::Type::Expanded, r, c);
+
+        for (auto [dr, dc] : directions) {
+            int nr = r + dr, nc = c + dc;
+            if (!isInside(grid, nr, nc)) continue;
+            if (grid[nr][nc] == '#') continue;
+
+            int next = nr * m_cols + nc;
+            if (m_g[cell] + 1 >= m_g[next]) continue;
+            m_g[next] = m_g[cell] + 1;
+            m_parentId[next] = cell;
+
+            if (m_closedIteration[next] != m_iteration) {
+                push(next);
+                logEvent(EventLog::Type::Enqueued, nr, nc);
+            } else if (!m_inIncons[next]) {
+                // Already expanded this iteration: repaired in the next one
+                m_inIncons[next] = 1;
+                m_incons.push_back(next);
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+void ARAStar_Solver::finishIteration() {
+    if (m_g[m_goalId] >= INF) {
+        // Open list exhausted without reaching the goal: no path at all
+        stop();
+        return;
+    }
+
+    Solution s;
+    s.found = true;
+    s.epsilon = m_epsilon;
+    s.expanded = m_nodesExplored;
+    s.time = m_resumedTime + m_clock.getElapsedTime();
+    for (int cell = m_goalId; cell != -1; cell = m_parentId[cell]) {
+        s.path.push_back({cell / m_cols, cell % m_cols});
+    }
+    reverse(s.path.begin(), s.path.end());
+    s.cost = (int)s.path.size() - 1;
+
+    // g(goal) never increases, but the parent chain can be shorter than it;
+    // keep the earlier path if it is still the better one
+    if (!m_solutions.empty() && m_solutions.back().cost < s.cost) {
+        s.path = m_solutions.back().path;
+        s.cost = m_solutions.back().cost;
+    }
+
+    // Any better path has to pass through OPEN or INCONS, so the optimum is
+    // at least their smallest g + h
+    int lowest = INF;
+    for (const Entry& e : underlying(m_open)) {
+        if (m_inOpen[e.cell] && e.g == m_g[e.cell]) lowest = min(lowest, e.g + heuristic(e.cell));
+    }
+    for (int cell : m_incons) lowest = min(lowest, m_g[cell] + heuristic(cell));
+    s.bound = lowest >= INF ? 1.0 : min(m_epsilon, max(1.0, (double)s.cost / lowest));
+    double bound = s.bound;
+
+    // Iterations that neither shorten the path nor tighten the bound aren't
+    // reported as improvements
+    if (m_solutions.empty() || s.cost < m_solutions.back().cost || s.bound < m_solutions.back().bound) {
+        m_solutions.push_back(move(s));
+    }
+
+    if (m_epsilon <= 1.0 || bound <= 1.0) {
+        stop();
+    } else {
+        startNextIteration();
+    }
+}
+
+void ARAStar_Solver::startNextIteration() {
+    m_epsilon = max(1.0, m_epsilon - m_epsilonStep);
+    m_iteration++; // Empties CLOSED
+
+    // OPEN = OPEN + INCONS, each cell once, keyed with the new epsilon
+    vector<Entry> entries;
+    for (const Entry& e : underlying(m_open)) {
+        if (m_inOpen[e.cell] == 1 && e.g == m_g[e.cell]) {
+            m_inOpen[e.cell] = 2; // Taken
+            entries.push_back({key(e.cell), m_g[e.cell], e.cell});
+        }
+    }
+    for (int cell : m_incons) {
+        m_inIncons[cell] = 0;
+        if (m_inOpen[cell] == 2) continue;
+        m_inOpen[cell] = 2;
+        entries.push_back({key(cell), m_g[cell], cell});
+    }
+    m_incons.clear();
+    for (const Entry& e : entries) m_inOpen[e.cell] = 1;
+
+    m_open = priority_queue<Entry, vector<Entry>, greater<Entry>>(greater<Entry>(), move(entries));
+}
+
+void ARAStar_Solver::stop() {
+    m_timeTaken = m_resumedTime + m_clock.getElapsedTime();
+    if (m_solutions.empty()) {
+        found = false;
+        currentState = State::DONE;
+        return;
+    }
+
+    // Point the shared parent map along the best path, for getPath()
+    const vector<pair<int, int>>& path = m_solutions.back().path;
+    for (size_t i = 1; i < path.size(); ++i) {
+        parent[path[i].first][path[i].second] = path[i - 1];
+    }
+    found = true;
+    currentState = State::TRACING_PATH;
+    m_traceIndex = path.size() - 1;
+}
+
+void ARAStar_Solver::step() {
+
+    // Draw the best path found, goal to start
+    if (currentState == State::TRACING_PATH) {
+
+        // Count this node as part of the final path
+        m_pathLength++;
+
+        if (m_traceIndex == 0) {
+            currentState = State::DONE;
+            return;
+        }
+        auto [r, c] = m_solutions.back().path[m_traceIndex];
+        if (grid[r][c] != 'E') {
+            grid[r][c] = 'X';
+            logEvent(EventLog::Type::Path, r, c);
+        }
+        m_traceIndex--;
+        return;
+    }
+
+    if (currentState != State::SEARCHING) return;
+
+    bool cancelled = m_cancel && m_cancel->load(memory_order_relaxed);
+    bool late = m_deadline > sf::Time::Zero && m_clock.getElapsedTime() >= m_deadline;
+    if (cancelled || late) {
+        m_interrupted = true;
+        stop();
+        return;
+    }
+
+    if (!expandOne()) finishIteration();
+}
+
+size_t ARAStar_Solver::getMemoryBytes() const {
+    return Solver::getMemoryBytes() +
+           (m_g.capacity() + m_parentId.capacity() + m_incons.capacity()) * sizeof(int) +
+           m_closedIteration.capacity() * sizeof(unsigned) + m_inOpen.capacity() + m_inIncons.capacity() +
+           underlying(m_open).capacity() * sizeof(Entry);
+}
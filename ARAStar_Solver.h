@@ -0,0 +1,93 @@
+#ifndef ARASTAR_SOLVER_H
+#define ARASTAR_SOLVER_H
+
+#include "Solver.h"
+#include "Utils.h"
+#include <queue>
+#include <vector>
+#include <atomic>
+#include <utility>
+#include <SFML/System/Clock.hpp>
+
+// Anytime Repairing A* (Likhachev, Gordon & Thrun).
+// Runs weighted A* with f = g + epsilon * h, which finds a path quickly whose
+// cost is at most epsilon times optimal. Epsilon is then lowered step by step;
+// each new search reuses the previous g-values and only repairs the states
+// that became inconsistent, until epsilon reaches 1 (optimal) or the deadline
+// passes or the search is cancelled.
+//
+// Each step() expands one node. Every completed iteration is recorded as a
+// Solution with its proven suboptimality bound; when the search stops, the
+// best one is traced onto the grid like the other solvers.
+class ARAStar_Solver : public Solver {
+public:
+    struct Solution {
+        bool found = false;
+        double epsilon = 0;   // Inflation factor of the iteration that found it
+        double bound = 0;     // cost <= bound * optimal cost (proven, <= epsilon)
+        int cost = 0;         // Path length in moves
+        long long expanded = 0; // Total expansions when it was found
+        sf::Time time = sf::Time::Zero;
+        std::vector<std::pair<int, int>> path; // Start to goal
+    };
+
+    // deadline: stop searching after this much time (Zero = no deadline)
+    // cancel:   optional flag, checked every step (not owned)
+    explicit ARAStar_Solver(const Maze& maze, double initialEpsilon = 3.0, double epsilonStep = 0.5,
+                            sf::Time deadline = sf::Time::Zero, const std::atomic<bool>* cancel = nullptr);
+
+    void step() override;
+
+    // Performance HUD readings (see Solver.h)
+    std::size_t getOpenSetSize() const override { return m_open.size(); }
+    std::size_t getMemoryBytes() const override;
+
+    // Improvements found so far (shorter path or tighter bound), worst first
+    const std::vector<Solution>& getSolutions() const { return m_solutions; }
+    double getEpsilon() const { return m_epsilon; }
+    bool wasInterrupted() const { return m_interrupted; } // Deadline or cancel before epsilon 1
+
+private:
+    struct Entry {
+        double key;  // g + epsilon * h when pushed
+        int g;
+        int cell;
+        // Lowest key first; among equal keys prefer the deeper node
+        bool operator>(const Entry& o) const { return key != o.key ? key > o.key : g < o.g; }
+    };
+
+    static constexpr int INF = 1 << 30;
+
+    int heuristic(int cell) const;
+    double key(int cell) const { return m_g[cell] + m_epsilon * heuristic(cell); }
+    void push(int cell);
+    bool expandOne();           // false when the current iteration is complete
+    void finishIteration();
+    void startNextIteration();  // Lower epsilon, move INCONS into OPEN, re-key
+    void stop();                // Trace the best solution (if any) and finish
+
+    int m_cols;
+    int m_startId, m_goalId;
+    double m_epsilon;
+    double m_epsilonStep;
+    sf::Time m_deadline;
+    const std::atomic<bool>* m_cancel;
+    bool m_interrupted = false;
+
+    std::vector<int> m_g;
+    std::vector<int> m_parentId;
+    std::vector<unsigned> m_closedIteration; // == m_iteration: CLOSED this iteration
+    std::vector<char> m_inOpen;
+    std::vector<char> m_inIncons;
+    std::vector<int> m_incons;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> m_open;
+    unsigned m_iteration = 1;
+
+    std::vector<Solution> m_solutions;
+    std::size_t m_traceIndex = 0;
+
+    // Clock for timing the algorithm
+    sf::Clock m_clock;
+};
+
+#endif // ARASTAR_SOLVER_H
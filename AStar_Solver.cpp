@@ -1,20 +1,39 @@
 #include "AStar_Solver.h"
 #include <limits>
+#include "Checkpoint.h"
 #include <iostream>
+#include <algorithm>
 
 using namespace std;
 
-AStar_Solver::AStar_Solver(const Maze& maze)
-    : Solver(maze, 'A')
+// Cells A* is expected to touch: on these random mazes it grows roughly with
+// the square of the distance to the (nearest) goal
+static CellStorage pickStorage(const Maze& maze, CellStorage storage) {
+    if (storage != CellStorage::Auto) return storage;
+    size_t d = numeric_limits<size_t>::max();
+    for (auto [r, c] : maze.getGoals()) {
+        d = min(d, (size_t)(abs(maze.getStart().first - r) + abs(maze.getStart().second - c)));
+    }
+    return chooseCellStorage((size_t)maze.getRows() * maze.getCols(), d * d / 4 + 64 * (d + 1));
+}
+
+AStar_Solver::AStar_Solver(const Maze& maze, const Landmarks* landmarks, CellStorage storage,
+                           const RectangleSymmetry* symmetry, const GoalBounds* bounds)
+    : Solver(maze, 'A', pickStorage(maze, storage)),
+      m_landmarks(maze.getGoals().size() > 1 ? nullptr : landmarks),
+      m_symmetry(symmetry),
+      m_bounds(maze.getGoals().size() > 1 ? nullptr : bounds)
 {
+    if (maze.getGoals().size() > 1) m_goalIndex.build(maze.getGoals(), maze.getRows(), maze.getCols());
+
     int rows = maze.getRows();
     int cols = maze.getCols();
 
     // Initialize scores and visited grid
     //Using a 2D dynamic array (std::vector)
-    gScore.assign(rows, vector<vector<int>::value_type>(cols, numeric_limits<int>::max()));
+    gScore.reset(rows, cols, numeric_limits<int>::max(), getStorage());
     //Using a 2D boolean matrix
-    visited.assign(rows, vector<bool>(cols,false));
+    visited.reset(rows, cols, false, getStorage());
 
     gScore[start.first][start.second] = 0;
 
@@ -27,8 +46,15 @@ AStar_Solver::AStar_Solver(const Maze& maze)
 }
 
 int AStar_Solver::heuristic(int r, int c) const {
+    // Several goals: Manhattan distance to the nearest
+    if (m_goalIndex.size() > 1) return m_goalIndex.nearestDistance(r, c);
+
     // Manhattan distance
-    return abs(goal.first - r) + abs(goal.second - c);
+    int h = abs(goal.first - r) + abs(goal.second - c);
+
+    // Both are admissible, so their max is too
+    if (m_landmarks) h = max(h, m_landmarks->heuristic(r, c, goal));
+    return h;
 }
 
 void AStar_Solver::step() {
@@ -45,6 +71,7 @@ void AStar_Solver::step() {
         }
         if (grid[tracePos.first][tracePos.second] != 'E') {
             grid[tracePos.first][tracePos.second] = 'X'; // Mark final solution path
+            logEvent(EventLog::Type::Path, tracePos.first, tracePos.second);
         }
         tracePos = parent[tracePos.first][tracePos.second];
         return;
@@ -52,13 +79,17 @@ void AStar_Solver::step() {
 
     if (currentState != State::SEARCHING) return;
 
-    // No more nodes to explore 
+    // No more nodes to explore (some of several goals may have been reached)
     if (openSet.empty()) {
-        currentState = State::DONE;
-        found = false;
+        if (anyGoalReached()) {
+            if (m_symmetry) unfoldJumps();
+        } else {
+            currentState = State::DONE;
+            found = false;
+        }
         
         // Stop the clock if the search fails
-        m_timeTaken = m_clock.getElapsedTime();
+        m_timeTaken = m_resumedTime + m_clock.getElapsedTime();
         
         return;
     }
@@ -78,26 +109,36 @@ void AStar_Solver::step() {
         // Mark this cell as explored
         if (grid[r][c] == ' ')
             grid[r][c] = symbol;
+        logEvent(EventLog::Type::Expanded, r, c);
 
-        // Goal reached → switch to tracing mode
-        if (r == goal.first && c == goal.second) {
-            found = true;
-            currentState = State::TRACING_PATH;
-            tracePos = goal;
+        // Goal reached → switch to tracing mode. The heuristic is to the
+        // nearest goal, so goals are expanded nearest first.
+        if (isGoal(r, c) && goalReached(r, c)) {
+            if (m_symmetry) unfoldJumps();
             
             // Stop the clock on success
-            m_timeTaken = m_clock.getElapsedTime();
+            m_timeTaken = m_resumedTime + m_clock.getElapsedTime();
             
             return;
         }
 
         // Explore all 4 neighbours
-        for (auto [dr, dc] : directions) {
-            int nr = r + dr, nc = c + dc;
+        for (int d = 0; d < 4; ++d) {
+            int nr = r + directions[d].first, nc = c + directions[d].second;
             if (!isInside(grid, nr, nc)) continue;
             if (grid[nr][nc] == '#') continue;
 
-            int tentativeG = gScore[r][c] + 1;
+            // No shortest path to the goal leaves this way
+            if (m_bounds && !m_bounds->mayLeadTo(current.pos, d, goal)) {
+                m_movesPruned++;
+                continue;
+            }
+
+            // Straight across an empty rectangle instead of into it
+            int cost = 1;
+            if (m_symmetry) m_symmetry->jump(r, c, nr, nc, cost);
+
+            int tentativeG = gScore[r][c] + cost;
 
             // Found a better path to neighbour
             if (tentativeG < gScore[nr][nc]) {
@@ -105,6 +146,7 @@ void AStar_Solver::step() {
                 parent[nr][nc] = {r, c};
                 int f = tentativeG + heuristic(nr, nc);
                 openSet.push({f, {nr, nc}});
+                logEvent(EventLog::Type::Enqueued, nr, nc);
             }
         }
         // Process only one node per step() call (good for visualization)
@@ -117,6 +159,48 @@ void AStar_Solver::step() {
     found = false;
     
     if (m_timeTaken == sf::Time::Zero) { // Only set if not already set
-        m_timeTaken = m_clock.getElapsedTime();
+        m_timeTaken = m_resumedTime + m_clock.getElapsedTime();
     }
-}
\ No newline at end of file
+}
+
+bool AStar_Solver::saveState(CheckpointWriter& w) const {
+    if (m_severalGoals) return false;
+    saveBaseState(w, m_clock);
+
+    // Heap array as (score, r, c) triples, in its internal order
+    std::vector<int32_t> heap;
+    for (const NodeData& n : underlying(openSet)) {
+        heap.insert(heap.end(), {n.f, n.pos.first, n.pos.second});
+    }
+    w.array(heap);
+    w.matrix(gScore.toMatrix());
+    w.bits(visited.toMatrix());
+    return w.ok();
+}
+
+bool AStar_Solver::loadState(CheckpointReader& r) {
+    if (!loadBaseState(r)) return false;
+
+    std::vector<int32_t> heap;
+    r.array(heap);
+    std::vector<std::vector<int>> g;
+    std::vector<std::vector<bool>> closed;
+    r.matrix(g);
+    r.bits(closed);
+    gScore.fromMatrix(g);
+    visited.fromMatrix(closed);
+    auto& nodes = underlying(openSet);
+    nodes.clear();
+    for (size_t i = 0; i + 2 < heap.size(); i += 3) {
+        nodes.push_back({heap[i], {heap[i + 1], heap[i + 2]}});
+    }
+
+    // The search clock continues from the saved time
+    m_clock.restart();
+    return r.ok();
+}
+
+size_t AStar_Solver::getMemoryBytes() const {
+    return Solver::getMemoryBytes() + underlying(openSet).capacity() * sizeof(NodeData) +
+           gScore.getBytes() + visited.getBytes();
+}
@@ -3,6 +3,10 @@
 
 #include "Solver.h"
 #include "Utils.h"
+#include "Landmarks.h"
+#include "MazePruning.h"
+#include "GoalIndex.h"
+#include "GoalBounds.h"
 #include <queue>
 #include <vector>
 #include <utility>
@@ -10,10 +14,34 @@
 
 class AStar_Solver : public Solver {
 public:
-    explicit AStar_Solver(const Maze& maze);
+    // With landmarks, the heuristic is max(Manhattan, ALT). With several goals
+    // it is the Manhattan distance to the nearest (landmarks are ignored).
+    // storage: backend for gScore/visited/parent; Auto picks a sparse one
+    // when the search should only touch a small part of a large maze.
+    // symmetry (optional) skips the interiors of empty rectangles.
+    // bounds (optional) skips moves that start no shortest path to the goal;
+    // they only hold for one goal, so they are ignored with several.
+    explicit AStar_Solver(const Maze& maze, const Landmarks* landmarks = nullptr,
+                          CellStorage storage = CellStorage::Auto,
+                          const RectangleSymmetry* symmetry = nullptr,
+                          const GoalBounds* bounds = nullptr);
 
     void step() override;
 
+    // Performance HUD readings (see Solver.h)
+    std::size_t getOpenSetSize() const override { return openSet.size(); }
+    std::size_t getMemoryBytes() const override;
+
+    // Checkpointing (see Checkpoint.h)
+    bool saveState(CheckpointWriter& w) const override;
+    bool loadState(CheckpointReader& r) override;
+
+    // Memory held by gScore, visited and parent
+    std::size_t getStorageBytes() const { return gScore.getBytes() + visited.getBytes() + parent.getBytes(); }
+
+    // Moves skipped because their goal-bounding box missed the goal
+    long long getMovesPruned() const { return m_movesPruned; }
+
 private:
     using Node = std::pair<int, int>;
 
@@ -24,10 +52,15 @@ private:
 
     // Data structure: A min-priority-queue (binary heap)
     std::priority_queue<NodeData, std::vector<NodeData>, std::greater<NodeData>> openSet;
-    std::vector<std::vector<int>> gScore;
-    std::vector<std::vector<bool>> visited;
+    CellStore<int> gScore;
+    CellStore<bool> visited;
 
     int heuristic(int r, int c) const;
+    const Landmarks* m_landmarks; // Optional ALT tables (not owned)
+    const RectangleSymmetry* m_symmetry; // Optional RSR rectangles (not owned)
+    GoalIndex m_goalIndex; // Only built for several goals
+    const GoalBounds* m_bounds; // Optional goal-bounding boxes (not owned)
+    long long m_movesPruned = 0;
     
     // Clock for timing the algorithm
     sf::Clock m_clock;
@@ -0,0 +1,54 @@
+#include "AnytimeSearch.h"
+#include "Trace.h"
+#include <exception>
+
+using namespace std;
+
+AnytimeSearch::AnytimeSearch(const Maze& maze, Options options, function<void(const Solution&)> onImprovement)
+    : m_future(m_promise.get_future().share())
+{
+    // The solver copies what it needs from the maze before the constructor returns
+    promise<void> started;
+    future<void> ready = started.get_future();
+    m_thread = thread([this, &maze, options, onImprovement, &started]() {
+        Trace::setThreadName("anytime search");
+        TRACE_SCOPE("AnytimeSearch");
+        bool isStarted = false;
+        try {
+            ARAStar_Solver solver(maze, options.initialEpsilon, options.epsilonStep, options.deadline, &m_cancel);
+            started.set_value();
+            isStarted = true;
+
+            size_t seen = 0;
+            while (!solver.isFinished()) {
+                solver.step();
+                if (solver.getSolutions().size() == seen) continue;
+
+                // A new, better path
+                seen = solver.getSolutions().size();
+                {
+                    lock_guard<mutex> lock(m_mutex);
+                    m_best = solver.getSolutions().back();
+                }
+                if (onImprovement) onImprovement(solver.getSolutions().back());
+            }
+            m_promise.set_value(best());
+        } catch (...) {
+            // Hand the failure to whoever waits on the future instead of
+            // leaving the constructor or get() blocked forever
+            m_promise.set_exception(current_exception());
+            if (!isStarted) started.set_value();
+        }
+    });
+    ready.wait();
+}
+
+AnytimeSearch::~AnytimeSearch() {
+    cancel();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+AnytimeSearch::Solution AnytimeSearch::best() const {
+    lock_guard<mutex> lock(m_mutex);
+    return m_best;
+}
@@ -0,0 +1,58 @@
+#ifndef ANYTIMESEARCH_H
+#define ANYTIMESEARCH_H
+
+#include "ARAStar_Solver.h"
+#include <atomic>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+// Runs ARAStar_Solver on its own thread, for callers with a latency budget.
+//
+//     AnytimeSearch search(maze, {3.0, 0.5, sf::milliseconds(20)});
+//     auto result = search.getFuture();
+//     if (result.wait_for(budget) != std::future_status::ready) search.cancel();
+//     ARAStar_Solver::Solution best = result.get();
+//
+// The future resolves when the path is optimal, the deadline passes or the
+// search is cancelled, with the best solution so far (found == false if
+// there was none). best() can be polled at any time in between. If the
+// search itself throws, get() rethrows that exception.
+class AnytimeSearch {
+public:
+    using Solution = ARAStar_Solver::Solution;
+
+    struct Options {
+        double initialEpsilon = 3.0;
+        double epsilonStep = 0.5;
+        sf::Time deadline = sf::Time::Zero; // Zero = run until optimal or cancelled
+    };
+
+    // Starts searching immediately. onImprovement (optional) is called on the
+    // search thread for every new solution.
+    AnytimeSearch(const Maze& maze, Options options,
+                  std::function<void(const Solution&)> onImprovement = nullptr);
+    ~AnytimeSearch(); // Cancels and waits for the thread
+
+    AnytimeSearch(const AnytimeSearch&) = delete;
+    AnytimeSearch& operator=(const AnytimeSearch&) = delete;
+
+    std::shared_future<Solution> getFuture() const { return m_future; }
+
+    // Asks the search to stop; the future then resolves with the best so far
+    void cancel() { m_cancel.store(true, std::memory_order_relaxed); }
+
+    // Latest solution (found == false until the first one)
+    Solution best() const;
+
+private:
+    std::atomic<bool> m_cancel{false};
+    mutable std::mutex m_mutex;
+    Solution m_best;
+    std::promise<Solution> m_promise;
+    std::shared_future<Solution> m_future;
+    std::thread m_thread;
+};
+
+#endif // ANYTIMESEARCH_H
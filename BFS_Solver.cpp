@@ -1,5 +1,6 @@
 #include "BFS_Solver.h"
 #include <iostream>
+#include "Checkpoint.h"
 
 BFS_Solver::BFS_Solver(const Maze& maze)
     : Solver(maze, 'B')
@@ -29,6 +30,7 @@ void BFS_Solver::step() {
         }
         if (grid[tracePos.first][tracePos.second] != 'E') {
             grid[tracePos.first][tracePos.second] = 'X';
+            logEvent(EventLog::Type::Path, tracePos.first, tracePos.second);
         }
         tracePos = parent[tracePos.first][tracePos.second];
         return;
@@ -37,12 +39,15 @@ void BFS_Solver::step() {
     if (currentState != State::SEARCHING) return;
 
     // No more nodes to explore means path not found
+    // (unless some, if not all, of the goals wanted were reached)
     if (q.empty()) {
-        currentState = State::DONE;
-        found = false;
+        if (!anyGoalReached()) {
+            currentState = State::DONE;
+            found = false;
+        }
         
         // Stop the clock if the search fails
-        m_timeTaken = m_clock.getElapsedTime();
+        m_timeTaken = m_resumedTime + m_clock.getElapsedTime();
         
         return;
     }
@@ -57,15 +62,12 @@ void BFS_Solver::step() {
     if (grid[r][c] == ' ') {
         grid[r][c] = symbol;
     }
-    // If we popped the goal, switch to tracing
+    logEvent(EventLog::Type::Expanded, r, c);
+    // If we popped the goal (the nearest, with several), switch to tracing
     // (More efficient to check when adding, but this is fine)
-    if (r == goal.first && c == goal.second) {
-         found = true;
-         currentState = State::TRACING_PATH;
-         tracePos = goal;
-        
+    if (isGoal(r, c) && goalReached(r, c)) {
          // Stop the clock on success
-         m_timeTaken = m_clock.getElapsedTime();
+         m_timeTaken = m_resumedTime + m_clock.getElapsedTime();
          
          return;
     }
@@ -82,5 +84,31 @@ void BFS_Solver::step() {
 
         // We only push to queue here. We *don't* color.
         q.push({nr, nc});
+        logEvent(EventLog::Type::Enqueued, nr, nc);
     }
+}
+
+bool BFS_Solver::saveState(CheckpointWriter& w) const {
+    if (m_severalGoals) return false;
+    saveBaseState(w, m_clock);
+    w.cells(underlying(q));
+    w.bits(visited);
+    return w.ok();
+}
+
+bool BFS_Solver::loadState(CheckpointReader& r) {
+    if (!loadBaseState(r)) return false;
+
+    std::vector<std::pair<int,int>> cells;
+    r.cells(cells);
+    r.bits(visited);
+    underlying(q).assign(cells.begin(), cells.end());
+
+    // The search clock continues from the saved time
+    m_clock.restart();
+    return r.ok();
+}
+
+std::size_t BFS_Solver::getMemoryBytes() const {
+    return Solver::getMemoryBytes() + q.size() * sizeof(std::pair<int,int>) + bitMatrixBytes(visited);
 }
\ No newline at end of file
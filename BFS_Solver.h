@@ -14,6 +14,14 @@ public:
 
     void step() override;
 
+    // Performance HUD readings (see Solver.h)
+    std::size_t getOpenSetSize() const override { return q.size(); }
+    std::size_t getMemoryBytes() const override;
+
+    // Checkpointing (see Checkpoint.h)
+    bool saveState(CheckpointWriter& w) const override;
+    bool loadState(CheckpointReader& r) override;
+
 private:
     std::queue<std::pair<int,int>> q;
     std::vector<std::vector<bool>> visited;
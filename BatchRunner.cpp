@@ -0,0 +1,279 @@
+#include "BatchRunner.h"
+#include "WorkStealing.h"
+#include "SearchWorkspace.h"
+#include "Maze.h"
+#include "Trace.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <cstdlib>
+
+using namespace std;
+
+namespace {
+
+const SearchWorkspace::Algorithm ALGORITHMS[] = {
+    SearchWorkspace::Algorithm::BFS, SearchWorkspace::Algorithm::DFS, SearchWorkspace::Algorithm::AStar,
+    SearchWorkspace::Algorithm::Dijkstra, SearchWorkspace::Algorithm::Greedy};
+const char* const NAMES[] = {"BFS", "DFS", "A*", "Dijkstra", "Greedy"};
+constexpr int ALGORITHM_COUNT = 5;
+
+// One algorithm on one (size, density) configuration
+struct Samples {
+    vector<int> nodes;
+    vector<int> gaps;     // Path length minus BFS path length, solvable mazes only
+    vector<float> micros; // Time per solve
+    long long found = 0;
+};
+
+// Everything one worker collects; merged after the run
+struct WorkerState {
+    SearchWorkspace workspace;
+    vector<Samples> samples; // [config * ALGORITHM_COUNT + algorithm]
+    string csv;              // Rows not yet written
+};
+
+template <typename T>
+double percentile(vector<T>& values, double p) {
+    if (values.empty()) return 0;
+    size_t i = min(values.size() - 1, (size_t)(p * (values.size() - 1) + 0.5));
+    nth_element(values.begin(), values.begin() + i, values.end());
+    return values[i];
+}
+
+} // namespace
+
+double BatchRunner::run(unsigned threads, bool quiet) {
+    const Options& o = m_options;
+    size_t seeds = o.lastSeed >= o.firstSeed ? o.lastSeed - o.firstSeed + 1 : 0;
+    size_t configs = o.sizes.size() * o.densities.size();
+    size_t jobs = configs * seeds;
+
+    WorkStealingScheduler scheduler(threads);
+    vector<unique_ptr<WorkerState>> workers;
+    for (unsigned w = 0; w < scheduler.size(); ++w) {
+        workers.push_back(make_unique<WorkerState>());
+        workers.back()->samples.resize(configs * ALGORITHM_COUNT);
+    }
+
+    ofstream csv;
+    mutex csvLock;
+    if (!o.csvPath.empty() && !quiet) {
+        csv.open(o.csvPath);
+        csv << "rows,cols,density,seed,algorithm,found,path_length,gap,nodes_explored,micros\n";
+    }
+    auto flushCsv = [&](string& rows) {
+        if (!csv.is_open() || rows.empty()) return;
+        lock_guard<mutex> guard(csvLock);
+        csv << rows;
+        rows.clear();
+    };
+
+    auto start = chrono::steady_clock::now();
+    auto lastReport = start;
+    size_t reportedDone = 0;
+    atomic<size_t> done{0};
+
+    // Jobs in seed-major order, so neighbouring jobs are different configurations
+    // and every worker's first block mixes sizes
+    scheduler.run(jobs, [&](unsigned worker, size_t job) {
+        WorkerState& state = *workers[worker];
+        size_t config = job % configs;
+        unsigned seed = o.firstSeed + (unsigned)(job / configs);
+        pair<int, int> size = o.sizes[config / o.densities.size()];
+        int density = o.densities[config % o.densities.size()];
+
+        Maze maze(size.first, size.second, seed, density);
+        {
+            TRACE_SCOPE("SearchWorkspace::bind");
+            state.workspace.bind(maze);
+        }
+
+        int bfsLength = 0;
+        for (int a = 0; a < ALGORITHM_COUNT; ++a) {
+            auto t0 = chrono::steady_clock::now();
+            SearchWorkspace::Result r = state.workspace.solve(ALGORITHMS[a], maze.getStart(), maze.getGoal());
+            float micros = chrono::duration<float, micro>(chrono::steady_clock::now() - t0).count();
+            if (a == 0) bfsLength = r.pathLength;
+
+            Samples& s = state.samples[config * ALGORITHM_COUNT + a];
+            s.nodes.push_back(r.nodesExplored);
+            s.micros.push_back(micros);
+            if (r.found) {
+                s.found++;
+                s.gaps.push_back(r.pathLength - bfsLength);
+            }
+            if (csv.is_open()) {
+                state.csv += to_string(maze.getRows()) + ',' + to_string(maze.getCols()) + ',' + to_string(density) +
+                             ',' + to_string(seed) + ',' + NAMES[a] + ',' + (r.found ? "1," : "0,") +
+                             to_string(r.pathLength) + ',' + (r.found ? to_string(r.pathLength - bfsLength) : "") +
+                             ',' + to_string(r.nodesExplored) + ',' + to_string(micros) + '\n';
+            }
+        }
+        if (state.csv.size() > (64u << 10)) flushCsv(state.csv);
+        done.fetch_add(1, memory_order_relaxed);
+
+        // Worker 0 is the calling thread; it reports progress about once a second
+        if (worker == 0 && !quiet) {
+            auto now = chrono::steady_clock::now();
+            if (now - lastReport >= chrono::seconds(1)) {
+                size_t d = done.load(memory_order_relaxed);
+                double rate = (d - reportedDone) / chrono::duration<double>(now - lastReport).count();
+                cerr << "  " << d << " / " << jobs << " mazes, " << fixed << setprecision(0) << rate << " mazes/s\n";
+                lastReport = now;
+                reportedDone = d;
+            }
+        }
+    });
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    double rate = jobs / max(seconds, 1e-9);
+    for (auto& w : workers) flushCsv(w->csv);
+    if (quiet) return rate;
+
+    cout << jobs << " mazes (" << seeds << " seeds x " << configs << " configurations) on " << scheduler.size()
+         << " threads in " << fixed << setprecision(2) << seconds << " s: " << setprecision(0) << rate << " mazes/s\n";
+
+    // Merge the workers' samples per configuration and algorithm
+    for (size_t config = 0; config < configs; ++config) {
+        pair<int, int> size = o.sizes[config / o.densities.size()];
+        int density = o.densities[config % o.densities.size()];
+        cout << "\n" << size.first << " x " << size.second << ", " << density << "% walls\n"
+             << left << setw(10) << "Algorithm" << right << setw(8) << "Found" << setw(24) << "Nodes p10/p50/p90"
+             << setw(10) << "Optimal" << setw(10) << "Mean gap" << setw(10) << "Max gap" << setw(18)
+             << "us p50/p90" << "\n";
+
+        for (int a = 0; a < ALGORITHM_COUNT; ++a) {
+            Samples all;
+            for (auto& w : workers) {
+                Samples& s = w->samples[config * ALGORITHM_COUNT + a];
+                all.nodes.insert(all.nodes.end(), s.nodes.begin(), s.nodes.end());
+                all.gaps.insert(all.gaps.end(), s.gaps.begin(), s.gaps.end());
+                all.micros.insert(all.micros.end(), s.micros.begin(), s.micros.end());
+                all.found += s.found;
+            }
+            size_t optimal = count(all.gaps.begin(), all.gaps.end(), 0);
+            double meanGap = 0;
+            for (int g : all.gaps) meanGap += g;
+            meanGap /= max<size_t>(all.gaps.size(), 1);
+            int maxGap = all.gaps.empty() ? 0 : *max_element(all.gaps.begin(), all.gaps.end());
+
+            ostringstream nodes, micros;
+            nodes << (long)percentile(all.nodes, 0.1) << '/' << (long)percentile(all.nodes, 0.5) << '/'
+                  << (long)percentile(all.nodes, 0.9);
+            micros << fixed << setprecision(1) << percentile(all.micros, 0.5) << '/' << percentile(all.micros, 0.9);
+            cout << left << setw(10) << NAMES[a] << right << setw(7) << setprecision(1)
+                 << 100.0 * all.found / max<size_t>(seeds, 1) << "%" << setw(24) << nodes.str() << setw(9)
+                 << 100.0 * optimal / max<size_t>(all.gaps.size(), 1) << "%" << setw(10) << setprecision(2)
+                 << meanGap << setw(10) << maxGap << setw(18) << micros.str() << "\n";
+        }
+    }
+
+    cout << "\nWorker  jobs  steals  stolen jobs\n";
+    const vector<WorkStealingScheduler::WorkerStats>& stats = scheduler.getStats();
+    for (size_t w = 0; w < stats.size(); ++w) {
+        cout << setw(6) << w << setw(6) << stats[w].executed << setw(8) << stats[w].steals << setw(13)
+             << stats[w].stolenJobs << "\n";
+    }
+    if (csv.is_open()) cout << "Per-maze rows written to " << o.csvPath << "\n";
+    return rate;
+}
+
+// ---- Command line ----
+
+// Whole-string non-negative integer, or -1 if 's' is anything else
+static int parseCount(const string& s) {
+    if (s.empty() || s.size() > 9 || s.find_first_not_of("0123456789") != string::npos) return -1;
+    return atoi(s.c_str());
+}
+
+template <typename T>
+static vector<T> parseList(const string& text, T (*parse)(const string&)) {
+    vector<T> values;
+    stringstream in(text);
+    string item;
+    while (getline(in, item, ',')) if (!item.empty()) values.push_back(parse(item));
+    return values;
+}
+
+int BatchRunner::main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 2; i < argc; ++i) {
+        string flag = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (flag == "--scaling") {
+            options.scaling = true;
+        } else if (flag == "--seeds" && hasValue) {
+            string range = argv[++i];
+            size_t dash = range.find('-');
+            int first = parseCount(range.substr(0, dash));
+            int last = dash == string::npos ? first : parseCount(range.substr(dash + 1));
+            // Seed 0 would make Maze pick a random one
+            if (first < 1 || last < first) {
+                cerr << "--seeds takes a or a-b with 1 <= a <= b, e.g. 1-1000\n";
+                return 1;
+            }
+            options.firstSeed = (unsigned)first;
+            options.lastSeed = (unsigned)last;
+        } else if (flag == "--sizes" && hasValue) {
+            options.sizes = parseList<pair<int, int>>(argv[++i], [](const string& s) {
+                size_t x = s.find('x');
+                int rows = parseCount(s.substr(0, x));
+                return make_pair(rows, x == string::npos ? rows : parseCount(s.substr(x + 1)));
+            });
+            for (pair<int, int> size : options.sizes) {
+                if (min(size.first, size.second) < 5) {
+                    cerr << "--sizes takes RxC or N entries of at least 5, e.g. 101x101,201\n";
+                    return 1;
+                }
+            }
+        } else if (flag == "--densities" && hasValue) {
+            options.densities = parseList<int>(argv[++i], parseCount);
+            for (int density : options.densities) {
+                if (density < 0 || density > 100) {
+                    cerr << "--densities takes wall percentages from 0 to 100\n";
+                    return 1;
+                }
+            }
+        } else if (flag == "--threads" && hasValue) {
+            options.threads = (unsigned)max(0, atoi(argv[++i]));
+        } else if (flag == "--csv" && hasValue) {
+            options.csvPath = argv[++i];
+        } else {
+            cerr << "Unknown batch option '" << flag << "'\n";
+            return 1;
+        }
+    }
+    if (options.sizes.empty() || options.densities.empty() || options.lastSeed < options.firstSeed) {
+        cerr << "Empty sweep\n";
+        return 1;
+    }
+
+    BatchRunner runner(options);
+    if (!options.scaling) {
+        runner.run(options.threads, false);
+        return 0;
+    }
+
+    // Same sweep on 1, 2, 4, ... threads up to the core count
+    unsigned maxThreads = options.threads ? options.threads : max(1u, thread::hardware_concurrency());
+    vector<unsigned> counts;
+    for (unsigned t = 1; t < maxThreads; t *= 2) counts.push_back(t);
+    counts.push_back(maxThreads);
+
+    cout << "Threads   Mazes/s   Speed-up   Efficiency\n";
+    double base = 0;
+    for (unsigned t : counts) {
+        double rate = runner.run(t, true);
+        if (t == 1) base = rate;
+        cout << setw(7) << t << setw(10) << fixed << setprecision(0) << rate << setw(10) << setprecision(2)
+             << rate / base << "x" << setw(12) << setprecision(0) << 100.0 * rate / base / t << "%\n";
+    }
+    return 0;
+}
@@ -0,0 +1,41 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <vector>
+#include <string>
+#include <utility>
+
+// Throughput mode: generates and solves every (size, density, seed) maze of
+// a sweep on all cores, with a WorkStealingScheduler. Each worker keeps its
+// own SearchWorkspace, statistics and CSV buffer, so workers share nothing
+// but the job blocks.
+//
+// For each algorithm the report gives the distribution of nodes explored,
+// the path-length gap against BFS (the optimum) and the time per solve.
+// Per-maze rows can be streamed to a CSV file while the batch runs.
+class BatchRunner {
+public:
+    struct Options {
+        unsigned firstSeed = 1, lastSeed = 1000;
+        std::vector<std::pair<int, int>> sizes = {{101, 101}};
+        std::vector<int> densities = {25};
+        unsigned threads = 0;     // 0 = one per hardware core
+        std::string csvPath;      // Per-maze rows
+        bool scaling = false;     // Rerun with 1, 2, 4, ... threads and report mazes/s
+    };
+
+    explicit BatchRunner(const Options& options) : m_options(options) {}
+
+    // Runs the sweep with 'threads' workers; prints the report unless quiet.
+    // Returns mazes per second.
+    double run(unsigned threads, bool quiet);
+
+    // "batch" command line: [--seeds a-b] [--sizes RxC,..] [--densities d,..]
+    // [--threads n] [--csv file] [--scaling]
+    static int main(int argc, char* argv[]);
+
+private:
+    Options m_options;
+};
+
+#endif // BATCH_RUNNER_H
@@ -0,0 +1,431 @@
+#include "Benchmark.h"
+#include "Maze.h"
+#include "Utils.h"
+#include "BFS_Solver.h"
+#include "DFS_Solver.h"
+#include "AStar_Solver.h"
+#include "Dijkstra_Solver.h"
+#include "GreedyBestFirst_Solver.h"
+#include "ParallelBFS_Solver.h"
+#include "HDAStar_Solver.h"
+#include "Headless.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <queue>
+#include <stack>
+#include <random>
+
+#ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+
+// ---- Hardware counters ----
+
+// Cycles, instructions, branch and cache misses for the calling thread.
+// Opening fails quietly (e.g. perf_event_paranoid or containers), in which
+// case the counters read as unavailable.
+class PerfCounters {
+public:
+    static constexpr int COUNT = 4;
+
+    PerfCounters() {
+#ifdef __linux__
+        const uint64_t configs[COUNT] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                         PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES};
+        for (int i = 0; i < COUNT; ++i) {
+            perf_event_attr attr{};
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = configs[i];
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            m_fd[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int fd : m_fd) if (fd >= 0) close(fd);
+#endif
+    }
+
+    bool available() const { return m_fd[0] >= 0; }
+
+    void start() {
+#ifdef __linux__
+        for (int fd : m_fd) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // Counter values since start(); -1 for counters that couldn't be opened
+    void stop(double values[COUNT]) {
+        for (int i = 0; i < COUNT; ++i) {
+            values[i] = -1;
+#ifdef __linux__
+            if (m_fd[i] < 0) continue;
+            ioctl(m_fd[i], PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t count = 0;
+            if (read(m_fd[i], &count, sizeof(count)) == (ssize_t)sizeof(count)) values[i] = (double)count;
+#endif
+        }
+    }
+
+private:
+    int m_fd[COUNT] = {-1, -1, -1, -1};
+};
+
+// ---- Cases ----
+
+void Benchmark::add(const string& name, function<uint64_t()> run) {
+    if (!m_options.filter.empty() && name.find(m_options.filter) == string::npos) return;
+    m_cases.push_back({name, move(run)});
+}
+
+void Benchmark::addStandardCases() {
+    for (auto [rows, cols] : m_options.sizes) {
+        for (int density : m_options.densities) {
+            for (unsigned seed : m_options.seeds) {
+                string suffix = "/" + to_string(rows) + "x" + to_string(cols)
+                              + "/d" + to_string(density) + "/s" + to_string(seed);
+                auto maze = make_shared<Maze>(rows, cols, seed, density);
+
+                // Open cells in row order, and a shuffled copy for random access
+                auto cells = make_shared<vector<pair<int, int>>>();
+                for (int r = 0; r < maze->getRows(); ++r)
+                    for (int c = 0; c < maze->getCols(); ++c)
+                        if (maze->grid[r][c] != '#') cells->push_back({r, c});
+                auto shuffled = make_shared<vector<pair<int, int>>>(*cells);
+                shuffle(shuffled->begin(), shuffled->end(), mt19937(seed));
+
+                add("maze/generate" + suffix, [=]() {
+                    Maze m(rows, cols, seed, density);
+                    return (uint64_t)m.getStart().first;
+                });
+
+                // The solvers' inner loop: bounds check and wall test per neighbour
+                add("kernel/expand-isInside" + suffix, [=]() {
+                    const vector<string>& grid = maze->grid;
+                    uint64_t open = 0;
+                    for (auto [r, c] : *cells) {
+                        for (auto [dr, dc] : directions) {
+                            int nr = r + dr, nc = c + dc;
+                            if (!isInside(grid, nr, nc)) continue;
+                            if (grid[nr][nc] != '#') ++open;
+                        }
+                    }
+                    return open;
+                });
+
+                // A*'s open set: push every open cell keyed by Manhattan distance, pop all
+                add("kernel/pq-nodedata" + suffix, [=]() {
+                    struct NodeData {
+                        int f; pair<int, int> pos;
+                        bool operator>(const NodeData& other) const { return f > other.f; }
+                    };
+                    priority_queue<NodeData, vector<NodeData>, greater<NodeData>> pq;
+                    pair<int, int> goal = maze->getGoal();
+                    for (auto [r, c] : *shuffled) {
+                        pq.push({abs(goal.first - r) + abs(goal.second - c), {r, c}});
+                    }
+                    uint64_t sum = 0;
+                    while (!pq.empty()) {
+                        sum += (uint64_t)pq.top().pos.first;
+                        pq.pop();
+                    }
+                    return sum;
+                });
+
+                // BFS / DFS containers with a frontier of about a thousand cells
+                add("kernel/queue-pairs" + suffix, [=]() {
+                    queue<pair<int, int>> q;
+                    uint64_t sum = 0;
+                    for (const auto& cell : *cells) {
+                        q.push(cell);
+                        if (q.size() > 1024) { sum += (uint64_t)q.front().second; q.pop(); }
+                    }
+                    while (!q.empty()) { sum += (uint64_t)q.front().second; q.pop(); }
+                    return sum;
+                });
+                add("kernel/stack-pairs" + suffix, [=]() {
+                    stack<pair<int, int>> s;
+                    uint64_t sum = 0;
+                    for (const auto& cell : *cells) {
+                        s.push(cell);
+                        if (s.size() > 1024) { sum += (uint64_t)s.top().second; s.pop(); }
+                    }
+                    while (!s.empty()) { sum += (uint64_t)s.top().second; s.pop(); }
+                    return sum;
+                });
+
+                // Test-and-set on the solvers' visited matrix in random order
+                add("kernel/visited-vector-bool" + suffix, [=]() {
+                    vector<vector<bool>> visited(maze->getRows(), vector<bool>(maze->getCols(), false));
+                    uint64_t fresh = 0;
+                    for (auto [r, c] : *shuffled) {
+                        if (!visited[r][c]) { visited[r][c] = true; ++fresh; }
+                    }
+                    return fresh;
+                });
+
+                // Full solvers: construction plus every step, including the path trace
+                auto solverCase = [&](const string& name, function<unique_ptr<Solver>()> make) {
+                    add("solver/" + name + suffix, [=]() {
+                        unique_ptr<Solver> solver = make();
+                        runToCompletion(*solver);
+                        return (uint64_t)solver->getNodesExplored();
+                    });
+                };
+                solverCase("BFS",         [=]() { return make_unique<BFS_Solver>(*maze); });
+                solverCase("DFS",         [=]() { return make_unique<DFS_Solver>(*maze); });
+                solverCase("A*",          [=]() { return make_unique<AStar_Solver>(*maze); });
+                solverCase("Dijkstra",    [=]() { return make_unique<Dijkstra_Solver>(*maze); });
+                solverCase("Greedy",      [=]() { return make_unique<GreedyBestFirst_Solver>(*maze); });
+                solverCase("ParallelBFS", [=]() { return make_unique<ParallelBFS_Solver>(*maze); });
+                solverCase("HDA*",        [=]() { return make_unique<HDAStar_Solver>(*maze); });
+            }
+        }
+    }
+}
+
+// ---- Measurement ----
+
+// Every case's return value is added here so the work can't be optimised away
+static volatile uint64_t g_sink = 0;
+
+// Nearest-rank percentile of sorted samples
+static double percentile(const vector<double>& sorted, double p) {
+    size_t rank = (size_t)ceil(p / 100.0 * sorted.size());
+    return sorted[min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+Benchmark::Result Benchmark::measure(const Case& c) {
+    for (int i = 0; i < m_options.warmup; ++i) g_sink += c.run();
+
+    unique_ptr<PerfCounters> counters;
+    if (m_options.counters) {
+        counters = make_unique<PerfCounters>();
+        counters->start();
+    }
+
+    vector<double> samples;
+    samples.reserve(m_options.reps);
+    for (int i = 0; i < m_options.reps; ++i) {
+        auto t0 = chrono::steady_clock::now();
+        g_sink += c.run();
+        auto t1 = chrono::steady_clock::now();
+        samples.push_back((double)chrono::duration_cast<chrono::nanoseconds>(t1 - t0).count());
+    }
+
+    Result result;
+    result.name = c.name;
+    result.reps = m_options.reps;
+    if (counters) {
+        double values[PerfCounters::COUNT];
+        counters->stop(values);
+        double* fields[PerfCounters::COUNT] = {&result.cycles, &result.instructions,
+                                               &result.branchMisses, &result.cacheMisses};
+        for (int i = 0; i < PerfCounters::COUNT; ++i) {
+            *fields[i] = values[i] < 0 ? -1 : values[i] / m_options.reps;
+        }
+    }
+
+    sort(samples.begin(), samples.end());
+    result.minNs = samples.front();
+    result.p10Ns = percentile(samples, 10);
+    result.medianNs = percentile(samples, 50);
+    result.p90Ns = percentile(samples, 90);
+    result.p99Ns = percentile(samples, 99);
+    return result;
+}
+
+// Nanoseconds as a short human-readable duration
+static string formatTime(double ns) {
+    ostringstream out;
+    out << fixed << setprecision(ns < 10e3 ? 0 : 1);
+    if (ns < 10e3)      out << ns << " ns";
+    else if (ns < 10e6) out << ns / 1e3 << " us";
+    else                out << ns / 1e6 << " ms";
+    return out.str();
+}
+
+int Benchmark::run() {
+    if (m_cases.empty()) {
+        cerr << "No benchmark matches '" << m_options.filter << "'\n";
+        return 0;
+    }
+    m_options.reps = max(1, m_options.reps);
+    if (m_options.counters && !PerfCounters().available()) {
+        cout << "Hardware counters unavailable (perf_event_open failed), timing only\n";
+        m_options.counters = false;
+    }
+
+    size_t nameWidth = 0;
+    for (const Case& c : m_cases) nameWidth = max(nameWidth, c.name.size());
+
+    cout << m_cases.size() << " cases, " << m_options.reps << " repetitions each\n"
+         << left << setw((int)nameWidth + 2) << "Case" << right
+         << setw(11) << "min" << setw(11) << "p10" << setw(11) << "median"
+         << setw(11) << "p90" << setw(11) << "p99";
+    if (m_options.counters) cout << setw(8) << "IPC" << setw(14) << "br-miss/rep" << setw(14) << "$-miss/rep";
+    cout << "\n";
+
+    vector<Result> results;
+    for (const Case& c : m_cases) {
+        Result r = measure(c);
+        cout << left << setw((int)nameWidth + 2) << r.name << right
+             << setw(11) << formatTime(r.minNs) << setw(11) << formatTime(r.p10Ns)
+             << setw(11) << formatTime(r.medianNs) << setw(11) << formatTime(r.p90Ns)
+             << setw(11) << formatTime(r.p99Ns);
+        if (m_options.counters) {
+            cout << fixed << setprecision(2) << setw(8)
+                 << (r.cycles > 0 && r.instructions >= 0 ? r.instructions / r.cycles : 0.0)
+                 << setprecision(0) << setw(14) << r.branchMisses << setw(14) << r.cacheMisses;
+        }
+        cout << "\n" << flush;
+        results.push_back(r);
+    }
+
+    if (!m_options.jsonPath.empty()) {
+        if (writeJson(results)) cout << "Results written to " << m_options.jsonPath << "\n";
+        else cerr << "Could not write '" << m_options.jsonPath << "'\n";
+    }
+    int regressions = m_options.baselinePath.empty() ? 0 : compareBaseline(results);
+
+    return regressions;
+}
+
+// ---- JSON baseline ----
+
+// One object per line, so the baseline can be read back without a JSON library
+bool Benchmark::writeJson(const vector<Result>& results) const {
+    ofstream out(m_options.jsonPath);
+    if (!out) return false;
+    out << "{\n  \"reps\": " << m_options.reps << ",\n  \"benchmarks\": [\n";
+    out << fixed << setprecision(0);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"min_ns\": " << r.minNs
+            << ", \"p10_ns\": " << r.p10Ns << ", \"median_ns\": " << r.medianNs
+            << ", \"p90_ns\": " << r.p90Ns << ", \"p99_ns\": " << r.p99Ns;
+        if (r.cycles >= 0) out << ", \"cycles\": " << r.cycles;
+        if (r.instructions >= 0) out << ", \"instructions\": " << r.instructions;
+        out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return (bool)out;
+}
+
+int Benchmark::compareBaseline(const vector<Result>& results) const {
+    ifstream in(m_options.baselinePath);
+    if (!in) {
+        cerr << "Could not read baseline '" << m_options.baselinePath << "'\n";
+        return 0;
+    }
+
+    // name -> median from lines written by writeJson()
+    map<string, double> baseline;
+    string line;
+    while (getline(in, line)) {
+        size_t name = line.find("\"name\": \"");
+        size_t median = line.find("\"median_ns\": ");
+        if (name == string::npos || median == string::npos) continue;
+        name += 9;
+        size_t nameEnd = line.find('"', name);
+        if (nameEnd == string::npos) continue;
+        baseline[line.substr(name, nameEnd - name)] = atof(line.c_str() + median + 13);
+    }
+
+    cout << "\nAgainst " << m_options.baselinePath << " (regression threshold "
+         << fixed << setprecision(1) << m_options.threshold << "%):\n";
+    int regressions = 0, improvements = 0, unmatched = 0;
+    for (const Result& r : results) {
+        auto it = baseline.find(r.name);
+        if (it == baseline.end() || it->second <= 0) {
+            ++unmatched;
+            continue;
+        }
+        double change = (r.medianNs - it->second) / it->second * 100.0;
+        if (change > m_options.threshold) ++regressions;
+        else if (change < -m_options.threshold) ++improvements;
+        else continue;
+
+        cout << "  " << (change > 0 ? "SLOWER " : "faster ") << r.name << ": "
+             << formatTime(it->second) << " -> " << formatTime(r.medianNs)
+             << " (" << showpos << setprecision(1) << change << noshowpos << "%)\n";
+    }
+    cout << "  " << regressions << " regressions, " << improvements << " improvements, "
+         << results.size() - regressions - improvements - unmatched << " unchanged";
+    if (unmatched > 0) cout << ", " << unmatched << " not in baseline";
+    cout << "\n";
+    return regressions;
+}
+
+// ---- Command line ----
+
+template <typename T>
+static vector<T> parseList(const string& text, T (*parse)(const string&)) {
+    vector<T> values;
+    stringstream in(text);
+    string item;
+    while (getline(in, item, ',')) if (!item.empty()) values.push_back(parse(item));
+    return values;
+}
+
+int Benchmark::main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 2; i < argc; ++i) {
+        string flag = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (flag == "--counters") {
+            options.counters = true;
+        } else if (flag == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (flag == "--reps" && hasValue) {
+            options.reps = atoi(argv[++i]);
+        } else if (flag == "--warmup" && hasValue) {
+            options.warmup = max(0, atoi(argv[++i]));
+        } else if (flag == "--sizes" && hasValue) {
+            options.sizes = parseList<pair<int, int>>(argv[++i], [](const string& s) {
+                size_t x = s.find('x');
+                int rows = atoi(s.c_str());
+                return make_pair(rows, x == string::npos ? rows : atoi(s.c_str() + x + 1));
+            });
+        } else if (flag == "--densities" && hasValue) {
+            options.densities = parseList<int>(argv[++i], [](const string& s) { return atoi(s.c_str()); });
+        } else if (flag == "--seeds" && hasValue) {
+            options.seeds = parseList<unsigned>(argv[++i], [](const string& s) { return (unsigned)atoi(s.c_str()); });
+        } else if (flag == "--json" && hasValue) {
+            options.jsonPath = argv[++i];
+        } else if (flag == "--baseline" && hasValue) {
+            options.baselinePath = argv[++i];
+        } else if (flag == "--threshold" && hasValue) {
+            options.threshold = atof(argv[++i]);
+        } else {
+            cerr << "Unknown bench option '" << flag << "'\n";
+            return 1;
+        }
+    }
+
+    Benchmark bench(options);
+    bench.addStandardCases();
+    return bench.run() > 0 ? 2 : 0;
+}
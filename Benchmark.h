@@ -0,0 +1,72 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <cstdint>
+
+// Microbenchmarks for the search kernels (neighbour expansion, the open-set
+// containers, visited access, maze generation) and for every full solver,
+// parameterised over maze size, wall density and seed.
+//
+// Each case is timed for a number of repetitions after a warm-up; the report
+// gives the median and percentiles. Results can be written as JSON and
+// compared against a saved baseline, so a slowdown in any solver shows up as
+// a percentage.
+class Benchmark {
+public:
+    struct Options {
+        std::string filter;          // Only cases whose name contains this
+        int reps = 15;
+        int warmup = 2;
+        std::vector<std::pair<int, int>> sizes = {{101, 201}, {401, 801}};
+        std::vector<int> densities = {25, 35};
+        std::vector<unsigned> seeds = {1};
+        bool counters = false;       // Hardware counters via perf_event (Linux)
+        std::string jsonPath;        // Write results here
+        std::string baselinePath;    // Compare against these results
+        double threshold = 10.0;     // Percent slower than baseline that counts as a regression
+    };
+
+    struct Result {
+        std::string name;
+        int reps = 0;
+        double minNs = 0, p10Ns = 0, medianNs = 0, p90Ns = 0, p99Ns = 0;
+        // Per repetition, only with Options::counters; -1 if not available
+        double cycles = -1, instructions = -1, branchMisses = -1, cacheMisses = -1;
+    };
+
+    explicit Benchmark(const Options& options) : m_options(options) {}
+
+    // Registers a case. 'run' is one timed repetition; its return value is
+    // accumulated so the compiler can't drop the work.
+    void add(const std::string& name, std::function<std::uint64_t()> run);
+
+    // Adds the kernel and solver cases for every size/density/seed
+    void addStandardCases();
+
+    // Runs all matching cases and prints the table (and baseline diff);
+    // returns the number of regressions against the baseline
+    int run();
+
+    // "bench" command line: [--filter s] [--reps n] [--sizes RxC,..]
+    // [--densities d,..] [--seeds s,..] [--counters] [--json file]
+    // [--baseline file] [--threshold pct]
+    static int main(int argc, char* argv[]);
+
+private:
+    struct Case {
+        std::string name;
+        std::function<std::uint64_t()> run;
+    };
+
+    Result measure(const Case& c);
+    bool writeJson(const std::vector<Result>& results) const;
+    int compareBaseline(const std::vector<Result>& results) const;
+
+    Options m_options;
+    std::vector<Case> m_cases;
+};
+
+#endif // BENCHMARK_H
@@ -0,0 +1,230 @@
+#ifndef CELLSTORE_H
+#define CELLSTORE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+// How a CellStore keeps its values
+enum class CellStorage {
+    Auto,  // Pick from grid size and expected search extent (chooseCellStorage)
+    Dense, // One flat array of R x C values, filled up front
+    Paged, // Two-level: 4096-cell pages allocated on first write
+    Hash   // Open-addressing hash map of written cells only
+};
+
+// Dense when the search is expected to touch a good share of the grid, a
+// small hash map when it touches few cells, pages in between
+inline CellStorage chooseCellStorage(std::size_t cells, std::size_t expectedTouched) {
+    if (expectedTouched * 4 >= cells) return CellStorage::Dense;
+    if (expectedTouched <= (std::size_t)1 << 16) return CellStorage::Hash;
+    return CellStorage::Paged;
+}
+
+// Per-cell search bookkeeping (visited, parent, g-score) whose memory and
+// setup cost follow the cells actually written rather than the maze area.
+// Cells never written read as the 'empty' value.
+//
+// Indexing works like the vector<vector<T>> it replaces: store[r][c] reads
+// the value and store[r][c] = v writes it. Reads never allocate.
+// A Hash store that grows past the size of the dense array switches to Dense,
+// so a bad estimate costs at most about one dense allocation.
+//
+// Only the Dense backend may be written from several threads (to different
+// cells); the parallel solvers always use it.
+template <typename T>
+class CellStore {
+public:
+    static constexpr int PAGE_BITS = 12;
+
+    CellStore() = default;
+
+    void reset(int rows, int cols, T empty, CellStorage storage) {
+        m_rows = rows;
+        m_cols = cols;
+        m_empty = empty;
+        m_storage = storage == CellStorage::Auto ? CellStorage::Dense : storage;
+        m_dense.clear();
+        m_pages.clear();
+        m_slots.clear();
+        m_touched = 0;
+        m_promoted = false;
+
+        std::size_t cells = (std::size_t)rows * cols;
+        if (m_storage == CellStorage::Dense) {
+            m_dense.assign(cells, Value{empty});
+        } else if (m_storage == CellStorage::Paged) {
+            m_pages.resize((cells >> PAGE_BITS) + 1);
+        } else {
+            rehash(1024);
+        }
+    }
+
+    T get(int r, int c) const {
+        std::size_t i = (std::size_t)r * m_cols + c;
+        switch (m_storage) {
+            case CellStorage::Dense:
+                return m_dense[i].value;
+            case CellStorage::Paged: {
+                const std::vector<Value>& page = m_pages[i >> PAGE_BITS];
+                return page.empty() ? m_empty : page[i & PAGE_MASK].value;
+            }
+            default: {
+                const Slot& slot = m_slots[find(i)];
+                return slot.key == i ? slot.value : m_empty;
+            }
+        }
+    }
+
+    T& at(int r, int c) {
+        std::size_t i = (std::size_t)r * m_cols + c;
+        switch (m_storage) {
+            case CellStorage::Dense:
+                return m_dense[i].value;
+            case CellStorage::Paged: {
+                std::vector<Value>& page = m_pages[i >> PAGE_BITS];
+                if (page.empty()) {
+                    page.assign(PAGE_SIZE, Value{m_empty});
+                    m_touched += PAGE_SIZE;
+                }
+                return page[i & PAGE_MASK].value;
+            }
+            default: {
+                std::size_t slot = find(i);
+                if (m_slots[slot].key != i) {
+                    // Keep the load factor at or below 1/2
+                    if ((m_touched + 1) * 2 > m_slots.size()) {
+                        // A search that outgrew its estimate: a larger table
+                        // would cost more than the dense array
+                        if (m_slots.size() * 2 * sizeof(Slot) > (std::size_t)m_rows * m_cols * sizeof(T)) {
+                            promoteToDense();
+                            return m_dense[i].value;
+                        }
+                        rehash(m_slots.size() * 2);
+                        slot = find(i);
+                    }
+                    m_slots[slot] = {i, m_empty};
+                    m_touched++;
+                }
+                return m_slots[slot].value;
+            }
+        }
+    }
+
+    // store[r][c] reads, store[r][c] = v writes
+    class Ref {
+    public:
+        Ref(CellStore& store, int r, int c) : m_store(store), m_r(r), m_c(c) {}
+        operator T() const { return m_store.get(m_r, m_c); }
+        Ref& operator=(const T& value) { m_store.at(m_r, m_c) = value; return *this; }
+        Ref& operator=(const Ref& other) { return *this = (T)other; }
+    private:
+        CellStore& m_store;
+        int m_r, m_c;
+    };
+    class Row {
+    public:
+        Row(CellStore& store, int r) : m_store(store), m_r(r) {}
+        Ref operator[](int c) { return Ref(m_store, m_r, c); }
+    private:
+        CellStore& m_store;
+        int m_r;
+    };
+    class ConstRow {
+    public:
+        ConstRow(const CellStore& store, int r) : m_store(store), m_r(r) {}
+        T operator[](int c) const { return m_store.get(m_r, c); }
+    private:
+        const CellStore& m_store;
+        int m_r;
+    };
+    Row operator[](int r) { return Row(*this, r); }
+    ConstRow operator[](int r) const { return ConstRow(*this, r); }
+
+    CellStorage getStorage() const { return m_storage; }
+
+    // True if a Hash store grew past the size of a dense one and switched to Dense
+    bool wasPromoted() const { return m_promoted; }
+
+    // Cells with allocated storage (all cells for Dense, whole pages for Paged)
+    std::size_t getAllocatedCells() const {
+        return m_storage == CellStorage::Dense ? (std::size_t)m_rows * m_cols : m_touched;
+    }
+
+    std::size_t getBytes() const {
+        switch (m_storage) {
+            case CellStorage::Dense: return (std::size_t)m_rows * m_cols * sizeof(T);
+            case CellStorage::Paged: return m_touched * sizeof(T) + m_pages.size() * sizeof(m_pages[0]);
+            default:                 return m_slots.size() * sizeof(Slot);
+        }
+    }
+
+    // Full grid copy, for checkpoints
+    std::vector<std::vector<T>> toMatrix() const {
+        std::vector<std::vector<T>> m(m_rows, std::vector<T>(m_cols, m_empty));
+        for (int r = 0; r < m_rows; ++r)
+            for (int c = 0; c < m_cols; ++c) m[r][c] = get(r, c);
+        return m;
+    }
+
+    // Writes every non-empty value of a full grid, keeping the backend
+    void fromMatrix(const std::vector<std::vector<T>>& m) {
+        reset(m_rows, m_cols, m_empty, m_storage);
+        for (int r = 0; r < m_rows && r < (int)m.size(); ++r)
+            for (int c = 0; c < m_cols && c < (int)m[r].size(); ++c)
+                if (!(m[r][c] == m_empty)) at(r, c) = m[r][c];
+    }
+
+private:
+    static constexpr std::size_t PAGE_SIZE = (std::size_t)1 << PAGE_BITS;
+    static constexpr std::size_t PAGE_MASK = PAGE_SIZE - 1;
+    static constexpr std::uint64_t NO_KEY = UINT64_MAX;
+
+    // Wrapped so that T = bool gets real bool storage, not vector<bool> bits
+    struct Value {
+        T value;
+    };
+
+    struct Slot {
+        std::uint64_t key;
+        T value;
+    };
+
+    // Slot holding cell i, or the free slot where it would go (linear probing)
+    std::size_t find(std::uint64_t i) const {
+        std::size_t mask = m_slots.size() - 1;
+        std::size_t slot = (std::size_t)((i * 0x9E3779B97F4A7C15ull) >> 20) & mask;
+        while (m_slots[slot].key != i && m_slots[slot].key != NO_KEY) slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    void promoteToDense() {
+        std::vector<Slot> slots;
+        slots.swap(m_slots);
+        reset(m_rows, m_cols, m_empty, CellStorage::Dense);
+        for (const Slot& s : slots) {
+            if (s.key != NO_KEY) m_dense[s.key].value = s.value;
+        }
+        m_promoted = true;
+    }
+
+    void rehash(std::size_t capacity) {
+        std::vector<Slot> old(capacity, Slot{NO_KEY, m_empty});
+        old.swap(m_slots);
+        for (const Slot& s : old) {
+            if (s.key != NO_KEY) m_slots[find(s.key)] = s;
+        }
+    }
+
+    int m_rows = 0, m_cols = 0;
+    T m_empty{};
+    CellStorage m_storage = CellStorage::Dense;
+    std::vector<Value> m_dense;
+    std::vector<std::vector<Value>> m_pages; // Empty until first written
+    std::vector<Slot> m_slots;
+    std::size_t m_touched = 0;
+    bool m_promoted = false;
+};
+
+#endif // CELLSTORE_H
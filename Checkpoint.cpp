@@ -0,0 +1,212 @@
+#include "Checkpoint.h"
+#include "Solver.h"
+#include "Maze.h"
+#include "BFS_Solver.h"
+#include "DFS_Solver.h"
+#include "AStar_Solver.h"
+#include "Dijkstra_Solver.h"
+#include "GreedyBestFirst_Solver.h"
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+static const char CHECKPOINT_MAGIC[8] = {'M', 'Z', 'C', 'K', 'P', 'T', '0', '1'};
+
+// ---- CheckpointWriter ----
+
+void CheckpointWriter::raw(const void* data, size_t bytes) {
+    out.write(static_cast<const char*>(data), bytes);
+    offset += bytes;
+}
+
+void CheckpointWriter::align() {
+    static const char zeros[8] = {};
+    raw(zeros, (8 - offset % 8) % 8);
+}
+
+void CheckpointWriter::grid(const vector<string>& g) {
+    pod((uint64_t)g.size());
+    pod((uint64_t)(g.empty() ? 0 : g[0].size()));
+    align();
+    for (const string& row : g) raw(row.data(), row.size());
+}
+
+void CheckpointWriter::bits(const vector<vector<bool>>& m) {
+    uint64_t rows = m.size(), cols = m.empty() ? 0 : m[0].size();
+    vector<uint8_t> packed((rows * cols + 7) / 8, 0);
+    uint64_t i = 0;
+    for (const auto& row : m) {
+        for (bool b : row) {
+            if (b) packed[i / 8] |= uint8_t(1u << (i % 8));
+            ++i;
+        }
+    }
+    pod(rows);
+    pod(cols);
+    array(packed);
+}
+
+void CheckpointWriter::pairs(const vector<vector<pair<int, int>>>& m) {
+    pod((uint64_t)m.size());
+    pod((uint64_t)(m.empty() ? 0 : m[0].size()));
+    align();
+
+    // One row at a time through a flat int buffer
+    vector<int32_t> buf;
+    for (const auto& row : m) {
+        buf.resize(row.size() * 2);
+        for (size_t c = 0; c < row.size(); ++c) {
+            buf[c * 2] = row[c].first;
+            buf[c * 2 + 1] = row[c].second;
+        }
+        raw(buf.data(), buf.size() * sizeof(int32_t));
+    }
+}
+
+// ---- CheckpointReader ----
+
+void CheckpointReader::raw(void* data, size_t bytes) {
+    if (!ok()) return;
+    in.read(static_cast<char*>(data), bytes);
+    offset += bytes;
+}
+
+void CheckpointReader::align() {
+    char skip[8];
+    raw(skip, (8 - offset % 8) % 8);
+}
+
+void CheckpointReader::grid(vector<string>& g) {
+    uint64_t rows = 0, cols = 0;
+    pod(rows);
+    pod(cols);
+    align();
+    if (!ok() || rows * cols > MAX_ELEMENTS) { fail(); return; }
+    g.assign((size_t)rows, string((size_t)cols, ' '));
+    for (string& row : g) raw(&row[0], row.size());
+}
+
+void CheckpointReader::bits(vector<vector<bool>>& m) {
+    uint64_t rows = 0, cols = 0;
+    vector<uint8_t> packed;
+    pod(rows);
+    pod(cols);
+    array(packed);
+    if (!ok() || packed.size() != (rows * cols + 7) / 8) { fail(); return; }
+
+    m.assign((size_t)rows, vector<bool>((size_t)cols));
+    uint64_t i = 0;
+    for (auto& row : m) {
+        for (size_t c = 0; c < row.size(); ++c, ++i) {
+            row[c] = (packed[i / 8] >> (i % 8)) & 1;
+        }
+    }
+}
+
+void CheckpointReader::pairs(vector<vector<pair<int, int>>>& m) {
+    uint64_t rows = 0, cols = 0;
+    pod(rows);
+    pod(cols);
+    align();
+    if (!ok() || rows * cols > MAX_ELEMENTS) { fail(); return; }
+
+    m.assign((size_t)rows, vector<pair<int, int>>((size_t)cols));
+    vector<int32_t> buf((size_t)cols * 2);
+    for (auto& row : m) {
+        raw(buf.data(), buf.size() * sizeof(int32_t));
+        for (size_t c = 0; c < row.size(); ++c) row[c] = {buf[c * 2], buf[c * 2 + 1]};
+    }
+}
+
+void CheckpointReader::cells(vector<pair<int, int>>& list) {
+    vector<int32_t> flat;
+    array(flat);
+    list.resize(flat.size() / 2);
+    for (size_t i = 0; i < list.size(); ++i) list[i] = {flat[i * 2], flat[i * 2 + 1]};
+}
+
+// ---- Checkpoint ----
+
+Checkpoint::Checkpoint(const string& path, sf::Time interval)
+    : m_path(path), m_interval(interval)
+{
+}
+
+bool Checkpoint::update(const Solver& solver) {
+    if (m_sinceLast.getElapsedTime() < m_interval) return false;
+
+    sf::Clock clock;
+    bool saved = save(solver, m_path);
+    m_timeSpent += clock.getElapsedTime();
+    m_sinceLast.restart();
+
+    if (saved) {
+        m_saves++;
+        ifstream f(m_path, ios::binary | ios::ate);
+        m_lastSize = (uint64_t)f.tellg();
+    }
+    return saved;
+}
+
+bool Checkpoint::save(const Solver& solver, const string& path) {
+    string tmp = path + ".tmp";
+    {
+        // Big buffer: snapshots are mostly a few large sequential writes
+        vector<char> buffer(1 << 20);
+        ofstream out;
+        out.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+        out.open(tmp, ios::binary | ios::trunc);
+        if (!out) return false;
+
+        const vector<string> grid = solver.getGrid();
+        CheckpointWriter w(out);
+        out.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+        w.pod((int32_t)solver.getSymbol());
+        w.pod((int32_t)grid.size());
+        w.pod((int32_t)(grid.empty() ? 0 : grid[0].size()));
+
+        if (!solver.saveState(w) || !w.ok()) {
+            out.close();
+            remove(tmp.c_str());
+            return false;
+        }
+    }
+
+    // Replace the previous snapshot only once the new one is complete
+    remove(path.c_str());
+    return rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+unique_ptr<Solver> Checkpoint::load(const string& path) {
+    ifstream in(path, ios::binary);
+    if (!in) return nullptr;
+
+    char magic[8];
+    in.read(magic, sizeof(magic));
+    if (!in || memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0) return nullptr;
+
+    CheckpointReader r(in);
+    int32_t symbol = 0, rows = 0, cols = 0;
+    r.pod(symbol);
+    r.pod(rows);
+    r.pod(cols);
+    if (!r.ok() || rows < 5 || cols < 5) return nullptr;
+
+    // The solver is built on a blank maze of the right size;
+    // loadState() then replaces grid, endpoints and all search state
+    Maze placeholder = Maze::blank(rows, cols);
+    unique_ptr<Solver> solver;
+    switch (symbol) {
+        case 'B': solver = make_unique<BFS_Solver>(placeholder); break;
+        case 'D': solver = make_unique<DFS_Solver>(placeholder); break;
+        case 'A': solver = make_unique<AStar_Solver>(placeholder); break;
+        case 'K': solver = make_unique<Dijkstra_Solver>(placeholder); break;
+        case 'G': solver = make_unique<GreedyBestFirst_Solver>(placeholder); break;
+        default: return nullptr;
+    }
+
+    if (!solver->loadState(r) || !r.ok()) return nullptr;
+    return solver;
+}
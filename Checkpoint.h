@@ -0,0 +1,164 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <istream>
+#include <ostream>
+#include <cstdint>
+#include <type_traits>
+#include <SFML/System/Clock.hpp>
+
+class Solver;
+
+// Binary writer for solver snapshots. Every array starts on an 8-byte
+// boundary and 2D grids are written as one flat row-major block, so the
+// large parts of a snapshot are single bulk writes (and could be mmap'ed).
+class CheckpointWriter {
+public:
+    explicit CheckpointWriter(std::ostream& out) : out(out) {}
+
+    template <typename T>
+    void pod(const T& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "pod() needs a trivially copyable type");
+        raw(&v, sizeof(T));
+    }
+
+    template <typename T>
+    void array(const std::vector<T>& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "array() needs a trivially copyable type");
+        pod((std::uint64_t)v.size());
+        align();
+        raw(v.data(), v.size() * sizeof(T));
+    }
+
+    // Rows of a rectangular matrix, back to back
+    template <typename T>
+    void matrix(const std::vector<std::vector<T>>& m) {
+        pod((std::uint64_t)m.size());
+        pod((std::uint64_t)(m.empty() ? 0 : m[0].size()));
+        align();
+        for (const auto& row : m) raw(row.data(), row.size() * sizeof(T));
+    }
+
+    void grid(const std::vector<std::string>& g);
+    void bits(const std::vector<std::vector<bool>>& m);           // Packed, 1 bit per cell
+    void pairs(const std::vector<std::vector<std::pair<int, int>>>& m);
+
+    // Any container of (r, c) cells, e.g. a queue's deque, in order
+    template <typename Container>
+    void cells(const Container& list) {
+        std::vector<std::int32_t> flat;
+        flat.reserve(list.size() * 2);
+        for (const auto& cell : list) {
+            flat.push_back(cell.first);
+            flat.push_back(cell.second);
+        }
+        array(flat);
+    }
+
+    bool ok() const { return (bool)out; }
+
+private:
+    void raw(const void* data, std::size_t bytes);
+    void align();
+
+    std::ostream& out;
+    std::uint64_t offset = 0;
+};
+
+class CheckpointReader {
+public:
+    explicit CheckpointReader(std::istream& in) : in(in) {}
+
+    template <typename T>
+    void pod(T& v) { raw(&v, sizeof(T)); }
+
+    template <typename T>
+    void array(std::vector<T>& v) {
+        std::uint64_t n = 0;
+        pod(n);
+        align();
+        if (!ok() || n > MAX_ELEMENTS) { fail(); return; }
+        v.resize((std::size_t)n);
+        raw(v.data(), v.size() * sizeof(T));
+    }
+
+    template <typename T>
+    void matrix(std::vector<std::vector<T>>& m) {
+        std::uint64_t rows = 0, cols = 0;
+        pod(rows);
+        pod(cols);
+        align();
+        if (!ok() || rows * cols > MAX_ELEMENTS) { fail(); return; }
+        m.assign((std::size_t)rows, std::vector<T>((std::size_t)cols));
+        for (auto& row : m) raw(row.data(), row.size() * sizeof(T));
+    }
+
+    void grid(std::vector<std::string>& g);
+    void bits(std::vector<std::vector<bool>>& m);
+    void pairs(std::vector<std::vector<std::pair<int, int>>>& m);
+    void cells(std::vector<std::pair<int, int>>& list);
+
+    bool ok() const { return !m_failed && (bool)in; }
+    void fail() { m_failed = true; }
+
+private:
+    static constexpr std::uint64_t MAX_ELEMENTS = std::uint64_t(1) << 40;
+
+    void raw(void* data, std::size_t bytes);
+    void align();
+
+    std::istream& in;
+    std::uint64_t offset = 0;
+    bool m_failed = false;
+};
+
+// The container inside a std::queue / std::stack / std::priority_queue (its
+// protected member 'c'), so open sets are saved and restored in their exact
+// internal order and a resumed search continues identically
+template <typename Adapter>
+typename Adapter::container_type& underlying(Adapter& a) {
+    struct Access : Adapter {
+        static typename Adapter::container_type& get(Adapter& x) { return x.*(&Access::c); }
+    };
+    return Access::get(a);
+}
+
+template <typename Adapter>
+const typename Adapter::container_type& underlying(const Adapter& a) {
+    return underlying(const_cast<Adapter&>(a));
+}
+
+// Periodic snapshots of a running solver, and restoring them.
+// save() writes to "<path>.tmp" and renames it over the old snapshot, so a
+// crash mid-write never destroys the previous checkpoint.
+class Checkpoint {
+public:
+    // interval: minimum time between two snapshots taken by update()
+    Checkpoint(const std::string& path, sf::Time interval);
+
+    // Call after each step(); saves when the interval has passed.
+    // Returns true if a snapshot was written.
+    bool update(const Solver& solver);
+
+    int getSaveCount() const { return m_saves; }
+    sf::Time getTimeSpent() const { return m_timeSpent; }
+    std::uint64_t getLastSize() const { return m_lastSize; }
+
+    // One-off save/restore; load() returns nullptr if the file is missing,
+    // corrupt, or from a solver that can't be checkpointed
+    static bool save(const Solver& solver, const std::string& path);
+    static std::unique_ptr<Solver> load(const std::string& path);
+
+private:
+    std::string m_path;
+    sf::Time m_interval;
+    sf::Clock m_sinceLast;
+    int m_saves = 0;
+    sf::Time m_timeSpent = sf::Time::Zero;
+    std::uint64_t m_lastSize = 0;
+};
+
+#endif // CHECKPOINT_H
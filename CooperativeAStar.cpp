@@ -0,0 +1,401 @@
+#include "CooperativeAStar.h"
+#include "Utils.h"
+#include "Trace.h"
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+
+using namespace std;
+
+// ---- SpaceTimeTable ----
+
+SpaceTimeTable::SpaceTimeTable(size_t expected) {
+    size_t capacity = 16;
+    while (capacity < expected * 2) capacity *= 2;
+    m_keys.assign(capacity, EMPTY);
+    m_values.assign(capacity, NONE);
+    m_shift = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) m_shift--;
+}
+
+int SpaceTimeTable::find(int32_t cell, int32_t time) const {
+    uint64_t k = key(cell, time);
+    size_t mask = m_keys.size() - 1;
+    for (size_t i = slot(k); ; i = (i + 1) & mask) {
+        if (m_keys[i] == k) return m_values[i];
+        if (m_keys[i] == EMPTY) return NONE;
+    }
+}
+
+void SpaceTimeTable::set(int32_t cell, int32_t time, int value) {
+    if ((m_size + 1) * 2 > m_keys.size()) grow();
+    uint64_t k = key(cell, time);
+    size_t mask = m_keys.size() - 1;
+    size_t i = slot(k);
+    while (m_keys[i] != EMPTY && m_keys[i] != k) i = (i + 1) & mask;
+    if (m_keys[i] == EMPTY) {
+        m_keys[i] = k;
+        m_size++;
+    }
+    m_values[i] = value;
+}
+
+void SpaceTimeTable::erase(int32_t cell, int32_t time) {
+    uint64_t k = key(cell, time);
+    size_t mask = m_keys.size() - 1;
+    size_t i = slot(k);
+    while (m_keys[i] != k) {
+        if (m_keys[i] == EMPTY) return;
+        i = (i + 1) & mask;
+    }
+
+    // Backward shift: pull later entries of the probe run into the hole
+    // unless that would move them before their home slot
+    for (size_t j = (i + 1) & mask; m_keys[j] != EMPTY; j = (j + 1) & mask) {
+        size_t home = slot(m_keys[j]);
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            m_keys[i] = m_keys[j];
+            m_values[i] = m_values[j];
+            i = j;
+        }
+    }
+    m_keys[i] = EMPTY;
+    m_values[i] = NONE;
+    m_size--;
+}
+
+void SpaceTimeTable::clear() {
+    if (m_size == 0) return;
+    fill(m_keys.begin(), m_keys.end(), EMPTY);
+    fill(m_values.begin(), m_values.end(), NONE);
+    m_size = 0;
+}
+
+void SpaceTimeTable::grow() {
+    vector<uint64_t> keys(m_keys.size() * 2, EMPTY);
+    vector<int32_t> values(keys.size(), NONE);
+    keys.swap(m_keys);
+    values.swap(m_values);
+    m_shift--;
+
+    size_t mask = m_keys.size() - 1;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (keys[i] == EMPTY) continue;
+        size_t j = slot(keys[i]);
+        while (m_keys[j] != EMPTY) j = (j + 1) & mask;
+        m_keys[j] = keys[i];
+        m_values[j] = values[i];
+    }
+}
+
+// ---- CooperativeAStar ----
+
+CooperativeAStar::CooperativeAStar(const Maze& maze, vector<Agent> agents, int window, unsigned threads,
+                                   size_t distanceBudget)
+    : m_rows(maze.getRows()),
+      m_cols(maze.getCols()),
+      m_window(max(2, window)),
+      m_distanceBudget(distanceBudget),
+      m_pool(threads),
+      m_agents(move(agents)),
+      m_reservations(m_agents.size() * (m_window + 2))
+{
+    size_t cells = (size_t)m_rows * m_cols;
+    m_open.assign(cells, 0);
+    for (int r = 0; r < m_rows; ++r) {
+        for (int c = 0; c < m_cols; ++c) {
+            m_open[(size_t)r * m_cols + c] = maze.grid[r][c] != '#';
+        }
+    }
+
+    size_t n = m_agents.size();
+    m_goalCell.resize(n);
+    m_goalDistance.resize(n);
+    m_pos.resize(n);
+    m_next.resize(n);
+    m_plan.assign(n, vector<int32_t>(m_window + 1));
+    m_planFailed.assign(n, 0);
+    m_occupant.assign(cells, -1);
+    for (size_t a = 0; a < n; ++a) {
+        m_pos[a] = m_agents[a].start.first * m_cols + m_agents[a].start.second;
+        m_goalCell[a] = m_agents[a].goal.first * m_cols + m_agents[a].goal.second;
+        m_occupant[m_pos[a]] = (int32_t)a;
+    }
+    m_workspaces.resize(m_pool.size());
+}
+
+int CooperativeAStar::distanceLevel(int agent, int32_t cell) {
+    GoalDistance& gd = m_goalDistance[agent];
+    if (gd.level.empty()) {
+        gd.level.assign((m_open.size() + 3) / 4, 0);
+        gd.set(m_goalCell[agent], 1);
+        gd.queue.assign(1, m_goalCell[agent]);
+        gd.head = 0;
+    }
+
+    // BFS distances are final once set, so only resume while 'cell' is unseen
+    while (gd.get(cell) == GoalDistance::UNSEEN && gd.head < gd.queue.size()) {
+        int32_t at = gd.queue[gd.head++];
+        int r = at / m_cols, c = at % m_cols;
+        int level = gd.get(at) % 3 + 1;
+        for (auto [dr, dc] : directions) {
+            int nr = r + dr, nc = c + dc;
+            if (nr < 0 || nr >= m_rows || nc < 0 || nc >= m_cols) continue;
+            int32_t next = nr * m_cols + nc;
+            if (!m_open[next] || gd.get(next) != GoalDistance::UNSEEN) continue;
+            gd.set(next, level);
+            gd.queue.push_back(next);
+        }
+
+        // Expanded cells are never needed again
+        if (gd.head >= 4096 && gd.head * 2 >= gd.queue.size()) {
+            gd.queue.erase(gd.queue.begin(), gd.queue.begin() + gd.head);
+            gd.head = 0;
+        }
+    }
+    return gd.get(cell);
+}
+
+void CooperativeAStar::limitDistances(const vector<int>& keep) {
+    size_t total = 0;
+    vector<pair<size_t, int>> bySize;
+    for (int a = 0; a < getAgentCount(); ++a) {
+        size_t bytes = m_goalDistance[a].getBytes();
+        total += bytes;
+        if (bytes > 0) bySize.push_back({bytes, a});
+    }
+    m_stats.peakDistanceBytes = max(m_stats.peakDistanceBytes, total);
+    if (total <= m_distanceBudget) return;
+
+    sort(bySize.rbegin(), bySize.rend());
+    for (auto [bytes, a] : bySize) {
+        if (total <= m_distanceBudget) break;
+        if (find(keep.begin(), keep.end(), a) != keep.end()) continue;
+        m_goalDistance[a] = GoalDistance();
+        total -= bytes;
+        m_stats.distanceResets++;
+    }
+}
+
+bool CooperativeAStar::reserved(int agent, int32_t from, int32_t to, int32_t time) const {
+    int owner = m_reservations.find(to, time + 1);
+    if (owner != SpaceTimeTable::NONE && owner != agent) return true;
+    if (from == to) return false;
+
+    // Whoever is at 'to' now must not be moving into 'from'
+    int other = m_reservations.find(to, time);
+    return other != SpaceTimeTable::NONE && other != agent && m_reservations.find(from, time + 1) == other;
+}
+
+bool CooperativeAStar::plan(int agent, Workspace& ws) {
+    const int32_t horizon = m_planStart + m_window;
+    const int32_t goal = m_goalCell[agent];
+    const greater<Workspace::Entry> later;
+    ws.nodes.clear();
+    ws.heap.clear();
+    ws.visited.clear();
+
+    int32_t start = m_pos[agent];
+    ws.nodes.push_back({start, m_planStart, 0, -1});
+    ws.visited.set(start, m_planStart, 0);
+    // h is kept relative to the start's distance: the offset is the same
+    // for every node, so it doesn't change which one A* expands next
+    ws.heap.push_back({0, 0, 0});
+
+    int best = -1;
+    while (!ws.heap.empty()) {
+        pop_heap(ws.heap.begin(), ws.heap.end(), later);
+        Workspace::Entry top = ws.heap.back();
+        ws.heap.pop_back();
+        Workspace::Node node = ws.nodes[top.node];
+        if (ws.visited.find(node.cell, node.time) != top.node) continue; // Superseded
+
+        // Every move costs 1 and h never drops by more, so the first state
+        // popped at the horizon has the smallest g + h
+        if (node.time == horizon) {
+            best = top.node;
+            break;
+        }
+        ws.expansions++;
+
+        const int nodeH = top.f - top.g;
+        const int nodeLevel = distanceLevel(agent, node.cell);
+        int r = node.cell / m_cols, c = node.cell % m_cols;
+        for (int d = 0; d <= 4; ++d) {
+            int32_t next = node.cell;
+            if (d < 4) {
+                int nr = r + directions[d].first, nc = c + directions[d].second;
+                if (nr < 0 || nr >= m_rows || nc < 0 || nc >= m_cols) continue;
+                next = nr * m_cols + nc;
+                if (!m_open[next]) continue;
+            }
+            if (reserved(agent, node.cell, next, node.time)) {
+                ws.conflictsAvoided++;
+                continue;
+            }
+            int level = distanceLevel(agent, next);
+            if (level == GoalDistance::UNSEEN) continue;
+            // Levels 1 -> 2 -> 3 -> 1 step away from the goal
+            int h = nodeH + (level == nodeLevel ? 0 : level == nodeLevel % 3 + 1 ? 1 : -1);
+
+            // Waiting on the goal is free: a finished agent just stays there
+            int32_t g = node.g + (next == goal && node.cell == goal ? 0 : 1);
+            int32_t time = node.time + 1;
+            int seen = ws.visited.find(next, time);
+            if (seen != SpaceTimeTable::NONE && ws.nodes[seen].g <= g) continue;
+
+            int32_t id = (int32_t)ws.nodes.size();
+            ws.nodes.push_back({next, time, g, top.node});
+            ws.visited.set(next, time, id);
+            ws.heap.push_back({g + h, g, id});
+            push_heap(ws.heap.begin(), ws.heap.end(), later);
+        }
+    }
+
+    vector<int32_t>& path = m_plan[agent];
+    if (best < 0) {
+        fill(path.begin(), path.end(), start);
+        return false;
+    }
+    for (int id = best; id != -1; id = ws.nodes[id].parent) {
+        path[ws.nodes[id].time - m_planStart] = ws.nodes[id].cell;
+    }
+    return true;
+}
+
+void CooperativeAStar::replan() {
+    TRACE_SCOPE("CooperativeAStar::replan");
+    auto begin = chrono::steady_clock::now();
+    const int n = getAgentCount();
+    m_planStart = m_time;
+    m_stats.rounds++;
+
+    // Everyone holds their cell now and for the next move, so nobody plans
+    // into an agent that ends up not moving
+    m_reservations.clear();
+    for (int a = 0; a < n; ++a) {
+        m_reservations.set(m_pos[a], m_time, a);
+        m_reservations.set(m_pos[a], m_time + 1, a);
+    }
+
+    // Waves in rotating priority order. Pairwise, which is cheap next to
+    // planning for the few hundred agents this is meant for.
+    const int reach = 2 * m_window + 1;
+    vector<int> order(n), wave(n, 0);
+    vector<vector<int>> waves;
+    for (int k = 0; k < n; ++k) order[k] = (int)((k + m_stats.rounds) % n);
+    for (int k = 0; k < n; ++k) {
+        int a = order[k];
+        int ar = m_pos[a] / m_cols, ac = m_pos[a] % m_cols;
+        for (int j = 0; j < k; ++j) {
+            int b = order[j];
+            int br = m_pos[b] / m_cols, bc = m_pos[b] % m_cols;
+            if (abs(ar - br) + abs(ac - bc) <= reach) wave[a] = max(wave[a], wave[b] + 1);
+        }
+        if (wave[a] >= (int)waves.size()) waves.resize(wave[a] + 1);
+        waves[wave[a]].push_back(a);
+    }
+
+    for (const vector<int>& agents : waves) {
+        limitDistances(agents);
+
+        // Agents in one wave are too far apart to touch each other's
+        // reservations, so they only read the table
+        m_pool.parallelFor(agents.size(), [&](unsigned t, size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                m_planFailed[agents[i]] = !plan(agents[i], m_workspaces[t]);
+            }
+        });
+
+        for (int a : agents) {
+            const vector<int32_t>& path = m_plan[a];
+            if (path[1] != m_pos[a] && m_reservations.find(m_pos[a], m_time + 1) == a) {
+                m_reservations.erase(m_pos[a], m_time + 1);
+            }
+            for (int k = 0; k <= m_window; ++k) {
+                // A blocked agent keeps whatever of its cell is still free
+                if (m_planFailed[a]) {
+                    int owner = m_reservations.find(path[k], m_time + k);
+                    if (owner != SpaceTimeTable::NONE && owner != a) continue;
+                }
+                m_reservations.set(path[k], m_time + k, a);
+            }
+            m_stats.failedPlans += m_planFailed[a];
+        }
+    }
+
+    limitDistances({});
+    for (Workspace& ws : m_workspaces) {
+        m_stats.expansions += ws.expansions;
+        m_stats.conflictsAvoided += ws.conflictsAvoided;
+        ws.expansions = ws.conflictsAvoided = 0;
+    }
+    m_stats.replans += n;
+    m_stats.waves += (long long)waves.size();
+    m_stats.planSeconds += chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+}
+
+bool CooperativeAStar::step() {
+    TRACE_SCOPE("CooperativeAStar::step");
+    const int n = getAgentCount();
+    if (getArrived() == n) return false;
+
+    if (m_stats.rounds == 0 || m_time - m_planStart >= m_window / 2) replan();
+
+    int k = m_time + 1 - m_planStart;
+    for (int a = 0; a < n; ++a) m_next[a] = m_plan[a][k];
+
+    // Swaps: the agent in the cell being entered is moving into ours
+    for (int a = 0; a < n; ++a) {
+        if (m_next[a] == m_pos[a]) continue;
+        int b = m_occupant[m_next[a]];
+        if (b > a && m_next[b] == m_pos[a]) m_stats.collisions++;
+    }
+    for (int a = 0; a < n; ++a) m_occupant[m_pos[a]] = -1;
+    for (int a = 0; a < n; ++a) {
+        if (m_occupant[m_next[a]] != -1) m_stats.collisions++;
+        m_occupant[m_next[a]] = a;
+        m_stats.moves += m_next[a] != m_pos[a];
+        m_pos[a] = m_next[a];
+    }
+
+    m_time++;
+    m_stats.ticks++;
+    return getArrived() < n;
+}
+
+int CooperativeAStar::getArrived() const {
+    int arrived = 0;
+    for (size_t a = 0; a < m_pos.size(); ++a) arrived += m_pos[a] == m_goalCell[a];
+    return arrived;
+}
+
+vector<CooperativeAStar::Agent> CooperativeAStar::randomAgents(const Maze& maze, int count, unsigned seed) {
+    // Cells reachable from the maze's start
+    int rows = maze.getRows(), cols = maze.getCols();
+    vector<char> seen((size_t)rows * cols, 0);
+    vector<pair<int, int>> component{maze.getStart()};
+    seen[(size_t)maze.getStart().first * cols + maze.getStart().second] = 1;
+    for (size_t head = 0; head < component.size(); ++head) {
+        auto [r, c] = component[head];
+        for (auto [dr, dc] : directions) {
+            int nr = r + dr, nc = c + dc;
+            if (!isInside(maze.grid, nr, nc) || maze.grid[nr][nc] == '#') continue;
+            if (seen[(size_t)nr * cols + nc]) continue;
+            seen[(size_t)nr * cols + nc] = 1;
+            component.push_back({nr, nc});
+        }
+    }
+
+    count = max(0, min(count, (int)component.size()));
+    mt19937 rng(seed);
+    vector<pair<int, int>> starts = component, goals = component;
+    shuffle(starts.begin(), starts.end(), rng);
+    shuffle(goals.begin(), goals.end(), rng);
+
+    vector<Agent> agents(count);
+    for (int i = 0; i < count; ++i) agents[i] = {starts[i], goals[i]};
+    return agents;
+}
@@ -0,0 +1,170 @@
+#ifndef COOPERATIVE_ASTAR_H
+#define COOPERATIVE_ASTAR_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include "Maze.h"
+#include "ThreadPool.h"
+
+// Compact open-addressing hash from (cell, time) to an int, with linear
+// probing and backward-shift deletion (no tombstones). Keys and values sit
+// in two flat arrays, 12 bytes per slot, kept at most half full.
+class SpaceTimeTable {
+public:
+    static constexpr int NONE = -1;
+
+    explicit SpaceTimeTable(std::size_t expected = 1024);
+
+    static std::uint64_t key(std::int32_t cell, std::int32_t time) {
+        return (std::uint64_t)(std::uint32_t)cell << 32 | (std::uint32_t)time;
+    }
+
+    int find(std::int32_t cell, std::int32_t time) const;     // NONE if absent
+    void set(std::int32_t cell, std::int32_t time, int value); // Insert or overwrite
+    void erase(std::int32_t cell, std::int32_t time);
+    void clear();
+
+    std::size_t size() const { return m_size; }
+    std::size_t getSizeBytes() const { return m_keys.size() * (sizeof(std::uint64_t) + sizeof(std::int32_t)); }
+
+private:
+    static constexpr std::uint64_t EMPTY = ~std::uint64_t(0);
+
+    std::size_t slot(std::uint64_t k) const { return (std::size_t)((k * 0x9E3779B97F4A7C15ull) >> m_shift); }
+    void grow();
+
+    std::vector<std::uint64_t> m_keys;
+    std::vector<std::int32_t> m_values;
+    std::size_t m_size = 0;
+    int m_shift = 64;
+};
+
+// Windowed Hierarchical Cooperative A* (Silver 2005) for many agents in one maze.
+// Every 'window / 2' moves all agents replan, in priority order, a path for
+// the next 'window' moves through space-time (cell, time). Each agent avoids
+// the cells the agents before it reserved in the shared reservation table,
+// and the swaps those reservations would cause, then reserves its own path.
+// Beyond the window an agent is guided by its true distance to the goal,
+// found by a BFS from the goal that is resumed only as far as a lookup
+// needs (as in Reverse Resumable A*). Neighbouring cells are at most one
+// move apart in that distance, so the search only needs it mod 3 (2 bits a
+// cell) to tell how h changes along each move. All agents' BFSs share a byte
+// budget: past it, the largest are dropped between waves and regrown on demand.
+//
+// Two agents can only interact within a window if they start at most
+// 2 * window + 1 moves apart. Agents are therefore split into waves in
+// priority order: each agent goes one wave after the latest higher-priority
+// agent near it. A wave is planned in parallel on the thread pool, reading
+// the table only, and its reservations are written once the wave is done.
+// Priorities rotate every round so no agent always yields.
+class CooperativeAStar {
+public:
+    struct Agent {
+        std::pair<int, int> start, goal;
+    };
+
+    struct Stats {
+        long long ticks = 0;
+        long long rounds = 0;            // Replanning rounds
+        long long replans = 0;           // Agent plans
+        long long waves = 0;
+        long long expansions = 0;        // Space-time states expanded
+        long long conflictsAvoided = 0;  // Moves rejected because they were reserved
+        long long failedPlans = 0;       // No reservation-free path: the agent waited
+        long long collisions = 0;        // Two agents in one cell, or swapping cells
+        long long moves = 0;             // Moves that changed cell, summed over agents
+        long long distanceResets = 0;    // Goal distances dropped to stay within the budget
+        std::size_t peakDistanceBytes = 0;
+        double planSeconds = 0;
+    };
+
+    static constexpr std::size_t DEFAULT_DISTANCE_BUDGET = (std::size_t)128 << 20;
+
+    // window: moves planned ahead; threads == 0 means one per core;
+    // distanceBudget: bytes for all agents' goal distances together
+    CooperativeAStar(const Maze& maze, std::vector<Agent> agents, int window = 16, unsigned threads = 0,
+                     std::size_t distanceBudget = DEFAULT_DISTANCE_BUDGET);
+
+    // Moves every agent one step (replanning first when due); false once
+    // every agent is at its goal
+    bool step();
+
+    int getAgentCount() const { return (int)m_agents.size(); }
+    std::pair<int, int> getPosition(int agent) const { return {m_pos[agent] / m_cols, m_pos[agent] % m_cols}; }
+    std::pair<int, int> getGoal(int agent) const { return m_agents[agent].goal; }
+    int getArrived() const;
+    int getWindow() const { return m_window; }
+    unsigned getThreadCount() const { return m_pool.size(); }
+    const Stats& getStats() const { return m_stats; }
+    std::size_t getReservationBytes() const { return m_reservations.getSizeBytes(); }
+
+    // 'count' agents with distinct starts and distinct goals, all in the
+    // maze's start component so every goal is reachable
+    static std::vector<Agent> randomAgents(const Maze& maze, int count, unsigned seed);
+
+private:
+    // Reverse BFS from one goal, expanded lazily
+    struct GoalDistance {
+        static constexpr int UNSEEN = 0;  // Not reached (yet); else distance % 3 + 1
+        std::vector<std::uint8_t> level;  // 2 bits per cell, four cells a byte
+        std::vector<std::int32_t> queue;  // Cells still to expand from 'head' on
+        std::size_t head = 0;
+
+        int get(std::int32_t cell) const { return (level[cell >> 2] >> ((cell & 3) * 2)) & 3; }
+        void set(std::int32_t cell, int v) { level[cell >> 2] |= (std::uint8_t)(v << ((cell & 3) * 2)); }
+        std::size_t getBytes() const { return level.capacity() + queue.capacity() * sizeof(std::int32_t); }
+    };
+
+    // Per-thread search buffers, reused across plans
+    struct Workspace {
+        struct Node {
+            std::int32_t cell, time, g, parent;
+        };
+        struct Entry {
+            std::int32_t f, g, node;
+            // Lowest f first; among equal f prefer the deeper node
+            bool operator>(const Entry& o) const { return f != o.f ? f > o.f : g < o.g; }
+        };
+        std::vector<Node> nodes;
+        std::vector<Entry> heap;
+        SpaceTimeTable visited{4096};
+        long long expansions = 0, conflictsAvoided = 0;
+    };
+
+    // Goal distance of 'cell' mod 3, plus 1; UNSEEN if the goal can't reach it
+    int distanceLevel(int agent, std::int32_t cell);
+    // Drops the largest goal distances, other than those of 'keep', until
+    // the rest fit in the budget
+    void limitDistances(const std::vector<int>& keep);
+    // Moving 'from' -> 'to' between 'time' and 'time' + 1 enters a cell
+    // another agent reserved, or swaps places with one
+    bool reserved(int agent, std::int32_t from, std::int32_t to, std::int32_t time) const;
+    // Fills m_plan[agent] for m_planStart..m_planStart + window; false if
+    // every path was blocked (the agent then waits where it is)
+    bool plan(int agent, Workspace& ws);
+    void replan();
+
+    int m_rows, m_cols;
+    int m_window;
+    std::size_t m_distanceBudget;
+    ThreadPool m_pool;
+    std::vector<std::uint8_t> m_open; // 1 = not a wall
+    std::vector<Agent> m_agents;
+    std::vector<std::int32_t> m_goalCell;
+    std::vector<GoalDistance> m_goalDistance;
+
+    std::vector<std::int32_t> m_pos;
+    std::vector<std::vector<std::int32_t>> m_plan; // Cells for times m_planStart..m_planStart + window
+    std::vector<char> m_planFailed;
+    std::int32_t m_time = 0, m_planStart = 0;
+
+    SpaceTimeTable m_reservations; // (cell, time) -> agent
+    std::vector<Workspace> m_workspaces;
+    std::vector<std::int32_t> m_occupant; // Cell -> agent, for collision checks
+    std::vector<std::int32_t> m_next;
+    Stats m_stats;
+};
+
+#endif // COOPERATIVE_ASTAR_H
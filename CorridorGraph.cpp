@@ -0,0 +1,377 @@
+#include "CorridorGraph.h"
+#include "Utils.h"
+#include "Trace.h"
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+
+using namespace std;
+
+void CorridorGraph::build(const Maze& maze) {
+    TRACE_SCOPE("CorridorGraph::build");
+    m_rows = maze.getRows();
+    m_cols = maze.getCols();
+    size_t cells = (size_t)m_rows * m_cols;
+    m_open.assign(cells, 0);
+    m_cellIndex.assign(cells, -1);
+    m_cellOffset.assign(cells, -1);
+    m_nodeCell.clear();
+    m_edges.clear();
+    m_maxLength = 1;
+    m_openCells = 0;
+
+    for (int r = 0; r < m_rows; ++r) {
+        for (int c = 0; c < m_cols; ++c) {
+            m_open[(size_t)r * m_cols + c] = maze.grid[r][c] != '#';
+            m_openCells += maze.grid[r][c] != '#';
+        }
+    }
+
+    auto openNeighbours = [&](int r, int c) {
+        int degree = 0;
+        for (auto [dr, dc] : directions) {
+            int nr = r + dr, nc = c + dc;
+            degree += isInside(maze.grid, nr, nc) && m_open[(size_t)nr * m_cols + nc];
+        }
+        return degree;
+    };
+    auto addNode = [&](int32_t cell) {
+        m_cellIndex[cell] = (int32_t)m_nodeCell.size();
+        m_cellOffset[cell] = 0;
+        m_nodeCell.push_back(cell);
+    };
+
+    // Nodes: every open cell that isn't the middle of a corridor
+    for (int r = 0; r < m_rows; ++r) {
+        for (int c = 0; c < m_cols; ++c) {
+            int32_t cell = r * m_cols + c;
+            if (m_open[cell] && openNeighbours(r, c) != 2) addNode(cell);
+        }
+    }
+    for (size_t node = 0; node < m_nodeCell.size(); ++node) {
+        for (int d = 0; d < 4; ++d) walkCorridor((int32_t)node, d);
+    }
+
+    // Whatever is left are closed loops of corridor cells
+    for (int32_t cell = 0; cell < (int32_t)cells; ++cell) {
+        if (!m_open[cell] || m_cellOffset[cell] != -1) continue;
+        addNode(cell);
+        for (int d = 0; d < 4; ++d) walkCorridor(m_cellIndex[cell], d);
+    }
+
+    // CSR adjacency, both directions of every edge
+    size_t nodes = m_nodeCell.size();
+    m_adjStart.assign(nodes + 1, 0);
+    for (const Edge& e : m_edges) {
+        if (e.from == e.to) continue;
+        m_adjStart[e.from + 1]++;
+        m_adjStart[e.to + 1]++;
+    }
+    for (size_t n = 0; n < nodes; ++n) m_adjStart[n + 1] += m_adjStart[n];
+    m_adjTarget.assign(m_adjStart[nodes], 0);
+    m_adjWeight.assign(m_adjStart[nodes], 0);
+    m_adjEdge.assign(m_adjStart[nodes], 0);
+
+    vector<int32_t> fill(m_adjStart.begin(), m_adjStart.end() - 1);
+    for (int32_t e = 0; e < (int32_t)m_edges.size(); ++e) {
+        const Edge& edge = m_edges[e];
+        if (edge.from == edge.to) continue;
+        int32_t i = fill[edge.from]++, j = fill[edge.to]++;
+        m_adjTarget[i] = edge.to;
+        m_adjTarget[j] = edge.from;
+        m_adjWeight[i] = m_adjWeight[j] = edge.length;
+        m_adjEdge[i] = m_adjEdge[j] = e;
+    }
+}
+
+void CorridorGraph::walkCorridor(int32_t node, int move) {
+    int32_t origin = m_nodeCell[node];
+    int r = origin / m_cols + directions[move].first;
+    int c = origin % m_cols + directions[move].second;
+    if (r < 0 || c < 0 || r >= m_rows || c >= m_cols) return;
+    int32_t cell = r * m_cols + c;
+    if (!m_open[cell]) return;
+
+    int32_t edgeId = (int32_t)m_edges.size();
+    if (m_cellOffset[cell] == 0) {
+        // Two adjacent nodes: one edge of length 1, added from the lower id
+        if (m_cellIndex[cell] > node) m_edges.push_back({node, m_cellIndex[cell], 1, (uint8_t)move});
+        return;
+    }
+    if (m_cellOffset[cell] != -1) return; // Walked already, from its other end
+
+    // Inner cells have exactly two open neighbours: keep leaving by the one
+    // we didn't come from
+    int32_t prev = origin;
+    int32_t length = 1;
+    while (m_cellOffset[cell] != 0) {
+        m_cellIndex[cell] = edgeId;
+        m_cellOffset[cell] = length;
+
+        int32_t next = -1;
+        for (auto [dr, dc] : directions) {
+            int nr = cell / m_cols + dr, nc = cell % m_cols + dc;
+            if (nr < 0 || nc < 0 || nr >= m_rows || nc >= m_cols) continue;
+            int32_t n = nr * m_cols + nc;
+            if (m_open[n] && n != prev) {
+                next = n;
+                break;
+            }
+        }
+        prev = cell;
+        cell = next;
+        length++;
+    }
+    m_edges.push_back({node, m_cellIndex[cell], length, (uint8_t)move});
+    m_maxLength = max(m_maxLength, length);
+}
+
+void CorridorGraph::appendEdgeCells(int edge, int a, int b, vector<int32_t>& out) const {
+    // Walk the corridor from its 'from' end, keeping offsets min(a,b)..max(a,b)
+    const Edge& e = m_edges[edge];
+    int lo = min(a, b), hi = max(a, b);
+    size_t first = out.size();
+
+    int32_t prev = -1, cell = m_nodeCell[e.from];
+    for (int offset = 0; offset <= hi; ++offset) {
+        if (offset >= lo) out.push_back(cell);
+        if (offset == hi) break;
+
+        int32_t next = -1;
+        if (offset == 0) {
+            next = cell + directions[e.firstMove].first * m_cols + directions[e.firstMove].second;
+        } else {
+            for (auto [dr, dc] : directions) {
+                int nr = cell / m_cols + dr, nc = cell % m_cols + dc;
+                if (nr < 0 || nc < 0 || nr >= m_rows || nc >= m_cols) continue;
+                int32_t n = nr * m_cols + nc;
+                if (m_open[n] && n != prev) {
+                    next = n;
+                    break;
+                }
+            }
+        }
+        prev = cell;
+        cell = next;
+    }
+    if (a > b) reverse(out.begin() + first, out.end());
+}
+
+int CorridorGraph::nodeAt(int r, int c) const {
+    int32_t cell = r * m_cols + c;
+    return m_cellOffset[cell] == 0 ? m_cellIndex[cell] : -1;
+}
+
+size_t CorridorGraph::getSizeBytes() const {
+    return m_open.size() + (m_cellIndex.size() + m_cellOffset.size() + m_nodeCell.size()) * sizeof(int32_t) +
+           m_edges.size() * sizeof(Edge) +
+           (m_adjStart.size() + m_adjTarget.size() + m_adjWeight.size() + m_adjEdge.size()) * sizeof(int32_t);
+}
+
+CorridorGraph::Result CorridorGraph::solve(Algorithm algorithm, pair<int, int> start, pair<int, int> goal) const {
+    TRACE_SCOPE("CorridorGraph::solve");
+    Search search(*this, algorithm, start, goal);
+    while (search.step()) {}
+    return search.result();
+}
+
+CorridorGraph::Search::Search(const CorridorGraph& graph, Algorithm algorithm, pair<int, int> start, pair<int, int> goal)
+    : m_graph(graph),
+      m_algorithm(algorithm),
+      m_startCell(start.first * graph.m_cols + start.second),
+      m_goalCell(goal.first * graph.m_cols + goal.second),
+      m_goalR(goal.first),
+      m_goalC(goal.second)
+{
+    size_t nodes = graph.getNodeCount();
+    m_dist.assign(nodes, INF);
+    m_parentNode.assign(nodes, NO_PARENT);
+    m_parentEdge.assign(nodes, -1);
+    m_settled.assign(nodes, 0);
+    if (algorithm == Algorithm::BFS) m_buckets.resize(graph.m_maxLength + 1);
+
+    if (!graph.m_open[m_startCell] || !graph.m_open[m_goalCell]) {
+        m_finished = true;
+        return;
+    }
+
+    int startIndex = graph.m_cellIndex[m_startCell], startOffset = graph.m_cellOffset[m_startCell];
+    if (startOffset == 0) {
+        seed(startIndex, 0, -1, NO_PARENT);
+    } else {
+        const Edge& e = graph.m_edges[startIndex];
+        seed(e.from, startOffset, startIndex, FROM_START_BACK);
+        seed(e.to, e.length - startOffset, startIndex, FROM_START_FORWARD);
+
+        // Start and goal in the same corridor: straight along it
+        if (graph.m_cellIndex[m_goalCell] == startIndex && graph.m_cellOffset[m_goalCell] != 0) {
+            m_best = abs(graph.m_cellOffset[m_goalCell] - startOffset);
+            m_bestVia = -1;
+        }
+    }
+    if (m_startCell == m_goalCell) m_best = 0;
+}
+
+void CorridorGraph::Search::seed(int node, int dist, int edge, int side) {
+    if (dist >= m_dist[node]) return; // Both ends of a loop lead to the same node
+    m_dist[node] = dist;
+    m_parentEdge[node] = edge;
+    m_parentNode[node] = side;
+    push(node);
+}
+
+void CorridorGraph::Search::push(int node) {
+    int g = m_dist[node];
+    int key = g;
+    if (m_algorithm == Algorithm::AStar) {
+        // Manhattan distance: a corridor is never shorter than that
+        int32_t cell = m_graph.m_nodeCell[node];
+        key += abs(m_goalR - cell / m_graph.m_cols) + abs(m_goalC - cell % m_graph.m_cols);
+    }
+
+    if (m_algorithm == Algorithm::BFS) {
+        // Pending keys always lie within one longest edge of the cursor
+        m_buckets[key % m_buckets.size()].push_back({key, g, node});
+    } else {
+        m_heap.push_back({key, g, node});
+        push_heap(m_heap.begin(), m_heap.end(), greater<Entry>());
+    }
+    m_queued++;
+}
+
+size_t CorridorGraph::Search::getSizeBytes() const {
+    size_t bytes = (m_dist.capacity() + m_parentNode.capacity() + m_parentEdge.capacity()) * sizeof(int) +
+                   m_settled.capacity() + m_heap.capacity() * sizeof(Entry);
+    for (const vector<Entry>& bucket : m_buckets) bytes += bucket.capacity() * sizeof(Entry);
+    return bytes;
+}
+
+bool CorridorGraph::Search::pop(Entry& entry) {
+    while (m_queued > 0) {
+        if (m_algorithm == Algorithm::BFS) {
+            vector<Entry>& bucket = m_buckets[m_bucketCursor % m_buckets.size()];
+            if (bucket.empty()) {
+                m_bucketCursor++;
+                continue;
+            }
+            entry = bucket.back();
+            bucket.pop_back();
+        } else {
+            pop_heap(m_heap.begin(), m_heap.end(), greater<Entry>());
+            entry = m_heap.back();
+            m_heap.pop_back();
+        }
+        m_queued--;
+
+        // Skip entries for nodes that got a shorter distance since
+        if (!m_settled[entry.node] && entry.g == m_dist[entry.node]) return true;
+    }
+    return false;
+}
+
+bool CorridorGraph::Search::step() {
+    if (m_finished) return false;
+
+    Entry top;
+    if (!pop(top) || top.key >= m_best) {
+        // Nothing left that could beat the best path
+        m_finished = true;
+        m_lastSettled = -1;
+        return false;
+    }
+    settle(top.node);
+    return true;
+}
+
+void CorridorGraph::Search::settle(int node) {
+    m_settled[node] = 1;
+    m_explored++;
+    m_lastSettled = node;
+    int dist = m_dist[node];
+
+    // Can the goal be reached from here?
+    int goalIndex = m_graph.m_cellIndex[m_goalCell], goalOffset = m_graph.m_cellOffset[m_goalCell];
+    if (goalOffset == 0) {
+        if (goalIndex == node && dist < m_best) {
+            m_best = dist;
+            m_bestVia = node;
+        }
+    } else {
+        const Edge& e = m_graph.m_edges[goalIndex];
+        if (e.from == node && dist + goalOffset < m_best) {
+            m_best = dist + goalOffset;
+            m_bestVia = node;
+            m_bestFromBack = true;
+        }
+        if (e.to == node && dist + e.length - goalOffset < m_best) {
+            m_best = dist + e.length - goalOffset;
+            m_bestVia = node;
+            m_bestFromBack = false;
+        }
+    }
+
+    for (int32_t i = m_graph.m_adjStart[node]; i < m_graph.m_adjStart[node + 1]; ++i) {
+        int next = m_graph.m_adjTarget[i];
+        int nd = dist + m_graph.m_adjWeight[i];
+        if (m_settled[next] || nd >= m_dist[next]) continue;
+        m_dist[next] = nd;
+        m_parentNode[next] = node;
+        m_parentEdge[next] = m_graph.m_adjEdge[i];
+        push(next);
+    }
+}
+
+CorridorGraph::Result CorridorGraph::Search::result() const {
+    Result result;
+    result.nodesExplored = m_explored;
+    if (m_best >= INF) return result;
+
+    // Goal back to start, then reversed
+    vector<int32_t> cells;
+    int goalIndex = m_graph.m_cellIndex[m_goalCell], goalOffset = m_graph.m_cellOffset[m_goalCell];
+    int startOffset = m_graph.m_cellOffset[m_startCell];
+
+    if (m_startCell == m_goalCell) {
+        cells.push_back(m_goalCell);
+    } else if (m_bestVia == -1) {
+        m_graph.appendEdgeCells(goalIndex, goalOffset, startOffset, cells);
+    } else {
+        if (goalOffset == 0) {
+            cells.push_back(m_goalCell);
+        } else {
+            int end = m_bestFromBack ? 0 : m_graph.m_edges[goalIndex].length;
+            m_graph.appendEdgeCells(goalIndex, goalOffset, end, cells);
+        }
+
+        // Each node's cell is already in 'cells'; add the corridor behind it
+        int node = m_bestVia;
+        while (true) {
+            int parent = m_parentNode[node];
+            int edge = m_parentEdge[node];
+            if (parent == NO_PARENT) break;
+
+            const Edge& e = m_graph.m_edges[edge];
+            if (parent == FROM_START_BACK) {
+                m_graph.appendEdgeCells(edge, 1, startOffset, cells);
+                break;
+            }
+            if (parent == FROM_START_FORWARD) {
+                m_graph.appendEdgeCells(edge, e.length - 1, startOffset, cells);
+                break;
+            }
+            if (e.from == node) {
+                m_graph.appendEdgeCells(edge, 1, e.length, cells);
+            } else {
+                m_graph.appendEdgeCells(edge, e.length - 1, 0, cells);
+            }
+            node = parent;
+        }
+    }
+    reverse(cells.begin(), cells.end());
+
+    result.found = true;
+    result.pathLength = (int)cells.size();
+    result.path.reserve(cells.size());
+    for (int32_t cell : cells) result.path.push_back({cell / m_graph.m_cols, cell % m_graph.m_cols});
+    return result;
+}
@@ -0,0 +1,143 @@
+#ifndef CORRIDOR_GRAPH_H
+#define CORRIDOR_GRAPH_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include "Maze.h"
+
+// The maze compiled into a smaller weighted graph.
+// Every open cell with other than two open neighbours (junctions, dead ends,
+// isolated cells) becomes a node. Each run of two-neighbour cells between
+// nodes becomes one edge whose weight is its length in moves. Adjacency is
+// stored in CSR form (one offset array, flat target/weight arrays).
+//
+// Every open cell remembers its edge and its offset along it, so queries
+// may start and end anywhere, and paths expand back to exact grid cells.
+// A loop with no junction on it gets one of its cells as a node.
+class CorridorGraph {
+public:
+    enum class Algorithm {
+        BFS,      // Bucket queue by distance (BFS generalised to edge lengths)
+        Dijkstra, // Binary heap by distance
+        AStar     // Binary heap by distance + Manhattan distance to the goal
+    };
+
+    struct Result {
+        bool found = false;
+        int pathLength = 0;    // Grid cells on the path including start and goal, like Solver
+        int nodesExplored = 0; // Graph nodes settled
+        std::vector<std::pair<int, int>> path; // Start to goal, every grid cell
+    };
+
+    // One query. Each step() settles one graph node, so a Solver can show
+    // the search as it runs (see Corridor_Solver).
+    class Search {
+    public:
+        Search(const CorridorGraph& graph, Algorithm algorithm, std::pair<int, int> start, std::pair<int, int> goal);
+
+        // Settles the next node; false once the search is over
+        bool step();
+        bool isFinished() const { return m_finished; }
+
+        int getLastSettled() const { return m_lastSettled; } // Node, or -1
+        int getNodesExplored() const { return m_explored; }
+        std::size_t getQueueSize() const { return m_queued; } // Stale entries included
+        std::size_t getSizeBytes() const;
+
+        // The shortest path (valid once finished)
+        Result result() const;
+
+    private:
+        struct Entry {
+            int key;  // Distance, or distance + heuristic for A*
+            int g;
+            int node;
+            // Lowest key first; among equal keys prefer the deeper node
+            bool operator>(const Entry& o) const { return key != o.key ? key > o.key : g < o.g; }
+        };
+
+        static constexpr int INF = 1 << 30;
+        static constexpr int NO_PARENT = -1; // The start cell is this node
+        static constexpr int FROM_START_BACK = -2;    // Reached from the start along its edge towards 'from'
+        static constexpr int FROM_START_FORWARD = -3; // ... towards 'to'
+
+        void seed(int node, int dist, int edge, int side);
+        void push(int node);
+        bool pop(Entry& entry);
+        void settle(int node);
+
+        const CorridorGraph& m_graph;
+        Algorithm m_algorithm;
+        std::int32_t m_startCell, m_goalCell;
+        int m_goalR, m_goalC;
+
+        std::vector<int> m_dist;
+        std::vector<int> m_parentNode; // Node, or one of the start codes above
+        std::vector<int> m_parentEdge;
+        std::vector<char> m_settled;
+
+        std::vector<Entry> m_heap;                 // Dijkstra, A*
+        std::vector<std::vector<Entry>> m_buckets; // BFS: circular, one per distance
+        int m_bucketCursor = 0;
+        std::size_t m_queued = 0;
+
+        int m_best = INF;    // Shortest start-goal distance found so far
+        int m_bestVia = -1;  // Node the best path reaches the goal from (-1 = direct)
+        bool m_bestFromBack = false; // Goal on an edge: entered from its 'from' end
+        int m_explored = 0;
+        int m_lastSettled = -1;
+        bool m_finished = false;
+    };
+
+    CorridorGraph() = default;
+    explicit CorridorGraph(const Maze& maze) { build(maze); }
+
+    void build(const Maze& maze);
+
+    // Runs a whole query at once
+    Result solve(Algorithm algorithm, std::pair<int, int> start, std::pair<int, int> goal) const;
+
+    int getRows() const { return m_rows; }
+    int getCols() const { return m_cols; }
+    std::size_t getNodeCount() const { return m_nodeCell.size(); }
+    std::size_t getEdgeCount() const { return m_edges.size(); }
+    std::size_t getOpenCells() const { return m_openCells; }
+    std::size_t getSizeBytes() const;
+
+    std::pair<int, int> nodeCell(int node) const { return {m_nodeCell[node] / m_cols, m_nodeCell[node] % m_cols}; }
+    // Node at a cell, or -1 if the cell is a wall or inside a corridor
+    int nodeAt(int r, int c) const;
+
+private:
+    struct Edge {
+        std::int32_t from, to; // Nodes at offset 0 and offset 'length'
+        std::int32_t length;   // Moves from one end to the other
+        std::uint8_t firstMove; // Index into 'directions', leaving 'from'
+    };
+
+    // Follows a corridor from 'node' leaving by 'move', assigning offsets to
+    // its inner cells; adds the edge unless it was already found from the other end
+    void walkCorridor(std::int32_t node, int move);
+
+    // Grid cells of an edge from offset 'a' to offset 'b' (both included), in that order
+    void appendEdgeCells(int edge, int a, int b, std::vector<std::int32_t>& out) const;
+
+    int m_rows = 0, m_cols = 0;
+    std::size_t m_openCells = 0;
+    std::vector<std::uint8_t> m_open;       // 1 = not a wall
+    std::vector<std::int32_t> m_cellIndex;  // Node id (offset 0) or edge id, -1 for walls
+    std::vector<std::int32_t> m_cellOffset; // 0 for nodes, 1..length-1 inside an edge, -1 for walls
+    std::vector<std::int32_t> m_nodeCell;   // Node -> cell id
+    std::vector<Edge> m_edges;
+    std::int32_t m_maxLength = 1;
+
+    // CSR adjacency (self-loops left out; they never shorten a path)
+    std::vector<std::int32_t> m_adjStart;  // Node -> first entry; one extra sentinel
+    std::vector<std::int32_t> m_adjTarget;
+    std::vector<std::int32_t> m_adjWeight;
+    std::vector<std::int32_t> m_adjEdge;
+};
+
+#endif // CORRIDOR_GRAPH_H
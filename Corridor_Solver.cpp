@@ -0,0 +1,79 @@
+#include "Corridor_Solver.h"
+
+using namespace std;
+
+Corridor_Solver::Corridor_Solver(const Maze& maze, const CorridorGraph& graph, CorridorGraph::Algorithm algorithm)
+    : Solver(maze, 'C'),
+      m_graph(graph),
+      m_search(graph, algorithm, maze.getStart(), maze.getGoal())
+{
+    // Start the algorithm's timer
+    m_clock.restart();
+}
+
+Corridor_Solver::Corridor_Solver(const Maze& maze, CorridorGraph::Algorithm algorithm)
+    : Solver(maze, 'C'),
+      m_ownGraph(make_unique<CorridorGraph>(maze)),
+      m_graph(*m_ownGraph),
+      m_search(*m_ownGraph, algorithm, maze.getStart(), maze.getGoal())
+{
+    // Start the algorithm's timer
+    m_clock.restart();
+}
+
+void Corridor_Solver::step() {
+
+    // Draw the expanded path, goal to start
+    if (currentState == State::TRACING_PATH) {
+
+        // Count this node as part of the final path
+        m_pathLength++;
+
+        if (m_traceIndex == 0) {
+            currentState = State::DONE;
+            return;
+        }
+        auto [r, c] = m_path[m_traceIndex];
+        if (grid[r][c] != 'E') {
+            grid[r][c] = 'X';
+            logEvent(EventLog::Type::Path, r, c);
+        }
+        m_traceIndex--;
+        return;
+    }
+
+    if (currentState != State::SEARCHING) return;
+
+    if (m_search.step()) {
+        // Only junctions and dead ends are expanded
+        auto [r, c] = m_graph.nodeCell(m_search.getLastSettled());
+        m_nodesExplored = m_search.getNodesExplored();
+        if (grid[r][c] == ' ')
+            grid[r][c] = symbol;
+        logEvent(EventLog::Type::Expanded, r, c);
+        return;
+    }
+
+    m_timeTaken = m_resumedTime + m_clock.getElapsedTime();
+    CorridorGraph::Result result = m_search.result();
+    m_nodesExplored = result.nodesExplored;
+    found = result.found;
+    if (!found) {
+        currentState = State::DONE;
+        return;
+    }
+
+    // Point the shared parent map along the path, for getPath()
+    m_path = move(result.path);
+    for (size_t i = 1; i < m_path.size(); ++i) {
+        parent[m_path[i].first][m_path[i].second] = m_path[i - 1];
+    }
+    currentState = State::TRACING_PATH;
+    m_traceIndex = m_path.size() - 1;
+}
+
+size_t Corridor_Solver::getMemoryBytes() const {
+    // A graph passed in is shared, so only an owned one counts
+    return Solver::getMemoryBytes() + (m_ownGraph ? m_ownGraph->getSizeBytes() : 0) + m_search.getSizeBytes() +
+           m_path.capacity() * sizeof(pair<int, int>);
+}
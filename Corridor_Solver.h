@@ -0,0 +1,42 @@
+#ifndef CORRIDOR_SOLVER_H
+#define CORRIDOR_SOLVER_H
+
+#include "Solver.h"
+#include "CorridorGraph.h"
+#include <memory>
+#include <vector>
+#include <utility>
+#include <SFML/System/Clock.hpp>
+
+// BFS, Dijkstra or A* over the maze's CorridorGraph instead of its cells.
+// Each step() settles one junction or dead end; whole corridors are crossed
+// in one relaxation. Path length and the 'X' path are in grid cells, exactly
+// as the cell-by-cell solvers report them; nodes explored counts graph nodes.
+class Corridor_Solver : public Solver {
+public:
+    // Uses a prebuilt graph of this maze (not owned)
+    Corridor_Solver(const Maze& maze, const CorridorGraph& graph,
+                    CorridorGraph::Algorithm algorithm = CorridorGraph::Algorithm::Dijkstra);
+
+    // Builds its own graph first (not counted in the search time)
+    explicit Corridor_Solver(const Maze& maze,
+                             CorridorGraph::Algorithm algorithm = CorridorGraph::Algorithm::Dijkstra);
+
+    void step() override;
+
+    // Performance HUD readings (see Solver.h)
+    std::size_t getOpenSetSize() const override { return m_search.getQueueSize(); }
+    std::size_t getMemoryBytes() const override;
+
+private:
+    std::unique_ptr<CorridorGraph> m_ownGraph;
+    const CorridorGraph& m_graph;
+    CorridorGraph::Search m_search;
+    std::vector<std::pair<int, int>> m_path;
+    std::size_t m_traceIndex = 0;
+
+    // Clock for timing the algorithm
+    sf::Clock m_clock;
+};
+
+#endif // CORRIDOR_SOLVER_H
@@ -0,0 +1,24 @@
+#include "CostGrid.h"
+#include "Trace.h"
+#include <algorithm>
+#include <random>
+
+using namespace std;
+
+CostGrid::CostGrid(const Maze& maze, unsigned seed, int maxCost)
+    : m_rows(maze.getRows()),
+      m_cols(maze.getCols()),
+      m_maxCost(max(1, min(MAX_COST, maxCost)))
+{
+    TRACE_SCOPE("CostGrid::generate");
+    mt19937 rng(seed);
+    uniform_int_distribution<int> cost(1, m_maxCost);
+    m_cost.resize((size_t)m_rows * m_cols);
+    for (uint8_t& c : m_cost) c = (uint8_t)cost(rng);
+}
+
+long long CostGrid::pathCost(const vector<pair<int, int>>& path) const {
+    long long total = 0;
+    for (size_t i = 1; i < path.size(); ++i) total += at(path[i].first, path[i].second);
+    return total;
+}
@@ -0,0 +1,37 @@
+#ifndef COST_GRID_H
+#define COST_GRID_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include "Maze.h"
+
+// Cost of stepping onto each cell, for weighted searches. Without one every
+// move costs 1; Dijkstra_Solver and DeltaStepping_Solver can take a CostGrid
+// instead. Costs are drawn uniformly from 1..maxCost with their own seed, so
+// the same maze can be paired with different terrains.
+class CostGrid {
+public:
+    static constexpr int MAX_COST = 255;
+
+    CostGrid() = default;
+    CostGrid(const Maze& maze, unsigned seed, int maxCost = 9);
+
+    int at(int r, int c) const { return m_cost[(std::size_t)r * m_cols + c]; }
+    const std::uint8_t* data() const { return m_cost.data(); } // Row-major, r * cols + c
+
+    int getRows() const { return m_rows; }
+    int getCols() const { return m_cols; }
+    int getMaxCost() const { return m_maxCost; }
+
+    // Cost of walking a path: every cell after the first
+    long long pathCost(const std::vector<std::pair<int, int>>& path) const;
+
+private:
+    int m_rows = 0, m_cols = 0;
+    int m_maxCost = 1;
+    std::vector<std::uint8_t> m_cost;
+};
+
+#endif // COST_GRID_H
@@ -1,5 +1,6 @@
 #include "DFS_Solver.h"
 #include <iostream>
+#include "Checkpoint.h"
 
 DFS_Solver::DFS_Solver(const Maze& maze)
     : Solver(maze, 'D')
@@ -29,6 +30,7 @@ void DFS_Solver::step() {
         // Use 'X' for the final path
         if (grid[tracePos.first][tracePos.second] != 'E') {// grid is a 2D vector<char> representing the maze layout
             grid[tracePos.first][tracePos.second] = 'X';
+            logEvent(EventLog::Type::Path, tracePos.first, tracePos.second);
         }
         tracePos = parent[tracePos.first][tracePos.second];
         return;
@@ -51,6 +53,7 @@ void DFS_Solver::step() {
         
         visited[r][c] = true;
         if (grid[r][c] == ' ') grid[r][c] = symbol;
+        logEvent(EventLog::Type::Expanded, r, c);
 
         // If we've reached the goal cell, switch to TRACING
         if (std::make_pair(r,c) == goal) {
@@ -59,7 +62,7 @@ void DFS_Solver::step() {
             tracePos = goal; // Start tracing from the goal
             
             // Stop the clock on success
-            m_timeTaken = m_clock.getElapsedTime();
+            m_timeTaken = m_resumedTime + m_clock.getElapsedTime();
             
             return; // Exit step
         }
@@ -74,6 +77,7 @@ void DFS_Solver::step() {
             
             parent[nr][nc] = {r, c};
             stk.push({nr, nc});
+            logEvent(EventLog::Type::Enqueued, nr, nc);
         }
 
         // We processed one valid, unvisited node. Exit step for visualization.
@@ -86,6 +90,30 @@ void DFS_Solver::step() {
         found = false;
         
         // Stop the clock if the search fails
-        m_timeTaken = m_clock.getElapsedTime();
+        m_timeTaken = m_resumedTime + m_clock.getElapsedTime();
     }
+}
+
+bool DFS_Solver::saveState(CheckpointWriter& w) const {
+    saveBaseState(w, m_clock);
+    w.cells(underlying(stk));
+    w.bits(visited);
+    return w.ok();
+}
+
+bool DFS_Solver::loadState(CheckpointReader& r) {
+    if (!loadBaseState(r)) return false;
+
+    std::vector<std::pair<int,int>> cells;
+    r.cells(cells);
+    r.bits(visited);
+    underlying(stk).assign(cells.begin(), cells.end());
+
+    // The search clock continues from the saved time
+    m_clock.restart();
+    return r.ok();
+}
+
+size_t DFS_Solver::getMemoryBytes() const {
+    return Solver::getMemoryBytes() + stk.size() * sizeof(pair<int,int>) + bitMatrixBytes(visited);
 }
\ No newline at end of file
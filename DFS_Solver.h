@@ -15,6 +15,14 @@ public:
     DFS_Solver(const Maze& maze);
     void step() override;     // perform exactly 1 DFS action
 
+    // Performance HUD readings (see Solver.h)
+    std::size_t getOpenSetSize() const override { return stk.size(); }
+    std::size_t getMemoryBytes() const override;
+
+    // Checkpointing (see Checkpoint.h)
+    bool saveState(CheckpointWriter& w) const override;
+    bool loadState(CheckpointReader& r) override;
+
 private:
     stack<pair<int,int>> stk;      // DFS stack
     vector<vector<bool>> visited;
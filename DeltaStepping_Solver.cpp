@@ -0,0 +1,214 @@
+#include "DeltaStepping_Solver.h"
+#include <algorithm>
+
+using namespace std;
+
+DeltaStepping_Solver::DeltaStepping_Solver(const Maze& maze, const CostGrid* costs, int delta, unsigned threads)
+    : Solver(maze, 'W'),
+      R(maze.getRows()),
+      C(maze.getCols()),
+      m_delta(delta > 0 ? delta : 2 * (costs ? costs->getMaxCost() : 1)),
+      m_pool(threads),
+      m_costs(costs ? costs->data() : nullptr)
+{
+    size_t cells = (size_t)R * C;
+
+    // Flat wall map so worker threads never read 'grid' while it is coloured
+    m_open.assign(cells, 0);
+    for (int r = 0; r < R; ++r) {
+        for (int c = 0; c < C; ++c) {
+            m_open[(size_t)r * C + c] = grid[r][c] != '#';
+        }
+    }
+
+    m_state.reset(new atomic<uint64_t>[cells]);
+    m_lightDone.reset(new atomic<uint32_t>[cells]);
+    m_settled.reset(new atomic<uint8_t>[cells]);
+    for (size_t i = 0; i < cells; ++i) {
+        m_state[i].store(pack(INF, NO_PARENT), memory_order_relaxed);
+        m_lightDone[i].store(INF, memory_order_relaxed);
+        m_settled[i].store(0, memory_order_relaxed);
+    }
+
+    int maxCost = costs ? costs->getMaxCost() : 1;
+    m_slots = maxCost / m_delta + 2;
+    m_workers = vector<Worker>(m_pool.size());
+    for (Worker& w : m_workers) w.buckets.resize(m_slots);
+
+    int s = start.first * C + start.second;
+    m_state[s].store(pack(0, NO_PARENT), memory_order_relaxed);
+    m_workers[0].buckets[0].push_back(s);
+
+    // Start the algorithm's timer
+    m_clock.restart();
+}
+
+void DeltaStepping_Solver::relax(unsigned thread, int v, uint32_t d, int u) {
+    uint64_t current = m_state[v].load(memory_order_relaxed);
+    while ((uint32_t)(current >> 32) > d) {
+        // On failure 'current' is reloaded; stop once someone else got lower
+        if (m_state[v].compare_exchange_weak(current, pack(d, (uint32_t)u), memory_order_relaxed)) {
+            Worker& w = m_workers[thread];
+            w.buckets[(d / m_delta) % m_slots].push_back(v);
+            w.relaxations++;
+            return;
+        }
+    }
+}
+
+void DeltaStepping_Solver::relaxMoves(unsigned thread, int u, bool heavy) {
+    uint32_t d = dist(u);
+    int r = u / C, c = u % C;
+    for (auto [dr, dc] : directions) {
+        int nr = r + dr, nc = c + dc;
+        if (nr < 0 || nc < 0 || nr >= R || nc >= C) continue;
+        int v = nr * C + nc;
+        if (!m_open[v]) continue;
+
+        int w = m_costs ? m_costs[v] : 1;
+        if ((w > m_delta) != heavy) continue;
+        relax(thread, v, d + (uint32_t)w, u);
+    }
+}
+
+bool DeltaStepping_Solver::anyQueued() const {
+    for (const Worker& w : m_workers) {
+        for (const vector<int>& bucket : w.buckets) {
+            if (!bucket.empty()) return true;
+        }
+    }
+    return false;
+}
+
+long long DeltaStepping_Solver::getDistance(int r, int c) const {
+    uint32_t d = dist(r * C + c);
+    return d == INF ? -1 : (long long)d;
+}
+
+long long DeltaStepping_Solver::getRelaxations() const {
+    long long total = 0;
+    for (const Worker& w : m_workers) total += w.relaxations;
+    return total;
+}
+
+void DeltaStepping_Solver::finish(bool reached) {
+    m_timeTaken = m_resumedTime + m_clock.getElapsedTime();
+    found = reached;
+    if (!reached) {
+        currentState = State::DONE;
+        return;
+    }
+
+    // Copy the goal's parent chain into the shared parent map for tracing
+    int g = goal.first * C + goal.second;
+    for (int v = g; v != start.first * C + start.second;) {
+        int u = (int)(uint32_t)m_state[v].load(memory_order_relaxed);
+        parent[v / C][v % C] = {u / C, u % C};
+        v = u;
+    }
+    currentState = State::TRACING_PATH;
+    tracePos = goal;
+}
+
+void DeltaStepping_Solver::step() {
+    if (currentState == State::TRACING_PATH) {
+
+        // Count this node as part of the final path
+        m_pathLength++;
+
+        if (tracePos == start) {
+            currentState = State::DONE;
+            return;
+        }
+        if (grid[tracePos.first][tracePos.second] != 'E') {
+            grid[tracePos.first][tracePos.second] = 'X';
+            logEvent(EventLog::Type::Path, tracePos.first, tracePos.second);
+        }
+        tracePos = parent[tracePos.first][tracePos.second];
+        return;
+    }
+
+    if (currentState != State::SEARCHING) return;
+
+    // Skip to the next bucket holding anything
+    if (!anyQueued()) {
+        finish(false);
+        return;
+    }
+    int slot = (int)(m_bucket % m_slots);
+    while (all_of(m_workers.begin(), m_workers.end(), [&](const Worker& w) { return w.buckets[slot].empty(); })) {
+        m_bucket++;
+        slot = (int)(m_bucket % m_slots);
+    }
+
+    // Light rounds until the bucket stays empty
+    while (true) {
+        m_round.clear();
+        for (Worker& w : m_workers) {
+            m_round.insert(m_round.end(), w.buckets[slot].begin(), w.buckets[slot].end());
+            w.buckets[slot].clear();
+        }
+        if (m_round.empty()) break;
+        m_lightRounds++;
+
+        m_pool.parallelFor(m_round.size(), [&](unsigned t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                int u = m_round[i];
+                uint32_t d = dist(u);
+                // Stale copy: the cell was queued again at a lower distance
+                if (d / m_delta != m_bucket) continue;
+                // Light moves from each distance are relaxed once, even if u was queued twice
+                if (m_lightDone[u].exchange(d, memory_order_relaxed) == d) continue;
+                if (!m_settled[u].exchange(1, memory_order_relaxed)) m_workers[t].settled.push_back(u);
+                relaxMoves(t, u, false);
+            }
+        });
+    }
+
+    // Every cell of this bucket is final now
+    m_round.clear();
+    for (Worker& w : m_workers) {
+        m_round.insert(m_round.end(), w.settled.begin(), w.settled.end());
+        w.settled.clear();
+    }
+    m_bucketsSettled++;
+    m_nodesExplored += (int)m_round.size();
+
+    // Colours and events on the calling thread only
+    for (int u : m_round) {
+        int r = u / C, c = u % C;
+        if (grid[r][c] == ' ') grid[r][c] = symbol;
+        logEvent(EventLog::Type::Expanded, r, c);
+    }
+
+    // Heavy moves only reach later buckets, so the goal is final if it is in this one
+    uint32_t goalDist = dist(goal.first * C + goal.second);
+    if (goalDist != INF && goalDist / m_delta == m_bucket) {
+        finish(true);
+        return;
+    }
+
+    m_pool.parallelFor(m_round.size(), [&](unsigned t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) relaxMoves(t, m_round[i], true);
+    });
+    m_bucket++;
+}
+
+size_t DeltaStepping_Solver::getOpenSetSize() const {
+    size_t queued = 0;
+    for (const Worker& w : m_workers) {
+        for (const vector<int>& bucket : w.buckets) queued += bucket.size();
+    }
+    return queued;
+}
+
+size_t DeltaStepping_Solver::getMemoryBytes() const {
+    size_t cells = (size_t)R * C;
+    size_t bytes = Solver::getMemoryBytes() + m_open.capacity() +
+                   cells * (sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint8_t)) + m_round.capacity() * sizeof(int);
+    for (const Worker& w : m_workers) {
+        for (const vector<int>& bucket : w.buckets) bytes += bucket.capacity() * sizeof(int);
+        bytes += w.settled.capacity() * sizeof(int);
+    }
+    return bytes;
+}
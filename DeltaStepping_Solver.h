@@ -0,0 +1,92 @@
+#ifndef DELTA_STEPPING_SOLVER_H
+#define DELTA_STEPPING_SOLVER_H
+
+#include "Solver.h"
+#include "Utils.h"
+#include "ThreadPool.h"
+#include "CostGrid.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <SFML/System/Clock.hpp>
+
+// Parallel delta-stepping (Meyer & Sanders) for weighted grids.
+// Cells wait in buckets of width delta by tentative distance. Each step()
+// settles one bucket across the thread pool:
+//  - light moves (onto cells costing <= delta) are relaxed in rounds until
+//    the bucket stays empty, since they can refill the same bucket
+//  - heavy moves are relaxed once afterwards, from every cell the bucket settled
+// A cell's distance and parent share one 64-bit atomic updated by
+// compare-and-swap, so racing relaxations keep the smallest distance together
+// with the parent that produced it.
+// Distances are identical to Dijkstra_Solver with the same CostGrid.
+class DeltaStepping_Solver : public Solver {
+public:
+    // costs == nullptr means every move costs 1; delta == 0 picks twice the
+    // largest cost (fastest in the "delta" command); threads == 0 means one per core
+    explicit DeltaStepping_Solver(const Maze& maze, const CostGrid* costs = nullptr,
+                                  int delta = 0, unsigned threads = 0);
+
+    void step() override;
+
+    // Performance HUD readings (see Solver.h)
+    std::size_t getOpenSetSize() const override;
+    std::size_t getMemoryBytes() const override;
+
+    // Final distance to a cell once its bucket is settled; -1 if not reached
+    long long getDistance(int r, int c) const;
+    long long getGoalDistance() const { return getDistance(goal.first, goal.second); }
+
+    int getDelta() const { return m_delta; }
+    unsigned getThreadCount() const { return m_pool.size(); }
+    long long getBuckets() const { return m_bucketsSettled; }
+    long long getLightRounds() const { return m_lightRounds; }
+    long long getRelaxations() const;
+
+private:
+    static constexpr std::uint32_t INF = 0xFFFFFFFFu;
+    static constexpr std::uint32_t NO_PARENT = 0xFFFFFFFFu;
+
+    static std::uint64_t pack(std::uint32_t dist, std::uint32_t parentId) {
+        return (std::uint64_t)dist << 32 | parentId;
+    }
+    std::uint32_t dist(int id) const { return (std::uint32_t)(m_state[id].load(std::memory_order_relaxed) >> 32); }
+
+    // Lowers v's distance to d via u if that is an improvement, and queues v
+    void relax(unsigned thread, int v, std::uint32_t d, int u);
+    // Relaxes u's light (heavy == false) or heavy moves
+    void relaxMoves(unsigned thread, int u, bool heavy);
+    bool anyQueued() const;
+    void finish(bool reached);
+
+    int R, C;
+    int m_delta;
+    ThreadPool m_pool;
+    const std::uint8_t* m_costs; // Not owned; nullptr = unit costs
+
+    std::vector<std::uint8_t> m_open; // Read-only wall map (1 = walkable)
+    std::unique_ptr<std::atomic<std::uint64_t>[]> m_state;     // dist << 32 | parent id
+    std::unique_ptr<std::atomic<std::uint32_t>[]> m_lightDone; // Distance u's light moves were relaxed at
+    std::unique_ptr<std::atomic<std::uint8_t>[]> m_settled;
+
+    // Per-thread circular buckets; bucket b lives in slot b % m_slots. Moves
+    // cost at most maxCost, so queued cells never span more than m_slots buckets.
+    struct alignas(64) Worker {
+        std::vector<std::vector<int>> buckets;
+        std::vector<int> settled; // Cells of the current bucket, for the heavy pass
+        long long relaxations = 0;
+    };
+    std::vector<Worker> m_workers;
+    int m_slots;
+    long long m_bucket = 0; // Current bucket index
+    std::vector<int> m_round;
+
+    long long m_bucketsSettled = 0;
+    long long m_lightRounds = 0;
+
+    // Clock for timing the algorithm
+    sf::Clock m_clock;
+};
+
+#endif // DELTA_STEPPING_SOLVER_H
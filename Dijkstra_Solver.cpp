@@ -1,8 +1,11 @@
 #include "Dijkstra_Solver.h"
 #include <limits>
+#include "Checkpoint.h"
 
-Dijkstra_Solver::Dijkstra_Solver(const Maze& maze)
-    : Solver(maze, 'K')
+Dijkstra_Solver::Dijkstra_Solver(const Maze& maze, const RectangleSymmetry* symmetry, const CostGrid* costs)
+    : Solver(maze, 'K'),
+      m_symmetry(costs ? nullptr : symmetry),
+      m_costs(costs)
 {
     int R = maze.getRows();
     int C = maze.getCols();
@@ -29,6 +32,7 @@ void Dijkstra_Solver::step() {
         }
         if (grid[tracePos.first][tracePos.second] != 'E') {
             grid[tracePos.first][tracePos.second] = 'X';
+            logEvent(EventLog::Type::Path, tracePos.first, tracePos.second);
         }
         tracePos = parent[tracePos.first][tracePos.second];
         return;
@@ -36,12 +40,17 @@ void Dijkstra_Solver::step() {
 
     if (currentState != State::SEARCHING) return;
     
+    // Out of cells: done, unless some of several goals were reached
     if (pq.empty()) {
-        currentState = State::DONE;
-        found = false;
+        if (anyGoalReached()) {
+            if (m_symmetry) unfoldJumps();
+        } else {
+            currentState = State::DONE;
+            found = false;
+        }
         
         // Stop the clock if the search fails
-        m_timeTaken = m_clock.getElapsedTime();
+        m_timeTaken = m_resumedTime + m_clock.getElapsedTime();
         
         return;
     }
@@ -63,14 +72,14 @@ void Dijkstra_Solver::step() {
 
         if (grid[r][c] == ' ')
             grid[r][c] = symbol;
+        logEvent(EventLog::Type::Expanded, r, c);
 
-        if (r == goal.first && c == goal.second) {
-            found = true;
-            currentState = State::TRACING_PATH;
-            tracePos = goal;
+        // Goals come out of the queue nearest first
+        if (isGoal(r, c) && goalReached(r, c)) {
+            if (m_symmetry) unfoldJumps();
             
             // Stop the clock on success
-            m_timeTaken = m_clock.getElapsedTime();
+            m_timeTaken = m_resumedTime + m_clock.getElapsedTime();
             
             return; // Exit step
         }
@@ -80,11 +89,16 @@ void Dijkstra_Solver::step() {
             if (!isInside(grid, nr, nc)) continue;
             if (grid[nr][nc] == '#') continue;
 
-            int newCost = distMap[r][c] + 1;
+            // Straight across an empty rectangle instead of into it
+            int cost = m_costs ? m_costs->at(nr, nc) : 1;
+            if (m_symmetry) m_symmetry->jump(r, c, nr, nc, cost);
+
+            int newCost = distMap[r][c] + cost;
             if (newCost < distMap[nr][nc]) {
                 distMap[nr][nc] = newCost;
                 parent[nr][nc] = {r, c};
                 pq.push({newCost, {nr, nc}});
+                logEvent(EventLog::Type::Enqueued, nr, nc);
             }
         }
         // We processed one valid, unvisited node. Exit step for visualization.
@@ -97,6 +111,44 @@ void Dijkstra_Solver::step() {
     
     // Make sure clock is stopped even if it fails in a weird way
     if (m_timeTaken == sf::Time::Zero) {
-        m_timeTaken = m_clock.getElapsedTime();
+        m_timeTaken = m_resumedTime + m_clock.getElapsedTime();
+    }
+}
+
+bool Dijkstra_Solver::saveState(CheckpointWriter& w) const {
+    if (m_severalGoals) return false;
+    saveBaseState(w, m_clock);
+
+    // Heap array as (score, r, c) triples, in its internal order
+    std::vector<int32_t> heap;
+    for (const Node& n : underlying(pq)) {
+        heap.insert(heap.end(), {n.dist, n.pos.first, n.pos.second});
+    }
+    w.array(heap);
+    w.matrix(distMap);
+    w.bits(visited);
+    return w.ok();
+}
+
+bool Dijkstra_Solver::loadState(CheckpointReader& r) {
+    if (!loadBaseState(r)) return false;
+
+    std::vector<int32_t> heap;
+    r.array(heap);
+    r.matrix(distMap);
+    r.bits(visited);
+    auto& nodes = underlying(pq);
+    nodes.clear();
+    for (size_t i = 0; i + 2 < heap.size(); i += 3) {
+        nodes.push_back({heap[i], {heap[i + 1], heap[i + 2]}});
     }
-}
\ No newline at end of file
+
+    // The search clock continues from the saved time
+    m_clock.restart();
+    return r.ok();
+}
+
+std::size_t Dijkstra_Solver::getMemoryBytes() const {
+    std::size_t distBytes = distMap.size() * (sizeof(std::vector<int>) + (distMap.empty() ? 0 : distMap[0].capacity() * sizeof(int)));
+    return Solver::getMemoryBytes() + underlying(pq).capacity() * sizeof(Node) + distBytes + bitMatrixBytes(visited);
+}
@@ -3,16 +3,34 @@
 
 #include "Solver.h"
 #include "Utils.h"
+#include "MazePruning.h"
+#include "CostGrid.h"
 #include <queue>
 #include <vector>
 #include <SFML/System/Clock.hpp> 
 
 class Dijkstra_Solver : public Solver {
 public:
-    explicit Dijkstra_Solver(const Maze& maze);
+    // symmetry (optional) skips the interiors of empty rectangles;
+    // costs (optional) weights each move by the cell it enters. Jumps assume
+    // unit costs, so symmetry is ignored when costs are given.
+    explicit Dijkstra_Solver(const Maze& maze, const RectangleSymmetry* symmetry = nullptr,
+                             const CostGrid* costs = nullptr);
 
     void step() override;
 
+    // Performance HUD readings (see Solver.h)
+    std::size_t getOpenSetSize() const override { return pq.size(); }
+    std::size_t getMemoryBytes() const override;
+
+    // Best known distance to a cell (final once the cell is expanded);
+    // INT_MAX if it has not been reached
+    int getDistance(int r, int c) const { return distMap[r][c]; }
+
+    // Checkpointing (see Checkpoint.h)
+    bool saveState(CheckpointWriter& w) const override;
+    bool loadState(CheckpointReader& r) override;
+
 private:
     struct Node {
         int dist;
@@ -25,6 +43,8 @@ private:
     std::priority_queue<Node, std::vector<Node>, std::greater<Node>> pq;
     std::vector<std::vector<int>> distMap;
     std::vector<std::vector<bool>> visited;
+    const RectangleSymmetry* m_symmetry; // Not owned
+    const CostGrid* m_costs;             // Not owned
     
     // Clock for timing the algorithm
     sf::Clock m_clock;
@@ -0,0 +1,175 @@
+#include "EventLog.h"
+#include "Maze.h"
+#include <fstream>
+#include <cstring>
+
+using namespace std;
+
+static const char EVENT_MAGIC[8] = {'M', 'Z', 'E', 'V', 'L', 'O', 'G', '1'};
+
+EventLog::EventLog(int rows, int cols, const string& algorithm, size_t maxBytes)
+    : rows(rows), cols(cols), algorithm(algorithm), m_maxBytes(maxBytes)
+{
+    chunks.push_back({0, 0, {}});
+}
+
+void EventLog::setMaze(const Maze& maze) {
+    wallBits.assign(((size_t)rows * cols + 7) / 8, 0);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            if (maze.grid[r][c] != '#') continue;
+            size_t id = (size_t)r * cols + c;
+            wallBits[id / 8] |= uint8_t(1u << (id % 8));
+        }
+    }
+    mazeStart = maze.getStart();
+    mazeGoal = maze.getGoal();
+}
+
+vector<string> EventLog::baseGrid() const {
+    vector<string> g(rows, string(cols, ' '));
+    if (wallBits.empty()) return g;
+
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            size_t id = (size_t)r * cols + c;
+            if ((wallBits[id / 8] >> (id % 8)) & 1) g[r][c] = '#';
+        }
+    }
+    g[mazeStart.first][mazeStart.second] = 'S';
+    g[mazeGoal.first][mazeGoal.second] = 'E';
+    return g;
+}
+
+void EventLog::putVarint(uint64_t v) {
+    vector<uint8_t>& out = chunks.back().bytes;
+    while (v >= 0x80) {
+        out.push_back((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((uint8_t)v);
+}
+
+void EventLog::add(Type type, uint32_t cell) {
+    size_t before = chunks.back().bytes.size();
+
+    // Zigzag so small negative deltas stay small too
+    int64_t delta = (int64_t)cell - (int64_t)m_prevCell;
+    uint64_t zigzag = ((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63);
+    putVarint(zigzag << 2 | (uint64_t)type);
+
+    m_prevCell = cell;
+    m_events++;
+    chunks.back().events++;
+    m_bytes += chunks.back().bytes.size() - before;
+}
+
+void EventLog::endStep() {
+    chunks.back().bytes.push_back((uint8_t)Type::StepEnd);
+    m_bytes++;
+    m_steps++;
+
+    if (m_steps % STEPS_PER_CHUNK != 0) return;
+
+    // Start a new chunk; its deltas restart from cell 0
+    chunks.back().bytes.shrink_to_fit();
+    chunks.push_back({m_steps, 0, {}});
+    m_prevCell = 0;
+
+    // Ring mode: forget the oldest chunks, never the one being written
+    while (m_maxBytes > 0 && m_bytes > m_maxBytes && chunks.size() > 1) {
+        m_bytes -= chunks.front().bytes.size();
+        m_events -= chunks.front().events;
+        chunks.pop_front();
+    }
+}
+
+bool EventLog::save(const string& path) const {
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out) return false;
+
+    int32_t header[8] = {rows, cols, (int32_t)algorithm.size(), (int32_t)chunks.size(),
+                         mazeStart.first, mazeStart.second, mazeGoal.first, mazeGoal.second};
+    int64_t counts[3] = {m_steps, m_events, (int64_t)wallBits.size()};
+    out.write(EVENT_MAGIC, sizeof(EVENT_MAGIC));
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+    out.write(algorithm.data(), algorithm.size());
+    out.write(reinterpret_cast<const char*>(wallBits.data()), wallBits.size());
+    for (const Chunk& c : chunks) {
+        int64_t meta[3] = {c.firstStep, c.events, (int64_t)c.bytes.size()};
+        out.write(reinterpret_cast<const char*>(meta), sizeof(meta));
+        out.write(reinterpret_cast<const char*>(c.bytes.data()), c.bytes.size());
+    }
+    return (bool)out;
+}
+
+bool EventLog::load(const string& path) {
+    ifstream in(path, ios::binary);
+    if (!in) return false;
+
+    char magic[8];
+    int32_t header[8];
+    int64_t counts[3];
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    in.read(reinterpret_cast<char*>(counts), sizeof(counts));
+    if (!in || memcmp(magic, EVENT_MAGIC, sizeof(magic)) != 0) return false;
+
+    EventLog log(header[0], header[1], string((size_t)header[2], '\0'));
+    in.read(&log.algorithm[0], log.algorithm.size());
+    log.mazeStart = {header[4], header[5]};
+    log.mazeGoal = {header[6], header[7]};
+    log.wallBits.resize((size_t)counts[2]);
+    in.read(reinterpret_cast<char*>(log.wallBits.data()), log.wallBits.size());
+    log.chunks.clear();
+    for (int i = 0; i < header[3]; ++i) {
+        int64_t meta[3];
+        in.read(reinterpret_cast<char*>(meta), sizeof(meta));
+        Chunk c{(long)meta[0], meta[1], vector<uint8_t>((size_t)meta[2])};
+        in.read(reinterpret_cast<char*>(c.bytes.data()), c.bytes.size());
+        log.m_bytes += c.bytes.size();
+        log.chunks.push_back(move(c));
+    }
+    if (!in || log.chunks.empty()) return false;
+
+    log.m_steps = (long)counts[0];
+    log.m_events = counts[1];
+    *this = move(log);
+    return true;
+}
+
+void EventLog::Cursor::reset() {
+    chunk = 0;
+    pos = 0;
+    prev = 0;
+    m_step = log.getFirstStep();
+}
+
+bool EventLog::Cursor::next(Event& e) {
+    while (chunk < log.chunks.size() && pos == log.chunks[chunk].bytes.size()) {
+        chunk++;
+        pos = 0;
+        prev = 0; // Every chunk restarts the delta
+    }
+    if (chunk == log.chunks.size()) return false;
+
+    const vector<uint8_t>& bytes = log.chunks[chunk].bytes;
+    uint64_t v = 0;
+    int shift = 0;
+    uint8_t b;
+    do {
+        b = bytes[pos++];
+        v |= (uint64_t)(b & 0x7F) << shift;
+        shift += 7;
+    } while (b & 0x80);
+
+    e.type = (Type)(v & 3);
+    if (e.type == Type::StepEnd) return true;
+
+    uint64_t zigzag = v >> 2;
+    int64_t delta = (int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1);
+    prev = (uint32_t)((int64_t)prev + delta);
+    e.cell = prev;
+    return true;
+}
@@ -0,0 +1,116 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <cstdint>
+#include <utility>
+
+class Maze;
+
+// Compact record of everything a solver did, for replay without re-running it.
+// Each event is (cell, type), encoded as a LEB128 varint of
+//     zigzag(cell - previous cell) << 2 | type
+// so a run of neighbouring cells costs about one byte per event. A step marker
+// (one byte) closes every step() call, which is what replay seeks by.
+// Events are grouped in chunks of STEPS_PER_CHUNK steps; each chunk restarts
+// the delta, so a bounded log can drop whole chunks from the front (ring mode).
+class EventLog {
+public:
+    enum class Type : std::uint8_t {
+        Expanded = 0,   // Popped and processed
+        Enqueued = 1,   // Pushed onto the open set / queue / stack
+        Path     = 2,   // Marked as part of the final path
+        StepEnd  = 3    // End of one step() call (no cell)
+    };
+
+    struct Event {
+        Type type;
+        std::uint32_t cell; // r * cols + c
+    };
+
+    static constexpr long STEPS_PER_CHUNK = 256;
+
+    // maxBytes == 0 keeps everything; otherwise the oldest chunks are dropped
+    EventLog(int rows = 0, int cols = 0, const std::string& algorithm = "", std::size_t maxBytes = 0);
+
+    // Keeps the walls, S and E (packed) so a saved log can be replayed alone
+    void setMaze(const Maze& maze);
+    std::vector<std::string> baseGrid() const;
+
+    void add(Type type, std::uint32_t cell);
+    void endStep();
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    const std::string& getAlgorithm() const { return algorithm; }
+    long getFirstStep() const { return chunks.empty() ? m_steps : chunks.front().firstStep; }
+    long getStepCount() const { return m_steps; }
+    // Events still held (all of them unless ring mode dropped chunks)
+    long long getEventCount() const { return m_events; }
+    std::size_t getSizeBytes() const { return m_bytes; }
+
+    // Decodes the log in order; used for replay and seeking
+    class Cursor {
+    public:
+        explicit Cursor(const EventLog& log) : log(log) { reset(); }
+
+        // Back to the first retained step
+        void reset();
+        // Steps fully applied so far
+        long step() const { return m_step; }
+
+        // Calls fn(event) for every cell event until 'target' steps are done
+        // (or the log ends); returns the number of events applied
+        template <typename F>
+        long long advanceTo(long target, F&& fn) {
+            long long applied = 0;
+            Event e;
+            while (m_step < target && next(e)) {
+                if (e.type == Type::StepEnd) {
+                    m_step++;
+                } else {
+                    fn(e);
+                    applied++;
+                }
+            }
+            return applied;
+        }
+
+    private:
+        bool next(Event& e);
+
+        const EventLog& log;
+        std::size_t chunk = 0, pos = 0;
+        std::uint32_t prev = 0;
+        long m_step = 0;
+    };
+
+private:
+    struct Chunk {
+        long firstStep;
+        long long events;
+        std::vector<std::uint8_t> bytes;
+    };
+
+    void putVarint(std::uint64_t v);
+
+    int rows, cols;
+    std::string algorithm;
+    std::size_t m_maxBytes;
+
+    std::vector<std::uint8_t> wallBits; // 1 bit per cell, empty if no maze was set
+    std::pair<int, int> mazeStart{-1, -1}, mazeGoal{-1, -1};
+
+    std::deque<Chunk> chunks;
+    std::uint32_t m_prevCell = 0;
+    long m_steps = 0;
+    long long m_events = 0;
+    std::size_t m_bytes = 0;
+};
+
+#endif // EVENT_LOG_H
@@ -0,0 +1,296 @@
+#include "ExternalBFS.h"
+#include "Utils.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <SFML/System/Clock.hpp>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+namespace {
+
+const size_t IO_BUFFER = 1 << 16; // Entries per buffered read/write
+
+// Sequential reader of a file of uint64 values
+class Reader {
+public:
+    Reader(const string& path, uint64_t& bytesRead)
+        : in(path, ios::binary), bytesRead(bytesRead), buf(IO_BUFFER) { refill(); }
+
+    bool done() const { return pos == len; }
+    uint64_t peek() const { return buf[pos]; }
+    uint64_t next() {
+        uint64_t v = buf[pos++];
+        if (pos == len) refill();
+        return v;
+    }
+
+private:
+    void refill() {
+        pos = 0;
+        len = 0;
+        if (!in) return;
+        in.read(reinterpret_cast<char*>(buf.data()), buf.size() * sizeof(uint64_t));
+        len = (size_t)in.gcount() / sizeof(uint64_t);
+        bytesRead += len * sizeof(uint64_t);
+    }
+
+    ifstream in;
+    uint64_t& bytesRead;
+    vector<uint64_t> buf;
+    size_t pos = 0, len = 0;
+};
+
+// Sequential writer of uint64 values
+class Writer {
+public:
+    Writer(const string& path, uint64_t& bytesWritten)
+        : out(path, ios::binary | ios::trunc), bytesWritten(bytesWritten)
+    {
+        if (!out) throw runtime_error("ExternalBFS: cannot create " + path);
+        buf.reserve(IO_BUFFER);
+    }
+    ~Writer() { flush(); }
+
+    void put(uint64_t v) {
+        buf.push_back(v);
+        if (buf.size() == IO_BUFFER) flush();
+    }
+
+    void flush() {
+        out.write(reinterpret_cast<const char*>(buf.data()), buf.size() * sizeof(uint64_t));
+        bytesWritten += buf.size() * sizeof(uint64_t);
+        buf.clear();
+    }
+
+private:
+    ofstream out;
+    uint64_t& bytesWritten;
+    vector<uint64_t> buf;
+};
+
+// Packs 2-bit parent directions, four per byte, in layer order
+class DirWriter {
+public:
+    DirWriter(const string& path, uint64_t& bytesWritten)
+        : out(path, ios::binary | ios::trunc), bytesWritten(bytesWritten) {}
+    ~DirWriter() {
+        if (count % 4) buf.push_back(cur);
+        flush();
+    }
+
+    void put(unsigned dir) {
+        cur |= uint8_t(dir << ((count % 4) * 2));
+        if (++count % 4 == 0) {
+            buf.push_back(cur);
+            cur = 0;
+            if (buf.size() == IO_BUFFER) flush();
+        }
+    }
+
+private:
+    void flush() {
+        out.write(reinterpret_cast<const char*>(buf.data()), buf.size());
+        bytesWritten += buf.size();
+        buf.clear();
+    }
+
+    ofstream out;
+    uint64_t& bytesWritten;
+    vector<uint8_t> buf;
+    uint8_t cur = 0;
+    uint64_t count = 0;
+};
+
+// Index of the direction opposite to directions[d]
+unsigned opposite(unsigned d) { return (d + 2) % 4; }
+
+} // namespace
+
+ExternalBFS::ExternalBFS(TiledMaze& maze, const string& workDir, size_t memoryEntries)
+    : maze(maze), dir(workDir), m_memoryEntries(max<size_t>(1024, memoryEntries))
+{
+    fs::create_directories(dir);
+}
+
+ExternalBFS::~ExternalBFS() {
+    // Layer and direction files are only needed until the path is traced
+    error_code ec;
+    for (long long l = 0; l <= m_lastLevel; ++l) {
+        fs::remove(layerPath(l), ec);
+        fs::remove(dirsPath(l), ec);
+    }
+}
+
+string ExternalBFS::layerPath(long long level) const {
+    return (fs::path(dir) / ("layer_" + to_string(level) + ".bin")).string();
+}
+
+string ExternalBFS::dirsPath(long long level) const {
+    return (fs::path(dir) / ("dirs_" + to_string(level) + ".bin")).string();
+}
+
+string ExternalBFS::runPath(size_t index) const {
+    return (fs::path(dir) / ("run_" + to_string(index) + ".bin")).string();
+}
+
+size_t ExternalBFS::writeRun(vector<uint64_t>& buffer, size_t index) {
+    sort(buffer.begin(), buffer.end());
+    Writer w(runPath(index), m_bytesWritten);
+    for (uint64_t key : buffer) w.put(key);
+    buffer.clear();
+    return index + 1;
+}
+
+long long ExternalBFS::expandLayer(long long level, bool& goalSeen) {
+    long long C = maze.getCols();
+
+    // 1. Stream the layer and emit every open neighbour as (cell << 2 | dir to parent)
+    vector<uint64_t> buffer;
+    buffer.reserve(m_memoryEntries);
+    size_t runs = 0;
+    {
+        Reader layer(layerPath(level), m_bytesRead);
+        while (!layer.done()) {
+            CellId u = layer.next();
+            long long r = (long long)(u / C), c = (long long)(u % C);
+            for (unsigned d = 0; d < 4; ++d) {
+                long long nr = r + directions[d].first, nc = c + directions[d].second;
+                if (!maze.isOpen(nr, nc)) continue;
+                buffer.push_back(((CellId)nr * C + nc) << 2 | opposite(d));
+                if (buffer.size() == m_memoryEntries) runs = writeRun(buffer, runs);
+            }
+        }
+    }
+
+    // 2. Merge the sorted runs (the last one stays in memory)
+    sort(buffer.begin(), buffer.end());
+    vector<unique_ptr<Reader>> readers;
+    for (size_t i = 0; i < runs; ++i) {
+        readers.push_back(make_unique<Reader>(runPath(i), m_bytesRead));
+    }
+    size_t memPos = 0;
+
+    using Head = pair<uint64_t, size_t>; // (key, source), source == runs is the buffer
+    priority_queue<Head, vector<Head>, greater<Head>> heads;
+    for (size_t i = 0; i < runs; ++i) {
+        if (!readers[i]->done()) heads.push({readers[i]->next(), i});
+    }
+    if (memPos < buffer.size()) heads.push({buffer[memPos++], runs});
+
+    // 3. Drop duplicates and cells in the previous two layers while writing the new one
+    unique_ptr<Reader> prev = level > 0 ? make_unique<Reader>(layerPath(level - 1), m_bytesRead) : nullptr;
+    Reader cur(layerPath(level), m_bytesRead);
+    long long count = 0;
+    CellId goalId = maze.getGoal();
+    {
+        Writer out(layerPath(level + 1), m_bytesWritten);
+        DirWriter dirs(dirsPath(level + 1), m_bytesWritten);
+        bool havePrevCell = false;
+        CellId prevCell = 0;
+
+        while (!heads.empty()) {
+            auto [key, src] = heads.top();
+            heads.pop();
+            if (src == runs) {
+                if (memPos < buffer.size()) heads.push({buffer[memPos++], runs});
+            } else if (!readers[src]->done()) {
+                heads.push({readers[src]->next(), src});
+            }
+
+            CellId v = key >> 2;
+            // Keys are sorted, so the first key of a cell has its smallest direction
+            if (havePrevCell && v == prevCell) continue;
+            havePrevCell = true;
+            prevCell = v;
+
+            while (prev && !prev->done() && prev->peek() < v) prev->next();
+            if (prev && !prev->done() && prev->peek() == v) continue;
+            while (!cur.done() && cur.peek() < v) cur.next();
+            if (!cur.done() && cur.peek() == v) continue;
+
+            out.put(v);
+            dirs.put((unsigned)(key & 3));
+            if (v == goalId) goalSeen = true;
+            count++;
+        }
+    }
+
+    readers.clear();
+    error_code ec;
+    for (size_t i = 0; i < runs; ++i) fs::remove(runPath(i), ec);
+    m_lastLevel = level + 1;
+    return count;
+}
+
+void ExternalBFS::tracePath(Result& result) {
+    long long C = maze.getCols();
+    CellId cell = maze.getGoal();
+    result.path.assign(1, cell);
+
+    for (long long level = result.distance; level > 0; --level) {
+        // Binary search the sorted layer file for this cell
+        ifstream layer(layerPath(level), ios::binary);
+        layer.seekg(0, ios::end);
+        long long lo = 0, hi = (long long)layer.tellg() / (long long)sizeof(CellId);
+        while (lo < hi) {
+            long long mid = (lo + hi) / 2;
+            CellId v;
+            layer.seekg(mid * (long long)sizeof(CellId));
+            layer.read(reinterpret_cast<char*>(&v), sizeof(v));
+            m_bytesRead += sizeof(v);
+            if (v < cell) lo = mid + 1; else hi = mid;
+        }
+
+        ifstream dirs(dirsPath(level), ios::binary);
+        dirs.seekg(lo / 4);
+        char packed = 0;
+        dirs.read(&packed, 1);
+        m_bytesRead += 1;
+        unsigned d = ((uint8_t)packed >> ((lo % 4) * 2)) & 3;
+
+        long long r = (long long)(cell / C) + directions[d].first;
+        long long c = (long long)(cell % C) + directions[d].second;
+        cell = (CellId)r * C + c;
+        result.path.push_back(cell);
+    }
+    reverse(result.path.begin(), result.path.end());
+}
+
+ExternalBFS::Result ExternalBFS::run() {
+    sf::Clock clock;
+    Result result;
+
+    {
+        Writer first(layerPath(0), m_bytesWritten);
+        first.put(maze.getStart());
+    }
+    m_lastLevel = 0;
+
+    long long level = 0;
+    long long layerSize = 1;
+    bool goalSeen = maze.getStart() == maze.getGoal();
+
+    while (layerSize > 0 && !goalSeen) {
+        result.nodesExplored += layerSize;
+        result.maxLayerSize = max(result.maxLayerSize, layerSize);
+        layerSize = expandLayer(level, goalSeen);
+        level++;
+    }
+    result.levels = level;
+
+    if (goalSeen) {
+        result.found = true;
+        result.distance = level;
+        tracePath(result);
+    }
+
+    result.bytesRead = m_bytesRead + maze.getBytesRead();
+    result.bytesWritten = m_bytesWritten;
+    result.timeTaken = clock.getElapsedTime();
+    return result;
+}
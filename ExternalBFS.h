@@ -0,0 +1,57 @@
+#ifndef EXTERNAL_BFS_H
+#define EXTERNAL_BFS_H
+
+#include "TiledMaze.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <SFML/System/Time.hpp>
+
+// Out-of-core BFS over a TiledMaze (Munagala & Ranade style).
+// Every BFS layer lives in a sorted file of cell ids. The next layer is built by
+// streaming the current one, writing neighbours into sorted runs (bounded by
+// memoryEntries), merging them, and removing anything already in the previous
+// two layers. Parents are stored as 2-bit direction records per layer, so the
+// path is rebuilt by walking back through the layer files.
+class ExternalBFS {
+public:
+    using CellId = TiledMaze::CellId;
+
+    struct Result {
+        bool found = false;
+        long long distance = -1;        // Moves from start to goal
+        std::vector<CellId> path;       // Start ... goal
+        long long nodesExplored = 0;    // Cells in all expanded layers
+        long long levels = 0;
+        long long maxLayerSize = 0;
+        std::uint64_t bytesRead = 0;    // Layer, run and tile reads
+        std::uint64_t bytesWritten = 0; // Layer, run and direction writes
+        sf::Time timeTaken;
+    };
+
+    // memoryEntries bounds the neighbour buffer (8 bytes each) held in RAM
+    ExternalBFS(TiledMaze& maze, const std::string& workDir,
+                std::size_t memoryEntries = std::size_t(1) << 22);
+    ~ExternalBFS();
+
+    Result run();
+
+private:
+    std::string layerPath(long long level) const;
+    std::string dirsPath(long long level) const;
+    std::string runPath(std::size_t index) const;
+
+    // Builds layer level+1 from layers level and level-1; returns its size
+    long long expandLayer(long long level, bool& goalSeen);
+    std::size_t writeRun(std::vector<std::uint64_t>& buffer, std::size_t index);
+    void tracePath(Result& result);
+
+    TiledMaze& maze;
+    std::string dir;
+    std::size_t m_memoryEntries;
+    std::uint64_t m_bytesRead = 0;
+    std::uint64_t m_bytesWritten = 0;
+    long long m_lastLevel = -1;
+};
+
+#endif // EXTERNAL_BFS_H
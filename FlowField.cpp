@@ -0,0 +1,171 @@
+#include "FlowField.h"
+#include "Utils.h"
+#include "Trace.h"
+#include <algorithm>
+#include <functional>
+
+using namespace std;
+
+// 'directions' is ordered Up, Right, Down, Left: the reverse of move d is (d + 2) % 4
+static int reverseMove(int d) { return (d + 2) & 3; }
+
+void FlowField::build(const Maze& maze) {
+    TRACE_SCOPE("FlowField::build");
+    m_rows = maze.getRows();
+    m_cols = maze.getCols();
+    m_goal = maze.getGoal();
+    for (int d = 0; d < 4; ++d) {
+        m_offset[d] = directions[d].first * m_cols + directions[d].second;
+    }
+    m_offset[NO_MOVE] = 0;
+
+    size_t cells = (size_t)m_rows * m_cols;
+    m_open.assign(cells, 0);
+    for (int r = 0; r < m_rows; ++r) {
+        for (int c = 0; c < m_cols; ++c) {
+            m_open[(size_t)r * m_cols + c] = maze.grid[r][c] != '#';
+        }
+    }
+    m_dist.assign(cells, UNREACHABLE);
+    m_move.assign(cells, NO_MOVE);
+
+    // Reverse BFS from the goal; the queue is just the visit order
+    vector<int32_t> queue;
+    queue.reserve(cells);
+    int32_t goalId = m_goal.first * m_cols + m_goal.second;
+    m_dist[goalId] = 0;
+    queue.push_back(goalId);
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int32_t cell = queue[head];
+        int r = cell / m_cols, c = cell % m_cols;
+        for (int d = 0; d < 4; ++d) {
+            int nr = r + directions[d].first, nc = c + directions[d].second;
+            if (!isInside(maze.grid, nr, nc)) continue;
+
+            int32_t next = cell + m_offset[d];
+            if (!m_open[next] || m_dist[next] != UNREACHABLE) continue;
+            m_dist[next] = m_dist[cell] + 1;
+            m_move[next] = (uint8_t)reverseMove(d); // Back the way the BFS came
+            queue.push_back(next);
+        }
+    }
+}
+
+void FlowField::relax(vector<pair<int32_t, int32_t>>& heap, int32_t cell, int32_t dist, int move) {
+    m_dist[cell] = dist;
+    m_move[cell] = (uint8_t)move;
+    heap.push_back({dist, cell});
+    push_heap(heap.begin(), heap.end(), greater<pair<int32_t, int32_t>>());
+}
+
+size_t FlowField::wallsChanged(const Maze& maze, const vector<pair<int, int>>& cells) {
+    TRACE_SCOPE("FlowField::wallsChanged");
+    for (auto [r, c] : cells) {
+        if (make_pair(r, c) == m_goal) {
+            // Everything hangs off the goal
+            build(maze);
+            return m_dist.size();
+        }
+    }
+
+    // 1. Cells that lost their route: every cell whose chain of moves passes
+    //    through a new wall. The rest keep a valid (if maybe too long) distance.
+    vector<int32_t> invalid, stack;
+    vector<int32_t> opened;
+    for (auto [r, c] : cells) {
+        int32_t cell = r * m_cols + c;
+        bool open = maze.grid[r][c] != '#';
+        if (open == (bool)m_open[cell]) continue;
+        m_open[cell] = open;
+        if (open) {
+            opened.push_back(cell);
+            continue;
+        }
+        if (m_dist[cell] == UNREACHABLE) continue;
+        stack.push_back(cell);
+        while (!stack.empty()) {
+            int32_t at = stack.back();
+            stack.pop_back();
+            m_dist[at] = UNREACHABLE;
+            m_move[at] = NO_MOVE;
+            invalid.push_back(at);
+
+            int ar = at / m_cols, ac = at % m_cols;
+            for (int d = 0; d < 4; ++d) {
+                int nr = ar + directions[d].first, nc = ac + directions[d].second;
+                if (!isInside(maze.grid, nr, nc)) continue;
+                int32_t child = at + m_offset[d];
+                if (m_move[child] == reverseMove(d)) stack.push_back(child);
+            }
+        }
+    }
+
+    // 2. Seed each invalidated or newly opened cell from its best neighbour
+    //    that still has a distance
+    vector<pair<int32_t, int32_t>> heap;
+    auto seed = [&](int32_t cell) {
+        if (!m_open[cell]) return;
+        int r = cell / m_cols, c = cell % m_cols;
+        int32_t best = UNREACHABLE;
+        int bestMove = NO_MOVE;
+        for (int d = 0; d < 4; ++d) {
+            int nr = r + directions[d].first, nc = c + directions[d].second;
+            if (!isInside(maze.grid, nr, nc)) continue;
+            int32_t dist = m_dist[cell + m_offset[d]];
+            if (dist != UNREACHABLE && (best == UNREACHABLE || dist + 1 < best)) {
+                best = dist + 1;
+                bestMove = d;
+            }
+        }
+        if (best != UNREACHABLE) relax(heap, cell, best, bestMove);
+    };
+    for (int32_t cell : invalid) seed(cell);
+    for (int32_t cell : opened) seed(cell);
+
+    // 3. Dijkstra from the seeds. Distances only spread outward, so it stops
+    //    as soon as no cell gets closer.
+    size_t recomputed = 0;
+    while (!heap.empty()) {
+        pop_heap(heap.begin(), heap.end(), greater<pair<int32_t, int32_t>>());
+        auto [dist, cell] = heap.back();
+        heap.pop_back();
+        if (dist != m_dist[cell]) continue; // Superseded by a shorter route
+        recomputed++;
+
+        int r = cell / m_cols, c = cell % m_cols;
+        for (int d = 0; d < 4; ++d) {
+            int nr = r + directions[d].first, nc = c + directions[d].second;
+            if (!isInside(maze.grid, nr, nc)) continue;
+            int32_t next = cell + m_offset[d];
+            if (!m_open[next]) continue;
+            if (m_dist[next] != UNREACHABLE && m_dist[next] <= dist + 1) continue;
+            relax(heap, next, dist + 1, reverseMove(d));
+        }
+    }
+    return recomputed;
+}
+
+pair<int, int> FlowField::nextCell(int r, int c) const {
+    int move = nextMove(r, c);
+    if (move == NO_MOVE) return {r, c};
+    return {r + directions[move].first, c + directions[move].second};
+}
+
+size_t FlowField::step(vector<int32_t>& agents) const {
+    TRACE_SCOPE("FlowField::step");
+    const int32_t goalId = m_goal.first * m_cols + m_goal.second;
+    const uint8_t* move = m_move.data();
+    size_t arrived = 0;
+
+    // NO_MOVE has offset 0, so finished and stranded agents need no branch
+    for (int32_t& agent : agents) {
+        agent += m_offset[move[agent]];
+        arrived += agent == goalId;
+    }
+    return arrived;
+}
+
+int32_t FlowField::getMaxDistance() const {
+    return m_dist.empty() ? 0 : *max_element(m_dist.begin(), m_dist.end());
+}
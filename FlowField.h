@@ -0,0 +1,60 @@
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include "Maze.h"
+
+// Goal flow field: one reverse BFS from Maze::getGoal() gives every open cell
+// its distance to the goal and the move that leads one step closer. Any number
+// of agents heading for that goal then need no search of their own; each one
+// reads its next move in O(1).
+//
+// Agents are plain cell ids (r * cols + c) so a whole crowd can be stepped
+// with step(). Agents don't block each other.
+class FlowField {
+public:
+    static constexpr int NO_MOVE = 4;             // At the goal, on a wall, or cut off from it
+    static constexpr std::int32_t UNREACHABLE = -1;
+
+    FlowField() = default;
+    explicit FlowField(const Maze& maze) { build(maze); }
+
+    // Full rebuild from the maze's current walls and goal
+    void build(const Maze& maze);
+
+    // The walls at 'cells' were toggled in 'maze' (same goal). Only cells whose
+    // distance can change are recomputed: the subtrees hanging off new walls
+    // and whatever new openings bring closer. Returns the cells recomputed.
+    std::size_t wallsChanged(const Maze& maze, const std::vector<std::pair<int, int>>& cells);
+
+    // Index into 'directions' of a move one step closer to the goal, or NO_MOVE
+    int nextMove(int r, int c) const { return m_move[(std::size_t)r * m_cols + c]; }
+    std::pair<int, int> nextCell(int r, int c) const;
+
+    // Moves to the goal, or UNREACHABLE
+    std::int32_t distance(int r, int c) const { return m_dist[(std::size_t)r * m_cols + c]; }
+
+    // Advances every agent one move; returns how many are at the goal afterwards
+    std::size_t step(std::vector<std::int32_t>& agents) const;
+
+    int getRows() const { return m_rows; }
+    int getCols() const { return m_cols; }
+    std::pair<int, int> getGoal() const { return m_goal; }
+    std::int32_t getMaxDistance() const;
+    std::size_t getSizeBytes() const { return m_dist.size() * sizeof(std::int32_t) + m_move.size(); }
+
+private:
+    // Sets cell's move towards its neighbour with the smallest distance
+    void relax(std::vector<std::pair<std::int32_t, std::int32_t>>& heap, std::int32_t cell, std::int32_t dist, int move);
+
+    int m_rows = 0, m_cols = 0;
+    std::pair<int, int> m_goal{0, 0};
+    std::vector<std::uint8_t> m_open;     // 1 = not a wall, as of the last build/update
+    std::vector<std::int32_t> m_dist;
+    std::vector<std::uint8_t> m_move;     // Index into 'directions', or NO_MOVE
+    std::int32_t m_offset[NO_MOVE + 1] = {0, 0, 0, 0, 0}; // Cell id delta per move
+};
+
+#endif // FLOW_FIELD_H
@@ -0,0 +1,129 @@
+#include "GoalBounds.h"
+#include "Utils.h"
+#include "ThreadPool.h"
+#include "Trace.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <cstring>
+
+using namespace std;
+
+static const char BOUNDS_MAGIC[8] = {'M', 'Z', 'G', 'B', 'N', 'D', '1', '\0'};
+static constexpr uint8_t NO_MOVE = 4;
+
+void GoalBounds::Box::add(int r, int c) {
+    minR = min(minR, (uint16_t)r);
+    minC = min(minC, (uint16_t)c);
+    maxR = max(maxR, (uint16_t)r);
+    maxC = max(maxC, (uint16_t)c);
+}
+
+GoalBounds GoalBounds::build(const Maze& maze, unsigned threads) {
+    TRACE_SCOPE("GoalBounds::build");
+    GoalBounds gb;
+    const auto& g = maze.grid;
+    int R = gb.rows = (int)g.size();
+    int C = gb.cols = (int)g[0].size();
+    gb.mazeHash = maze.wallFingerprint();
+
+    vector<int> cellOf;
+    gb.index.assign((size_t)R * C, -1);
+    for (int v = 0; v < R * C; ++v) {
+        if (g[v / C][v % C] == '#') continue;
+        gb.index[v] = (int32_t)cellOf.size();
+        cellOf.push_back(v);
+    }
+    int openCount = (int)cellOf.size();
+    gb.boxes.assign((size_t)openCount * 4, Box());
+
+    // Neighbour ids of every open cell (-1 = wall or outside), shared read-only
+    vector<array<int, 4>> neighbours((size_t)R * C);
+    for (int v = 0; v < R * C; ++v) {
+        for (int d = 0; d < 4; ++d) {
+            int nr = v / C + directions[d].first, nc = v % C + directions[d].second;
+            bool ok = isInside(g, nr, nc) && g[nr][nc] != '#';
+            neighbours[v][d] = ok ? nr * C + nc : -1;
+        }
+    }
+    atomic<int> nextSource(0);
+    ThreadPool pool(threads);
+
+    pool.runOnAll([&](unsigned) {
+        // Per-thread BFS scratch, reused for every source
+        vector<uint8_t> move((size_t)R * C, NO_MOVE);
+        vector<int> queue;
+        queue.reserve(openCount);
+
+        // Sources are handed out one at a time so threads stay balanced;
+        // each one only writes its own four boxes
+        for (int s = nextSource++; s < openCount; s = nextSource++) {
+            int src = cellOf[s];
+            for (int v : queue) move[v] = NO_MOVE;
+            queue.clear();
+
+            // BFS where every cell inherits the first move of its parent
+            queue.push_back(src);
+            move[src] = 0;
+            Box* box = &gb.boxes[(size_t)s * 4];
+            for (size_t head = 0; head < queue.size(); ++head) {
+                int u = queue[head];
+                if (u != src) box[move[u]].add(u / C, u % C);
+                for (int d = 0; d < 4; ++d) {
+                    int v = neighbours[u][d];
+                    if (v < 0 || move[v] != NO_MOVE || v == src) continue;
+                    move[v] = u == src ? (uint8_t)d : move[u];
+                    queue.push_back(v);
+                }
+            }
+        }
+    });
+    return gb;
+}
+
+bool GoalBounds::save(const string& path) const {
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out) return false;
+
+    int32_t dims[2] = {rows, cols};
+    uint64_t count = boxes.size();
+    out.write(BOUNDS_MAGIC, sizeof(BOUNDS_MAGIC));
+    out.write(reinterpret_cast<const char*>(&mazeHash), sizeof(mazeHash));
+    out.write(reinterpret_cast<const char*>(dims), sizeof(dims));
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    out.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(int32_t));
+    out.write(reinterpret_cast<const char*>(boxes.data()), boxes.size() * sizeof(Box));
+    return (bool)out;
+}
+
+bool GoalBounds::load(const string& path, const Maze& maze) {
+    ifstream in(path, ios::binary);
+    if (!in) return false;
+
+    char magic[8];
+    uint64_t hash = 0, count = 0;
+    int32_t dims[2];
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+    in.read(reinterpret_cast<char*>(dims), sizeof(dims));
+    in.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!in || memcmp(magic, BOUNDS_MAGIC, sizeof(magic)) != 0) return false;
+    if (hash != maze.wallFingerprint() || dims[0] != (int)maze.grid.size() ||
+        dims[1] != (int)maze.grid[0].size()) {
+        return false;
+    }
+
+    GoalBounds gb;
+    gb.rows = dims[0];
+    gb.cols = dims[1];
+    gb.mazeHash = hash;
+    gb.index.resize((size_t)gb.rows * gb.cols);
+    gb.boxes.resize(count);
+    in.read(reinterpret_cast<char*>(gb.index.data()), gb.index.size() * sizeof(int32_t));
+    in.read(reinterpret_cast<char*>(gb.boxes.data()), gb.boxes.size() * sizeof(Box));
+    if (!in) return false;
+
+    *this = move(gb);
+    return true;
+}
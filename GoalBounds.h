@@ -0,0 +1,58 @@
+#ifndef GOAL_BOUNDS_H
+#define GOAL_BOUNDS_H
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include "Maze.h"
+
+// Goal bounding for A* on a static maze.
+// An offline build runs a BFS from every open cell (spread over all cores),
+// labelling every target with the first move of a shortest path to it, as
+// PathDatabase does. For each cell and each move in 'directions' it keeps the
+// bounding box of the targets labelled with that move. A search towards a
+// goal can then skip any move whose box misses the goal, since that move
+// starts no shortest path there.
+//
+// Four boxes of four 16-bit bounds per open cell (32 bytes), so mazes up to
+// 65535 cells a side; the build itself is quadratic in open cells.
+class GoalBounds {
+public:
+    struct Box {
+        std::uint16_t minR = UINT16_MAX, minC = UINT16_MAX, maxR = 0, maxC = 0;
+
+        bool isEmpty() const { return minR > maxR; }
+        bool contains(int r, int c) const { return r >= minR && r <= maxR && c >= minC && c <= maxC; }
+        void add(int r, int c);
+    };
+
+    GoalBounds() = default;
+
+    // threads == 0 means "one per hardware core"
+    static GoalBounds build(const Maze& maze, unsigned threads = 0);
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path, const Maze& maze);
+
+    // Some shortest path from 'from' to 'to' may start with move 'd'
+    bool mayLeadTo(std::pair<int, int> from, int d, std::pair<int, int> to) const {
+        std::int32_t i = index[(std::size_t)from.first * cols + from.second];
+        return i < 0 || boxes[(std::size_t)i * 4 + d].contains(to.first, to.second);
+    }
+
+    // Box of move 'd' from an open cell
+    const Box& getBox(int r, int c, int d) const { return boxes[(std::size_t)index[(std::size_t)r * cols + c] * 4 + d]; }
+
+    std::size_t getCellCount() const { return boxes.size() / 4; }
+    std::size_t getSizeBytes() const { return boxes.size() * sizeof(Box) + index.size() * sizeof(std::int32_t); }
+
+private:
+    int rows = 0, cols = 0;
+    std::uint64_t mazeHash = 0;
+    std::vector<std::int32_t> index; // Cell id -> open cell number in row-major order (-1 = wall)
+    std::vector<Box> boxes;          // Open cell * 4 + move
+};
+
+#endif // GOAL_BOUNDS_H
@@ -0,0 +1,60 @@
+#include "GoalIndex.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+
+using namespace std;
+
+void GoalIndex::build(const vector<pair<int, int>>& goals, int rows, int cols) {
+    m_goals.clear();
+    m_start.clear();
+    if (goals.empty()) return;
+
+    m_block = max(2, (int)sqrt((double)rows * cols / goals.size()));
+    m_blockRows = (rows + m_block - 1) / m_block;
+    m_blockCols = (cols + m_block - 1) / m_block;
+
+    // Counting sort by block
+    auto blockOf = [&](pair<int, int> g) { return (g.first / m_block) * m_blockCols + g.second / m_block; };
+    m_start.assign((size_t)m_blockRows * m_blockCols + 1, 0);
+    for (pair<int, int> g : goals) m_start[blockOf(g) + 1]++;
+    for (size_t b = 1; b < m_start.size(); ++b) m_start[b] += m_start[b - 1];
+
+    m_goals.resize(goals.size());
+    vector<int32_t> next(m_start.begin(), m_start.end() - 1);
+    for (pair<int, int> g : goals) m_goals[next[blockOf(g)]++] = g;
+}
+
+int GoalIndex::nearestDistance(int r, int c) const {
+    if (m_goals.empty()) return -1;
+    int br = r / m_block, bc = c / m_block;
+    int best = INT_MAX;
+
+    auto scan = [&](int row, int col) {
+        if (row < 0 || row >= m_blockRows || col < 0 || col >= m_blockCols) return;
+        int b = row * m_blockCols + col;
+        for (int32_t i = m_start[b]; i < m_start[b + 1]; ++i) {
+            best = min(best, abs(m_goals[i].first - r) + abs(m_goals[i].second - c));
+        }
+    };
+
+    int lastRing = max(max(br, m_blockRows - 1 - br), max(bc, m_blockCols - 1 - bc));
+    for (int ring = 0; ring <= lastRing; ++ring) {
+        // A block 'ring' blocks away is more than (ring - 1) * block cells away
+        if (ring > 0 && best <= (ring - 1) * m_block + 1) break;
+        if (ring == 0) {
+            scan(br, bc);
+            continue;
+        }
+        for (int dc = -ring; dc <= ring; ++dc) {
+            scan(br - ring, bc + dc);
+            scan(br + ring, bc + dc);
+        }
+        for (int dr = -ring + 1; dr < ring; ++dr) {
+            scan(br + dr, bc - ring);
+            scan(br + dr, bc + ring);
+        }
+    }
+    return best;
+}
@@ -0,0 +1,34 @@
+#ifndef GOAL_INDEX_H
+#define GOAL_INDEX_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+// Manhattan distance to the nearest of many goals, for A*'s heuristic when
+// the maze has several (see Maze::setGoals). Goals are bucketed into square
+// blocks of cells, about one goal per block, stored CSR style. A query scans
+// rings of blocks outwards from the cell's own block and stops as soon as the
+// next ring is too far away to hold anything closer.
+class GoalIndex {
+public:
+    GoalIndex() = default;
+    GoalIndex(const std::vector<std::pair<int, int>>& goals, int rows, int cols) { build(goals, rows, cols); }
+
+    void build(const std::vector<std::pair<int, int>>& goals, int rows, int cols);
+
+    // Manhattan distance to the nearest goal; -1 if there are none
+    int nearestDistance(int r, int c) const;
+
+    std::size_t size() const { return m_goals.size(); }
+    int getBlockSize() const { return m_block; }
+
+private:
+    int m_block = 1;
+    int m_blockRows = 0, m_blockCols = 0;
+    std::vector<std::int32_t> m_start;        // Block -> first goal; one extra sentinel
+    std::vector<std::pair<int, int>> m_goals; // Grouped by block
+};
+
+#endif // GOAL_INDEX_H
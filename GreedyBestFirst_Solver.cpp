@@ -1,14 +1,26 @@
 #include "GreedyBestFirst_Solver.h"
 #include <limits>
+#include "Checkpoint.h"
 #include <iostream>
+#include <algorithm>
 
-GreedyBestFirst_Solver::GreedyBestFirst_Solver(const Maze& maze)
-    : Solver(maze, 'G') // Use 'G' as the symbol
+// Cells Greedy is expected to touch: it heads almost straight for the goal,
+// so roughly a band along the start-goal line
+static CellStorage pickStorage(const Maze& maze, CellStorage storage) {
+    if (storage != CellStorage::Auto) return storage;
+    size_t d = (size_t)(std::abs(maze.getStart().first - maze.getGoal().first)
+                      + std::abs(maze.getStart().second - maze.getGoal().second));
+    return chooseCellStorage((size_t)maze.getRows() * maze.getCols(), 16 * (d + 1));
+}
+
+GreedyBestFirst_Solver::GreedyBestFirst_Solver(const Maze& maze, const Landmarks* landmarks, CellStorage storage)
+    : Solver(maze, 'G', pickStorage(maze, storage)), // Use 'G' as the symbol
+      m_landmarks(landmarks)
 {
     int rows = maze.getRows();
     int cols = maze.getCols();
 
-    visited.assign(rows, std::vector<bool>(cols, false));
+    visited.reset(rows, cols, false, getStorage());
     // parent is in base class
     
     int hStart = heuristic(start.first, start.second);
@@ -20,7 +32,11 @@ GreedyBestFirst_Solver::GreedyBestFirst_Solver(const Maze& maze)
 
 int GreedyBestFirst_Solver::heuristic(int r, int c) const {
     // Manhattan distance heuristic
-    return std::abs(goal.first - r) + std::abs(goal.second - c);
+    int h = std::abs(goal.first - r) + std::abs(goal.second - c);
+
+    // ALT follows the walls, so greedy gets pulled around them instead of into them
+    if (m_landmarks) h = std::max(h, m_landmarks->heuristic(r, c, goal));
+    return h;
 }
 // heuristic(r,c) computes the Manhattan distance from (r,c) to the goal.
 void GreedyBestFirst_Solver::step() {
@@ -36,6 +52,7 @@ void GreedyBestFirst_Solver::step() {
         }
         if (grid[tracePos.first][tracePos.second] != 'E') {
             grid[tracePos.first][tracePos.second] = 'X'; // 'X' for final path
+            logEvent(EventLog::Type::Path, tracePos.first, tracePos.second);
         }
         tracePos = parent[tracePos.first][tracePos.second];
         return;
@@ -49,7 +66,7 @@ void GreedyBestFirst_Solver::step() {
         found = false;
         
         // Stop the clock if the search fails
-        m_timeTaken = m_clock.getElapsedTime();
+        m_timeTaken = m_resumedTime + m_clock.getElapsedTime();
         
         return;
     }
@@ -70,6 +87,7 @@ void GreedyBestFirst_Solver::step() {
         // Color when processing
         if (grid[r][c] == ' ')
             grid[r][c] = symbol;
+        logEvent(EventLog::Type::Expanded, r, c);
 
         // Found the goal
         if (r == goal.first && c == goal.second) {
@@ -78,7 +96,7 @@ void GreedyBestFirst_Solver::step() {
             tracePos = goal;
             
             // Stop the clock on success
-            m_timeTaken = m_clock.getElapsedTime();
+            m_timeTaken = m_resumedTime + m_clock.getElapsedTime();
             
             return; // Exit step
         }
@@ -94,6 +112,7 @@ void GreedyBestFirst_Solver::step() {
                 parent[nr][nc] = {r, c};
                 int h = heuristic(nr, nc);
                 openSet.push({h, {nr, nc}});
+                logEvent(EventLog::Type::Enqueued, nr, nc);
                 // Don't color here, color when popped
             }
         }
@@ -107,6 +126,42 @@ void GreedyBestFirst_Solver::step() {
     
     // Make sure clock is stopped even if it fails
     if (m_timeTaken == sf::Time::Zero) {
-        m_timeTaken = m_clock.getElapsedTime();
+        m_timeTaken = m_resumedTime + m_clock.getElapsedTime();
+    }
+}
+
+bool GreedyBestFirst_Solver::saveState(CheckpointWriter& w) const {
+    saveBaseState(w, m_clock);
+
+    // Heap array as (score, r, c) triples, in its internal order
+    std::vector<int32_t> heap;
+    for (const NodeData& n : underlying(openSet)) {
+        heap.insert(heap.end(), {n.h, n.pos.first, n.pos.second});
+    }
+    w.array(heap);
+    w.bits(visited.toMatrix());
+    return w.ok();
+}
+
+bool GreedyBestFirst_Solver::loadState(CheckpointReader& r) {
+    if (!loadBaseState(r)) return false;
+
+    std::vector<int32_t> heap;
+    r.array(heap);
+    std::vector<std::vector<bool>> closed;
+    r.bits(closed);
+    visited.fromMatrix(closed);
+    auto& nodes = underlying(openSet);
+    nodes.clear();
+    for (size_t i = 0; i + 2 < heap.size(); i += 3) {
+        nodes.push_back({heap[i], {heap[i + 1], heap[i + 2]}});
     }
-}
\ No newline at end of file
+
+    // The search clock continues from the saved time
+    m_clock.restart();
+    return r.ok();
+}
+
+size_t GreedyBestFirst_Solver::getMemoryBytes() const {
+    return Solver::getMemoryBytes() + underlying(openSet).capacity() * sizeof(NodeData) + visited.getBytes();
+}
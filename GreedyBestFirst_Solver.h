@@ -3,6 +3,7 @@
 
 #include "Solver.h"
 #include "Utils.h"
+#include "Landmarks.h"
 #include <queue>
 #include <vector>
 #include <utility>
@@ -14,10 +15,24 @@
 // Very fast, but not guaranteed to find the shortest path.
 class GreedyBestFirst_Solver : public Solver {
 public:
-    explicit GreedyBestFirst_Solver(const Maze& maze);
+    // With landmarks, the heuristic is max(Manhattan, ALT).
+    // storage: backend for visited/parent, as in AStar_Solver
+    explicit GreedyBestFirst_Solver(const Maze& maze, const Landmarks* landmarks = nullptr,
+                                    CellStorage storage = CellStorage::Auto);
 
     void step() override;
 
+    // Performance HUD readings (see Solver.h)
+    std::size_t getOpenSetSize() const override { return openSet.size(); }
+    std::size_t getMemoryBytes() const override;
+
+    // Checkpointing (see Checkpoint.h)
+    bool saveState(CheckpointWriter& w) const override;
+    bool loadState(CheckpointReader& r) override;
+
+    // Memory held by visited and parent
+    std::size_t getStorageBytes() const { return visited.getBytes() + parent.getBytes(); }
+
 private:
     using Node = std::pair<int, int>; // Grid coordinate
 
@@ -28,9 +43,10 @@ private:
     };
 
     std::priority_queue<NodeData, std::vector<NodeData>, std::greater<NodeData>> openSet;
-    std::vector<std::vector<bool>> visited; // No gScore needed, just visited
+    CellStore<bool> visited; // No gScore needed, just visited
 
     int heuristic(int r, int c) const;
+    const Landmarks* m_landmarks; // Optional ALT tables (not owned)
     
     // Clock for timing the algorithm
     sf::Clock m_clock;
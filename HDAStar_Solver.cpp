@@ -0,0 +1,239 @@
+#include "HDAStar_Solver.h"
+#include <queue>
+#include <limits>
+#include <thread>
+#include <cstdlib>
+
+using namespace std;
+
+HDAStar_Solver::HDAStar_Solver(const Maze& maze, unsigned threads)
+    : Solver(maze, 'H'),
+      R(maze.getRows()),
+      C(maze.getCols()),
+      m_pool(threads),
+      m_incumbent(numeric_limits<int>::max()),
+      m_work(0)
+{
+    open.assign((size_t)R * C, 0);
+    for (int r = 0; r < R; ++r) {
+        for (int c = 0; c < C; ++c) {
+            open[(size_t)r * C + c] = grid[r][c] != '#';
+        }
+    }
+
+    gScore.assign((size_t)R * C, numeric_limits<int>::max());
+    inboxes = vector<Inbox>(m_pool.size());
+    m_stats.assign(m_pool.size(), ThreadStats{});
+
+    // Start the algorithm's timer
+    m_clock.restart();
+}
+
+unsigned HDAStar_Solver::owner(int id) const {
+    // splitmix64 finaliser: scatters neighbouring cells evenly over the threads
+    uint64_t h = (uint64_t)(uint32_t)id + 0x9E3779B97F4A7C15ull;
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+    h ^= h >> 31;
+    return (unsigned)(h % m_pool.size());
+}
+
+int HDAStar_Solver::heuristic(int id) const {
+    // Manhattan distance
+    return abs(goal.first - id / C) + abs(goal.second - id % C);
+}
+
+void HDAStar_Solver::push(unsigned to, Batch* batch) {
+    // Counted before it becomes visible, so m_work can't hit 0 with it in flight
+    m_work.fetch_add(1, memory_order_acq_rel);
+
+    Batch* head = inboxes[to].head.load(memory_order_relaxed);
+    do {
+        batch->next = head;
+    } while (!inboxes[to].head.compare_exchange_weak(head, batch,
+                                                     memory_order_release,
+                                                     memory_order_relaxed));
+}
+
+void HDAStar_Solver::lowerIncumbent(int cost) {
+    int cur = m_incumbent.load(memory_order_relaxed);
+    while (cost < cur &&
+           !m_incumbent.compare_exchange_weak(cur, cost, memory_order_relaxed)) {
+    }
+}
+
+void HDAStar_Solver::worker(unsigned t) {
+    struct Entry {
+        int f, g, id;
+        bool operator>(const Entry& other) const {
+            // Ties broken towards deeper nodes
+            return f > other.f || (f == other.f && g < other.g);
+        }
+    };
+    priority_queue<Entry, vector<Entry>, greater<Entry>> openSet;
+
+    ThreadStats& stats = m_stats[t];
+    vector<Batch*> outgoing(m_pool.size(), nullptr);
+    int goalId = goal.first * C + goal.second;
+    bool idle = false;
+
+    // Applies a successor that this thread owns
+    auto relax = [&](const Message& m) {
+        if (m.g >= gScore[m.id]) { stats.stale++; return; }
+        int f = m.g + heuristic(m.id);
+        if (f >= m_incumbent.load(memory_order_relaxed)) { stats.stale++; return; }
+
+        gScore[m.id] = m.g;
+        parent[m.id / C][m.id % C] = {m.from / C, m.from % C};
+        if (m.id == goalId) {
+            lowerIncumbent(m.g);
+            return; // Nothing to expand past the goal
+        }
+        openSet.push({f, m.g, m.id});
+    };
+
+    auto flush = [&](unsigned to) {
+        if (!outgoing[to]) return;
+        push(to, outgoing[to]);
+        outgoing[to] = nullptr;
+        stats.batchesSent++;
+    };
+
+    // The start cell is seeded by its owner
+    int startId = start.first * C + start.second;
+    if (owner(startId) == t) {
+        gScore[startId] = 0;
+        openSet.push({heuristic(startId), 0, startId});
+    }
+
+    while (true) {
+        // Drain the inbox
+        Batch* batch = inboxes[t].head.exchange(nullptr, memory_order_acquire);
+        while (batch) {
+            for (const Message& m : batch->msgs) {
+                stats.received++;
+                relax(m);
+            }
+            Batch* next = batch->next;
+            delete batch;
+            batch = next;
+
+            if (idle) {
+                // This batch's unit of work becomes "this thread is busy"
+                idle = false;
+            } else {
+                m_work.fetch_sub(1, memory_order_acq_rel);
+            }
+        }
+
+        // Expand a few nodes
+        for (int i = 0; i < EXPANSIONS_PER_ROUND && !openSet.empty(); ++i) {
+            Entry cur = openSet.top();
+            if (cur.f >= m_incumbent.load(memory_order_relaxed)) break;
+            openSet.pop();
+            if (cur.g != gScore[cur.id]) { stats.stale++; continue; }
+
+            stats.expanded++;
+            int r = cur.id / C, c = cur.id % C;
+            if (grid[r][c] == ' ') grid[r][c] = symbol; // Only the owner writes this cell
+
+            for (auto [dr, dc] : directions) {
+                int nr = r + dr, nc = c + dc;
+                if (nr < 0 || nc < 0 || nr >= R || nc >= C) continue;
+                int v = nr * C + nc;
+                if (!open[v]) continue;
+
+                stats.generated++;
+                Message m{v, cur.g + 1, cur.id};
+                unsigned to = owner(v);
+                if (to == t) {
+                    relax(m);
+                    continue;
+                }
+
+                stats.sent++;
+                if (!outgoing[to]) outgoing[to] = new Batch();
+                outgoing[to]->msgs.push_back(m);
+                if (outgoing[to]->msgs.size() >= BATCH_SIZE) flush(to);
+            }
+        }
+
+        for (unsigned to = 0; to < outgoing.size(); ++to) flush(to);
+
+        bool hasWork = !openSet.empty() &&
+                       openSet.top().f < m_incumbent.load(memory_order_relaxed);
+        if (hasWork || inboxes[t].head.load(memory_order_acquire)) continue;
+
+        // Nothing useful left here: go idle and wait for messages or global termination
+        if (!idle) {
+            idle = true;
+            m_work.fetch_sub(1, memory_order_acq_rel);
+        }
+        if (m_work.load(memory_order_acquire) == 0) break;
+        stats.idleSpins++;
+        this_thread::yield();
+    }
+
+    // Every thread is idle now, so nobody else touches this open list
+    while (!openSet.empty()) openSet.pop();
+}
+
+void HDAStar_Solver::search() {
+    // Every thread starts out busy
+    m_work.store(m_pool.size(), memory_order_relaxed);
+    m_pool.runOnAll([this](unsigned t) { worker(t); });
+}
+
+void HDAStar_Solver::step() {
+
+    // If path found earlier, now backtracking the parent pointers
+    if (currentState == State::TRACING_PATH) {
+
+        // Count this node as part of the final path
+        m_pathLength++;
+
+        if (tracePos == start) {
+            currentState = State::DONE;
+            return;
+        }
+        if (grid[tracePos.first][tracePos.second] != 'E') {
+            grid[tracePos.first][tracePos.second] = 'X'; // Mark final solution path
+            logEvent(EventLog::Type::Path, tracePos.first, tracePos.second);
+        }
+        tracePos = parent[tracePos.first][tracePos.second];
+        return;
+    }
+
+    if (currentState != State::SEARCHING) return;
+
+    search();
+
+    m_nodesExplored = 0;
+    for (const ThreadStats& s : m_stats) m_nodesExplored += (int)s.expanded;
+
+    // The workers can't share a log, so the expanded set is logged afterwards
+    // (in row order, as one step)
+    if (m_events) {
+        for (auto [r, c] : getExploredCells()) {
+            if (grid[r][c] == symbol) logEvent(EventLog::Type::Expanded, r, c);
+        }
+    }
+
+    // Stop the clock once all threads have terminated
+    m_timeTaken = m_clock.getElapsedTime();
+
+    if (m_incumbent.load() == numeric_limits<int>::max()) {
+        currentState = State::DONE;
+        found = false;
+        return;
+    }
+
+    found = true;
+    currentState = State::TRACING_PATH;
+    tracePos = goal;
+}
+
+size_t HDAStar_Solver::getMemoryBytes() const {
+    return Solver::getMemoryBytes() + open.capacity() + gScore.capacity() * sizeof(int) +
+           inboxes.size() * sizeof(Inbox);
+}
@@ -0,0 +1,90 @@
+#ifndef HDASTAR_SOLVER_H
+#define HDASTAR_SOLVER_H
+
+#include "Solver.h"
+#include "Utils.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <SFML/System/Clock.hpp>
+
+// Hash-Distributed A* (Kishimoto, Fukunaga & Botea).
+// Every cell is owned by exactly one thread, picked by hashing its id. Each
+// thread runs A* on its own open list; a successor owned by another thread is
+// sent to it through that thread's lock-free inbox. The search ends when every
+// thread is idle and no message is in flight, at which point the incumbent
+// goal cost is optimal (the Manhattan heuristic is admissible).
+//
+// The whole parallel search runs inside the first step(); the following steps
+// trace the path like the other solvers.
+class HDAStar_Solver : public Solver {
+public:
+    // Per-thread counters, for load balance and messaging overhead
+    struct ThreadStats {
+        long long expanded = 0;      // Nodes popped and expanded
+        long long generated = 0;     // Successors produced
+        long long sent = 0;          // Successors sent to another thread
+        long long batchesSent = 0;   // Inbox pushes (messages are batched)
+        long long received = 0;      // Successors received from other threads
+        long long stale = 0;         // Pops/messages dropped as not improving
+        long long idleSpins = 0;     // Polls spent waiting for work
+    };
+
+    // threads == 0 means "one per hardware core"
+    explicit HDAStar_Solver(const Maze& maze, unsigned threads = 0);
+
+    void step() override;
+
+    // Performance HUD reading (see Solver.h); the whole search runs inside
+    // one step(), so there is no open set to sample between steps
+    std::size_t getMemoryBytes() const override;
+
+    unsigned getThreadCount() const { return m_pool.size(); }
+    const std::vector<ThreadStats>& getThreadStats() const { return m_stats; }
+
+private:
+    struct Message {
+        int id;      // Cell r * C + c
+        int g;       // Cost of reaching it through 'from'
+        int from;    // Parent cell id
+    };
+
+    // A block of messages pushed onto an inbox in one CAS
+    struct Batch {
+        Batch* next = nullptr;
+        std::vector<Message> msgs;
+    };
+
+    // Cache-line aligned so inbox heads of different threads don't share a line
+    struct alignas(64) Inbox {
+        std::atomic<Batch*> head{nullptr};
+    };
+
+    static constexpr std::size_t BATCH_SIZE = 64;   // Flush an outgoing buffer at this size
+    static constexpr int EXPANSIONS_PER_ROUND = 32; // Expansions between inbox polls
+
+    void search();
+    void worker(unsigned t);
+    unsigned owner(int id) const;
+    int heuristic(int id) const;
+    void push(unsigned to, Batch* batch);
+    void lowerIncumbent(int cost);
+
+    int R, C;
+    ThreadPool m_pool;
+
+    std::vector<std::uint8_t> open;   // Read-only wall map (1 = walkable)
+    std::vector<int> gScore;          // Only ever touched by the cell's owner
+    std::vector<Inbox> inboxes;
+
+    std::atomic<int> m_incumbent;     // Best goal cost found so far
+    std::atomic<long long> m_work;    // Busy threads + batches in flight; 0 means done
+
+    std::vector<ThreadStats> m_stats;
+
+    // Clock for timing the algorithm
+    sf::Clock m_clock;
+};
+
+#endif // HDASTAR_SOLVER_H
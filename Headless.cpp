@@ -0,0 +1,1618 @@
+#include "Headless.h"
+#include "Maze.h"
+#include "BFS_Solver.h"
+#include "ParallelBFS_Solver.h"
+#include "DeltaStepping_Solver.h"
+#include "AStar_Solver.h"
+#include "HDAStar_Solver.h"
+#include "TiledMaze.h"
+#include "ExternalBFS.h"
+#include "GreedyBestFirst_Solver.h"
+#include "Landmarks.h"
+#include "PathDatabase.h"
+#include "GoalBounds.h"
+#include "DFS_Solver.h"
+#include "Dijkstra_Solver.h"
+#include "ResultCache.h"
+#include "EventLog.h"
+#include "Checkpoint.h"
+#include "TerminalRenderer.h"
+#include "SearchWorkspace.h"
+#include "Benchmark.h"
+#include "InfiniteMaze.h"
+#include "OpenWorldSearch.h"
+#include "ARAStar_Solver.h"
+#include "AnytimeSearch.h"
+#include "FlowField.h"
+#include "CorridorGraph.h"
+#include "Corridor_Solver.h"
+#include "MazePruning.h"
+#include "BatchRunner.h"
+#include "CooperativeAStar.h"
+#include "Utils.h"
+#include <iostream>
+#include <SFML/System/Clock.hpp>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <limits>
+#include <cstdlib>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <memory>
+#include <future>
+#include <chrono>
+#include <map>
+#include <set>
+#include <algorithm>
+
+using namespace std;
+
+void runToCompletion(Solver& solver) {
+    {
+        TRACE_SCOPE("search");
+        while (solver.isSearching()) {
+            solver.step();
+        }
+    }
+    TRACE_SCOPE("trace path");
+    while (!solver.isFinished()) {
+        solver.step();
+    }
+}
+
+// Reads argv[index] as an int, or returns the fallback if it is missing
+static int intArg(int argc, char* argv[], int index, int fallback) {
+    return index < argc ? atoi(argv[index]) : fallback;
+}
+
+// Thread counts for a scaling sweep: 1, 2, 4, ... below maxThreads, then
+// maxThreads itself so the machine's full core count is always measured
+static vector<unsigned> threadCounts(unsigned maxThreads) {
+    vector<unsigned> counts;
+    for (unsigned t = 1; t < maxThreads; t *= 2) counts.push_back(t);
+    counts.push_back(max(1u, maxThreads));
+    return counts;
+}
+
+// Picks a uniformly random non-wall cell
+static pair<int, int> randomOpenCell(const Maze& maze, mt19937& rng) {
+    uniform_int_distribution<int> rowDist(0, (int)maze.grid.size() - 1);
+    uniform_int_distribution<int> colDist(0, (int)maze.grid[0].size() - 1);
+    while (true) {
+        pair<int, int> cell = {rowDist(rng), colDist(rng)};
+        if (maze.grid[cell.first][cell.second] != '#') return cell;
+    }
+}
+
+// The sequential solvers by short name, as used in headless reports
+static const vector<string> SOLVER_NAMES = {"BFS", "DFS", "A*", "Dijkstra", "Greedy"};
+
+static unique_ptr<Solver> makeSolver(const string& name, const Maze& maze) {
+    if (name == "BFS")      return make_unique<BFS_Solver>(maze);
+    if (name == "DFS")      return make_unique<DFS_Solver>(maze);
+    if (name == "A*")       return make_unique<AStar_Solver>(maze);
+    if (name == "Dijkstra") return make_unique<Dijkstra_Solver>(maze);
+    if (name == "Greedy")   return make_unique<GreedyBestFirst_Solver>(maze);
+    if (name == "ParallelBFS") return make_unique<ParallelBFS_Solver>(maze);
+    if (name == "HDA*")     return make_unique<HDAStar_Solver>(maze);
+    if (name == "ARA*")     return make_unique<ARAStar_Solver>(maze);
+    if (name == "Corridor") return make_unique<Corridor_Solver>(maze);
+    if (name == "DeltaStepping") return make_unique<DeltaStepping_Solver>(maze);
+    return nullptr;
+}
+
+static void printUsage() {
+    cout << "Usage: maze_visualizer <command> [args]\n"
+         << "  (no command)\n"
+         << "      open the visualizer window\n"
+         << "  bfs-scaling [rows] [cols] [seed] [threads]\n"
+         << "      parallel BFS speed-up per thread count, on the maze and on an open grid\n"
+         << "  hda [rows] [cols] [seed] [threads]\n"
+         << "      hash-distributed A* per-thread statistics\n"
+         << "  ext-bfs [rows] [cols] [seed] [workdir] [memory-entries]\n"
+         << "      out-of-core BFS over a disk-backed tile file\n"
+         << "  alt [rows] [cols] [seed] [landmarks] [queries]\n"
+         << "      A* and Greedy with Manhattan vs ALT landmark heuristics\n"
+         << "  cpd [rows] [cols] [seed] [queries] [threads]\n"
+         << "      build a compressed path database and time table-lookup queries\n"
+         << "  bounds [rows] [cols] [seed] [queries] [threads]\n"
+         << "      build/reload goal-bounding boxes and compare A* with and without them\n"
+         << "  cache [rows] [cols] [seed] [queries] [wall-changes] [disk-dir]\n"
+         << "      result cache hits, misses and invalidation after wall changes\n"
+         << "  record <algorithm> <file> [rows] [cols] [seed] [ring-bytes]\n"
+         << "      run a solver without a window and save its step events\n"
+         << "      (algorithms: BFS DFS A* Dijkstra Greedy ParallelBFS HDA* ARA* Corridor DeltaStepping)\n"
+         << "  checkpoint <algorithm> <file> [rows] [cols] [seed] [interval-ms]\n"
+         << "      snapshot a search periodically, stop it halfway, resume from the\n"
+         << "      last snapshot and check the result against an uninterrupted run\n"
+         << "      (algorithms: BFS DFS A* Dijkstra Greedy)\n"
+         << "  resume <file>\n"
+         << "      finish a search from a checkpoint file\n"
+         << "  watch [rows] [cols] [seed] [steps-per-frame] [fps]\n"
+         << "      run every solver and draw them live in the terminal (fps 0 = no limit)\n"
+         << "  workspace [rows] [cols] [seed] [queries]\n"
+         << "      per-query cost of a new Solver vs a reused SearchWorkspace\n"
+         << "  bench [--filter text] [--reps n] [--sizes RxC,...] [--densities d,...] [--seeds s,...]\n"
+         << "        [--counters] [--json file] [--baseline file] [--threshold percent]\n"
+         << "      microbenchmarks of the search kernels and solvers (exit code 2 on regressions)\n"
+         << "  infinite [seed] [density] [distance] [max-chunks] [max-expansions]\n"
+         << "      A* across an unbounded procedural maze, generated chunk by chunk\n"
+         << "  sparse [rows] [cols] [seed] [queries] [max-distance]\n"
+         << "      A* and Greedy with dense vs automatically chosen sparse bookkeeping\n"
+         << "  anytime [rows] [cols] [seed] [deadline-ms] [initial-epsilon]\n"
+         << "      ARA* improving its path until a deadline, then cancelled after its first path\n"
+         << "  flow [rows] [cols] [seed] [agents] [wall-changes]\n"
+         << "      steer many agents to the goal with one flow field, then update it after wall changes\n"
+         << "  corridor [rows] [cols] [seed] [wall-density] [queries]\n"
+         << "      contract corridors into a weighted graph and compare BFS, Dijkstra and A* on it\n"
+         << "  prune [rows] [cols] [seed] [wall-density] [queries]\n"
+         << "      nodes explored before and after dead-end filling and rectangular symmetry reduction\n"
+         << "  batch [--seeds a-b] [--sizes RxC,...] [--densities d,...] [--threads n] [--csv file] [--scaling]\n"
+         << "      solve a whole seed sweep on all cores; node, optimality gap and time distributions\n"
+         << "  delta [rows] [cols] [seed] [max-cost] [threads] [delta]\n"
+         << "      parallel delta-stepping on a weighted grid vs Dijkstra: delta and thread sweeps\n"
+         << "  goals [rows] [cols] [seed] [goals] [k]\n"
+         << "      nearest of many goals (and the k nearest) in one search vs one A* per goal\n"
+         << "  agents [rows] [cols] [seed] [agents] [window] [threads]\n"
+         << "      move many agents to their own goals with windowed cooperative A*, checking for collisions\n"
+         << "  replay <file>\n"
+         << "      open a recorded event log in the visualizer\n";
+}
+
+// Times ParallelBFS_Solver for 1..hardware_concurrency threads and checks
+// every run against the sequential BFS_Solver. Mazes keep the frontier too
+// small for the bottom-up sweep, so the same sweep also runs on an open grid
+// of the same size, where it takes over for the middle levels.
+static int bfsScaling(int argc, char* argv[]) {
+    int rows = intArg(argc, argv, 2, 2001);
+    int cols = intArg(argc, argv, 3, 2001);
+    unsigned seed = (unsigned)intArg(argc, argv, 4, 1);
+    unsigned maxThreads = (unsigned)intArg(argc, argv, 5, (int)thread::hardware_concurrency());
+    bool allMatch = true;
+
+    auto sweep = [&](const Maze& maze, const string& label) {
+        BFS_Solver reference(maze);
+        runToCompletion(reference);
+        double refMs = reference.getTimeTaken().asMicroseconds() / 1000.0;
+
+        cout << label << " " << maze.getRows() << " x " << maze.getCols() << ", seed " << seed << "\n";
+        cout << "BFS_Solver: " << fixed << setprecision(3) << refMs << " ms, path "
+             << (reference.wasPathFound() ? to_string(reference.getPathLength()) : "none") << "\n";
+        cout << setw(8) << "threads" << setw(14) << "time (ms)" << setw(10) << "speedup"
+             << setw(12) << "bottom-up" << setw(8) << "path" << "\n";
+
+        double baseMs = 0.0;
+        for (unsigned t : threadCounts(maxThreads)) {
+            ParallelBFS_Solver solver(maze, t);
+            runToCompletion(solver);
+
+            double ms = solver.getTimeTaken().asMicroseconds() / 1000.0;
+            if (t == 1) baseMs = ms;
+
+            bool match = solver.wasPathFound() == reference.wasPathFound() &&
+                         solver.getPathLength() == reference.getPathLength();
+            allMatch = allMatch && match;
+
+            cout << setw(8) << t << setw(14) << ms << setw(10) << (ms > 0 ? baseMs / ms : 0.0)
+                 << setw(12) << solver.getBottomUpLevels()
+                 << setw(8) << (match ? "ok" : "DIFF") << "\n";
+        }
+        cout << "\n";
+    };
+
+    sweep(Maze(rows, cols, seed), "Maze");
+
+    // Corner to corner, so the search covers the whole grid
+    Maze open(rows, cols, seed, 0);
+    open.setStartGoal({1, 1}, {open.getRows() - 2, open.getCols() - 2});
+    sweep(open, "Open grid");
+    return allMatch ? 0 : 1;
+}
+
+// Runs HDAStar_Solver once, checks optimality against AStar_Solver and prints
+// per-thread load balance and messaging counters
+static int hdaStats(int argc, char* argv[]) {
+    int rows = intArg(argc, argv, 2, 1001);
+    int cols = intArg(argc, argv, 3, 1001);
+    unsigned seed = (unsigned)intArg(argc, argv, 4, 1);
+    unsigned threads = (unsigned)max(0, intArg(argc, argv, 5, 0));
+
+    Maze maze(rows, cols, seed);
+
+    AStar_Solver reference(maze);
+    runToCompletion(reference);
+
+    HDAStar_Solver solver(maze, threads);
+    runToCompletion(solver);
+
+    cout << "Maze " << maze.getRows() << " x " << maze.getCols() << ", seed " << seed
+         << ", " << solver.getThreadCount() << " threads\n";
+    cout << "AStar_Solver: " << fixed << setprecision(3)
+         << reference.getTimeTaken().asMicroseconds() / 1000.0 << " ms, "
+         << reference.getNodesExplored() << " nodes, path "
+         << (reference.wasPathFound() ? to_string(reference.getPathLength()) : "none") << "\n";
+    cout << "HDA*:         " << solver.getTimeTaken().asMicroseconds() / 1000.0 << " ms, "
+         << solver.getNodesExplored() << " nodes, path "
+         << (solver.wasPathFound() ? to_string(solver.getPathLength()) : "none") << "\n\n";
+
+    cout << setw(7) << "thread" << setw(11) << "expanded" << setw(11) << "generated"
+         << setw(10) << "sent" << setw(9) << "batches" << setw(10) << "received"
+         << setw(9) << "stale" << setw(11) << "idle" << "\n";
+
+    long long totalGenerated = 0, totalSent = 0;
+    const auto& stats = solver.getThreadStats();
+    for (size_t t = 0; t < stats.size(); ++t) {
+        const auto& s = stats[t];
+        totalGenerated += s.generated;
+        totalSent += s.sent;
+        cout << setw(7) << t << setw(11) << s.expanded << setw(11) << s.generated
+             << setw(10) << s.sent << setw(9) << s.batchesSent << setw(10) << s.received
+             << setw(9) << s.stale << setw(11) << s.idleSpins << "\n";
+    }
+    if (totalGenerated > 0) {
+        cout << "\nSuccessors sent to another thread: " << setprecision(1)
+             << 100.0 * totalSent / totalGenerated << "%\n";
+    }
+
+    bool match = solver.wasPathFound() == reference.wasPathFound() &&
+                 solver.getPathLength() == reference.getPathLength();
+    cout << "Optimal: " << (match ? "yes" : "NO") << "\n";
+    return match ? 0 : 1;
+}
+
+// Streams a maze to a tile file, runs ExternalBFS over it and, when the maze
+// is small enough to hold in memory, checks the result against BFS_Solver
+static int externalBfs(int argc, char* argv[]) {
+    long long rows = intArg(argc, argv, 2, 4001);
+    long long cols = intArg(argc, argv, 3, 4001);
+    unsigned seed = (unsigned)intArg(argc, argv, 4, 1);
+    string workDir = argc > 5 ? argv[5] : "ext_bfs_work";
+    size_t memoryEntries = (size_t)max(1024, intArg(argc, argv, 6, 1 << 22));
+
+    string tilePath = workDir + "/maze.tiles";
+    ExternalBFS::Result result;
+    filesystem::create_directories(workDir);
+    TiledMaze::generate(tilePath, rows, cols, seed);
+    TiledMaze maze(tilePath);
+    {
+        ExternalBFS bfs(maze, workDir, memoryEntries);
+        result = bfs.run();
+    }
+
+    cout << "Maze " << maze.getRows() << " x " << maze.getCols() << ", seed " << seed
+         << ", buffer " << memoryEntries << " entries\n";
+    cout << fixed << setprecision(3)
+         << "ExternalBFS: " << result.timeTaken.asMicroseconds() / 1000.0 << " ms, "
+         << result.levels << " levels, largest layer " << result.maxLayerSize << ", path "
+         << (result.found ? to_string(result.path.size()) : "none") << "\n";
+    cout << setprecision(1)
+         << "I/O: " << result.bytesRead / 1048576.0 << " MiB read, "
+         << result.bytesWritten / 1048576.0 << " MiB written, "
+         << maze.getTileLoads() << " tile loads\n";
+
+    int exitCode = 0;
+    if (rows * cols <= 25000000LL) {
+        Maze inMemory((int)rows, (int)cols, seed);
+        BFS_Solver reference(inMemory);
+        runToCompletion(reference);
+        bool match = reference.wasPathFound() == result.found &&
+                     (!result.found || reference.getPathLength() == (int)result.path.size());
+        cout << "BFS_Solver path " << (reference.wasPathFound() ? to_string(reference.getPathLength()) : "none")
+             << ": " << (match ? "match" : "MISMATCH") << "\n";
+        exitCode = match ? 0 : 1;
+    }
+
+    remove(tilePath.c_str());
+    return exitCode;
+}
+
+// Builds (or reloads) landmark tables for a maze and compares nodes explored
+// by A* and Greedy with and without them over random start/goal queries
+static int altCompare(int argc, char* argv[]) {
+    int rows = intArg(argc, argv, 2, 301);
+    int cols = intArg(argc, argv, 3, 301);
+    unsigned seed = (unsigned)intArg(argc, argv, 4, 1);
+    int k = intArg(argc, argv, 5, 8);
+    int queries = intArg(argc, argv, 6, 100);
+
+    Maze maze(rows, cols, seed);
+
+    // Tables are saved alongside the maze and reused on the next run
+    string path = "maze_" + to_string(rows) + "x" + to_string(cols) + "_" + to_string(seed) + ".landmarks";
+    Landmarks landmarks;
+    sf::Clock clock;
+    bool loaded = landmarks.load(path, maze) && landmarks.getCount() == k;
+    if (!loaded) {
+        landmarks = Landmarks::build(maze, k);
+        landmarks.save(path);
+    }
+    double prepMs = clock.getElapsedTime().asMicroseconds() / 1000.0;
+
+    cout << "Maze " << maze.getRows() << " x " << maze.getCols() << ", seed " << seed << ": "
+         << landmarks.getCount() << " landmarks " << (loaded ? "loaded from " : "built and saved to ")
+         << path << " in " << fixed << setprecision(1) << prepMs << " ms\n";
+
+    long long nodes[4] = {0, 0, 0, 0}; // A*, A*+ALT, Greedy, Greedy+ALT
+    long long greedyLength[2] = {0, 0};
+    bool optimal = true;
+    mt19937 rng(seed);
+
+    for (int q = 0; q < queries; ++q) {
+        pair<int, int> s = randomOpenCell(maze, rng), g;
+        do { g = randomOpenCell(maze, rng); } while (g == s);
+        maze.setStartGoal(s, g);
+
+        AStar_Solver plain(maze), alt(maze, &landmarks);
+        GreedyBestFirst_Solver greedy(maze), greedyAlt(maze, &landmarks);
+        runToCompletion(plain);
+        runToCompletion(alt);
+        runToCompletion(greedy);
+        runToCompletion(greedyAlt);
+
+        nodes[0] += plain.getNodesExplored();
+        nodes[1] += alt.getNodesExplored();
+        nodes[2] += greedy.getNodesExplored();
+        nodes[3] += greedyAlt.getNodesExplored();
+        greedyLength[0] += greedy.getPathLength();
+        greedyLength[1] += greedyAlt.getPathLength();
+        optimal = optimal && plain.getPathLength() == alt.getPathLength();
+    }
+
+    cout << "Over " << queries << " random queries (total nodes explored):\n"
+         << "  A*      Manhattan " << setw(10) << nodes[0] << "   ALT " << setw(10) << nodes[1]
+         << "   (" << setprecision(2) << (nodes[1] ? (double)nodes[0] / nodes[1] : 0.0) << "x fewer)\n"
+         << "  Greedy  Manhattan " << setw(10) << nodes[2] << "   ALT " << setw(10) << nodes[3]
+         << "   (path nodes " << greedyLength[0] << " vs " << greedyLength[1] << ")\n"
+         << "A* paths identical: " << (optimal ? "yes" : "NO") << "\n";
+    return optimal ? 0 : 1;
+}
+
+// Builds a compressed path database on all cores, saves and reloads it, then
+// answers random queries by table lookups and checks them against BFS_Solver
+static int pathDatabase(int argc, char* argv[]) {
+    int rows = intArg(argc, argv, 2, 101);
+    int cols = intArg(argc, argv, 3, 101);
+    unsigned seed = (unsigned)intArg(argc, argv, 4, 1);
+    int queries = intArg(argc, argv, 5, 200);
+    unsigned threads = (unsigned)max(0, intArg(argc, argv, 6, 0));
+
+    Maze maze(rows, cols, seed);
+    string path = "maze_" + to_string(rows) + "x" + to_string(cols) + "_" + to_string(seed) + ".cpd";
+
+    PathDatabase db;
+    sf::Clock clock;
+    bool loaded = db.load(path, maze);
+    if (!loaded) {
+        db = PathDatabase::build(maze, threads);
+        db.save(path);
+    }
+    double prepMs = clock.getElapsedTime().asMicroseconds() / 1000.0;
+
+    cout << "Maze " << maze.getRows() << " x " << maze.getCols() << ", seed " << seed << ": "
+         << (loaded ? "loaded " : "built and saved ") << path << " in " << fixed << setprecision(1)
+         << prepMs << " ms\n"
+         << "  " << db.getSourceCount() << " sources, " << db.getRunCount() << " runs ("
+         << setprecision(1) << (double)db.getRunCount() / max<size_t>(1, db.getSourceCount())
+         << " per source), " << db.getSizeBytes() / 1024 << " KiB\n";
+
+    mt19937 rng(seed);
+    double lookupUs = 0.0, searchUs = 0.0;
+    bool allMatch = true;
+
+    for (int q = 0; q < queries; ++q) {
+        pair<int, int> s = randomOpenCell(maze, rng), g;
+        do { g = randomOpenCell(maze, rng); } while (g == s);
+        maze.setStartGoal(s, g);
+
+        clock.restart();
+        vector<pair<int, int>> cells = db.path(s, g);
+        lookupUs += clock.getElapsedTime().asMicroseconds();
+
+        BFS_Solver reference(maze);
+        clock.restart();
+        runToCompletion(reference);
+        searchUs += clock.getElapsedTime().asMicroseconds();
+
+        bool match = reference.wasPathFound() == !cells.empty() &&
+                     (cells.empty() || reference.getPathLength() == (int)cells.size());
+        allMatch = allMatch && match;
+    }
+
+    cout << "Over " << queries << " random queries: lookup " << setprecision(2)
+         << lookupUs / max(1, queries) << " us, BFS_Solver " << searchUs / max(1, queries)
+         << " us per query\n"
+         << "Paths optimal: " << (allMatch ? "yes" : "NO") << "\n";
+    return allMatch ? 0 : 1;
+}
+
+// Builds goal-bounding boxes on all cores (or reloads them from next to the
+// maze) and compares A* with and without them over random queries
+static int goalBounding(int argc, char* argv[]) {
+    int rows = intArg(argc, argv, 2, 101);
+    int cols = intArg(argc, argv, 3, 101);
+    unsigned seed = (unsigned)intArg(argc, argv, 4, 1);
+    int queries = intArg(argc, argv, 5, 200);
+    unsigned threads = (unsigned)max(0, intArg(argc, argv, 6, 0));
+
+    Maze maze(rows, cols, seed);
+    string path = "maze_" + to_string(rows) + "x" + to_string(cols) + "_" + to_string(seed) + ".bounds";
+
+    GoalBounds bounds;
+    sf::Clock clock;
+    bool loaded = bounds.load(path, maze);
+    if (!loaded) {
+        bounds = GoalBounds::build(maze, threads);
+        bounds.save(path);
+    }
+    double prepMs = clock.getElapsedTime().asMicroseconds() / 1000.0;
+
+    cout << "Maze " << maze.getRows() << " x " << maze.getCols() << ", seed " << seed << ": "
+         << (loaded ? "loaded " : "built and saved ") << path << " in " << fixed << setprecision(1)
+         << prepMs << " ms\n"
+         << "  " << bounds.getCellCount() << " open cells, " << bounds.getSizeBytes() / 1024 << " KiB ("
+         << setprecision(1) << (double)bounds.getSizeBytes() / max<size_t>(1, bounds.getCellCount())
+         << " bytes per cell)\n";
+
+    mt19937 rng(seed);
+    long long nodes[2] = {0, 0};
+    long long pruned = 0;
+    double us[2] = {0.0, 0.0};
+    bool optimal = true;
+
+    for (int q = 0; q < queries; ++q) {
+        pair<int, int> s = randomOpenCell(maze, rng), g;
+        do { g = randomOpenCell(maze, rng); } while (g == s);
+        maze.setStartGoal(s, g);
+
+        // One at a time: each solver's clock starts in its constructor
+        AStar_Solver plain(maze);
+        runToCompletion(plain);
+        AStar_Solver bounded(maze, nullptr, CellStorage::Auto, nullptr, &bounds);
+        runToCompletion(bounded);
+        nodes[0] += plain.getNodesExplored();
+        nodes[1] += bounded.getNodesExplored();
+        us[0] += plain.getTimeTaken().asMicroseconds();
+        us[1] += bounded.getTimeTaken().asMicroseconds();
+        pruned += bounded.getMovesPruned();
+        optimal = optimal && plain.wasPathFound() == bounded.wasPathFound() &&
+                  plain.getPathLength() == bounded.getPathLength();
+    }
+
+    cout << "Over " << queries << " random queries (total nodes explored, mean time):\n"
+         << "  A*                 " << setw(10) << nodes[0] << setw(10) << setprecision(2)
+         << us[0] / max(1, queries) << " us\n"
+         << "  A* + goal bounds   " << setw(10) << nodes[1] << setw(10) << us[1] / max(1, queries)
+         << " us   (" << (nodes[1] ? (double)nodes[0] / nodes[1] : 0.0) << "x fewer, "
+         << pruned << " moves pruned)\n"
+         << "A* paths identical: " << (optimal ? "yes" : "NO") << "\n";
+    return optimal ? 0 : 1;
+}
+
+// Runs random queries through a ResultCache three times: cold, warm, and after
+// toggling some walls. Every hit that survives a wall change is re-checked
+// against a fresh run.
+static int resultCache(int argc, char* argv[]) {
+    int rows = intArg(argc, argv, 2, 201);
+    int cols = intArg(argc, argv, 3, 201);
+    unsigned seed = (unsigned)intArg(argc, argv, 4, 1);
+    int queries = intArg(argc, argv, 5, 50);
+    int changes = intArg(argc, argv, 6, 5);
+    string diskDir = argc > 7 ? argv[7] : "";
+
+    Maze maze(rows, cols, seed);
+    ResultCache cache(64u << 20, diskDir);
+    mt19937 rng(seed);
+
+    vector<pair<pair<int, int>, pair<int, int>>> qs;
+    for (int q = 0; q < queries; ++q) {
+        pair<int, int> s = randomOpenCell(maze, rng), g;
+        do { g = randomOpenCell(maze, rng); } while (g == s);
+        qs.push_back({s, g});
+    }
+
+    bool allMatch = true;
+    // verifyHits re-runs the solver on a hit and compares it with the entry
+    auto runPass = [&](const char* label, bool verifyHits) {
+        ResultCache::Stats before = cache.getStats();
+        sf::Clock clock;
+        for (auto [s, g] : qs) {
+            maze.setStartGoal(s, g);
+            for (const string& name : SOLVER_NAMES) {
+                const ResultCache::Entry* hit = cache.find(maze, name);
+                if (hit && !verifyHits) continue;
+
+                auto solver = makeSolver(name, maze);
+                runToCompletion(*solver);
+                if (!hit) {
+                    cache.store(maze, name, *solver);
+                    continue;
+                }
+                bool match = hit->pathLength == solver->getPathLength() &&
+                             hit->nodesExplored == solver->getNodesExplored();
+                allMatch = allMatch && match;
+            }
+        }
+        const ResultCache::Stats& after = cache.getStats();
+        cout << setw(14) << label << setw(8) << after.hits - before.hits
+             << setw(8) << after.misses - before.misses << setw(12)
+             << fixed << setprecision(1) << clock.getElapsedTime().asMicroseconds() / 1000.0 << "\n";
+    };
+
+    cout << "Maze " << maze.getRows() << " x " << maze.getCols() << ", " << queries << " queries x "
+         << SOLVER_NAMES.size() << " algorithms" << (diskDir.empty() ? "" : ", disk tier " + diskDir) << "\n";
+    cout << setw(14) << "pass" << setw(8) << "hits" << setw(8) << "misses" << setw(12) << "time (ms)" << "\n";
+    runPass("cold", false);
+    runPass("warm", false);
+
+    // Toggle random interior cells that are not query endpoints
+    uint64_t oldHash = maze.wallFingerprint();
+    vector<pair<int, int>> changed;
+    uniform_int_distribution<int> rowDist(1, (int)maze.grid.size() - 2);
+    uniform_int_distribution<int> colDist(1, (int)maze.grid[0].size() - 2);
+    maze.setStartGoal(qs[0].first, qs[0].second);
+    while ((int)changed.size() < changes) {
+        pair<int, int> cell = {rowDist(rng), colDist(rng)};
+        bool endpoint = false;
+        for (auto [s, g] : qs) endpoint = endpoint || cell == s || cell == g;
+        if (endpoint) continue;
+        char& ch = maze.grid[cell.first][cell.second];
+        if (ch != '#' && ch != ' ') continue;
+        ch = ch == '#' ? ' ' : '#';
+        changed.push_back(cell);
+    }
+    cache.wallsChanged(oldHash, maze, changed);
+    cout << "Toggled " << changes << " walls: " << cache.getStats().invalidated << " entries invalidated, "
+         << cache.getStats().carried << " carried over\n";
+    runPass("after change", true);
+
+    const ResultCache::Stats& st = cache.getStats();
+    cout << "Totals: " << st.hits << " hits (" << st.diskHits << " from disk), " << st.misses
+         << " misses, " << st.evictions << " evictions, " << cache.getEntryCount() << " entries, "
+         << cache.getBytesUsed() / 1024 << " KiB\n"
+         << "Carried entries exact: " << (allMatch ? "yes" : "NO") << "\n";
+    return allMatch ? 0 : 1;
+}
+
+// Runs one solver to completion with an EventLog attached and saves the log
+// for later replay (`maze_visualizer replay <file>`)
+static int recordEvents(int argc, char* argv[]) {
+    if (argc < 4) {
+        printUsage();
+        return 1;
+    }
+    string name = argv[2];
+    string path = argv[3];
+    int rows = intArg(argc, argv, 4, 31);
+    int cols = intArg(argc, argv, 5, 51);
+    unsigned seed = (unsigned)intArg(argc, argv, 6, 1);
+    size_t ringBytes = (size_t)max(0, intArg(argc, argv, 7, 0));
+
+    Maze maze(rows, cols, seed);
+    auto solver = makeSolver(name, maze);
+    if (!solver) {
+        cerr << "Unknown algorithm '" << name << "'\n";
+        return 1;
+    }
+
+    EventLog log((int)maze.grid.size(), (int)maze.grid[0].size(), name, ringBytes);
+    log.setMaze(maze);
+    solver->setEventLog(&log);
+
+    sf::Clock clock;
+    while (!solver->isFinished()) {
+        solver->step();
+        log.endStep();
+    }
+    double runMs = clock.getElapsedTime().asMicroseconds() / 1000.0;
+
+    if (!log.save(path)) {
+        cerr << "Could not write '" << path << "'\n";
+        return 1;
+    }
+
+    cout << name << " on " << maze.getRows() << " x " << maze.getCols() << " (seed " << seed << "): "
+         << log.getStepCount() << " steps, " << log.getEventCount() << " events, "
+         << log.getSizeBytes() << " bytes (" << fixed << setprecision(2)
+         << (double)log.getSizeBytes() / max(1LL, log.getEventCount()) << " per event) in "
+         << setprecision(1) << runMs << " ms -> " << path << "\n";
+    if (log.getFirstStep() > 0) {
+        cout << "Ring buffer kept steps " << log.getFirstStep() << ".." << log.getStepCount() << "\n";
+    }
+    return 0;
+}
+
+// Runs a solver once straight through, then again with periodic snapshots,
+// "crashes" it halfway and resumes from the last snapshot. The resumed run
+// must end with the same grid and statistics as the uninterrupted one.
+static int checkpointResume(int argc, char* argv[]) {
+    if (argc < 4) {
+        printUsage();
+        return 1;
+    }
+    string name = argv[2];
+    string path = argv[3];
+    int rows = intArg(argc, argv, 4, 301);
+    int cols = intArg(argc, argv, 5, 501);
+    unsigned seed = (unsigned)intArg(argc, argv, 6, 1);
+    int intervalMs = max(0, intArg(argc, argv, 7, 5));
+
+    Maze maze(rows, cols, seed);
+    auto reference = makeSolver(name, maze);
+    if (!reference || find(SOLVER_NAMES.begin(), SOLVER_NAMES.end(), name) == SOLVER_NAMES.end()) {
+        cerr << "Algorithm '" << name << "' can't be checkpointed\n";
+        return 1;
+    }
+    long long totalSteps = 0;
+    while (!reference->isFinished()) {
+        reference->step();
+        ++totalSteps;
+    }
+
+    // Interrupted run: snapshots every interval, abandoned at the halfway step
+    auto solver = makeSolver(name, maze);
+    Checkpoint checkpoint(path, sf::milliseconds(intervalMs));
+    long long savedAt = -1;
+    for (long long stepIndex = 1; stepIndex <= totalSteps / 2; ++stepIndex) {
+        solver->step();
+        if (checkpoint.update(*solver)) savedAt = stepIndex;
+    }
+    if (savedAt < 0) {
+        // Interval longer than the run: take the one snapshot at the crash point
+        if (!Checkpoint::save(*solver, path)) {
+            cerr << "Could not write '" << path << "'\n";
+            return 1;
+        }
+        savedAt = totalSteps / 2;
+    }
+    solver.reset();
+
+    unique_ptr<Solver> resumed = Checkpoint::load(path);
+    if (!resumed) {
+        cerr << "Could not read '" << path << "'\n";
+        return 1;
+    }
+    runToCompletion(*resumed);
+
+    bool same = resumed->getGrid() == reference->getGrid()
+             && resumed->getNodesExplored() == reference->getNodesExplored()
+             && resumed->getPathLength() == reference->getPathLength();
+
+    cout << name << " on " << maze.getRows() << " x " << maze.getCols() << " (seed " << seed << "): "
+         << totalSteps << " steps, stopped at " << totalSteps / 2 << ", resumed from step " << savedAt << "\n"
+         << "Snapshots: " << max(1, checkpoint.getSaveCount()) << ", "
+         << (uintmax_t)filesystem::file_size(path) << " bytes, " << fixed << setprecision(1)
+         << checkpoint.getTimeSpent().asMicroseconds() / 1000.0 << " ms spent saving\n"
+         << "Explored " << resumed->getNodesExplored() << " / " << reference->getNodesExplored()
+         << ", path " << resumed->getPathLength() << " / " << reference->getPathLength()
+         << " (resumed / uninterrupted): " << (same ? "identical" : "MISMATCH") << "\n";
+    return same ? 0 : 1;
+}
+
+// Loads a checkpoint and runs the search to the end
+static int resumeCheckpoint(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+    unique_ptr<Solver> solver = Checkpoint::load(argv[2]);
+    if (!solver) {
+        cerr << "Could not read '" << argv[2] << "'\n";
+        return 1;
+    }
+    runToCompletion(*solver);
+
+    cout << "Resumed " << solver->getSymbol() << " search: " << (solver->getPathLength() > 0 ? "found" : "no path")
+         << ", path " << solver->getPathLength() << ", explored " << solver->getNodesExplored()
+         << ", total time " << fixed << setprecision(1)
+         << solver->getTimeTaken().asMicroseconds() / 1000.0 << " ms\n";
+    return 0;
+}
+
+// Steps all solvers together and draws them with TerminalRenderer, which
+// only sends the cells that changed since the previous frame
+static int watchSolvers(int argc, char* argv[]) {
+    int rows = intArg(argc, argv, 2, 21);
+    int cols = intArg(argc, argv, 3, 31);
+    unsigned seed = (unsigned)intArg(argc, argv, 4, 1);
+    int stepsPerFrame = max(1, intArg(argc, argv, 5, 1));
+    int fps = max(0, intArg(argc, argv, 6, 60));
+
+    Maze maze(rows, cols, seed);
+    vector<string> names = SOLVER_NAMES;
+    names.push_back("ParallelBFS");
+    names.push_back("HDA*");
+    names.push_back("ARA*");
+    names.push_back("Corridor");
+    names.push_back("DeltaStepping");
+    vector<unique_ptr<Solver>> solvers;
+    for (const string& name : names) solvers.push_back(makeSolver(name, maze));
+
+    vector<vector<string>> grids(solvers.size());
+    vector<string> titles(solvers.size());
+    sf::Clock total;
+    double fullFrameBytes = 0;
+    int frames = 0;
+    long long bytesWritten = 0;
+    {
+        TerminalRenderer renderer;
+        bool running = true;
+        while (running) {
+            sf::Clock frame;
+            running = false;
+            for (size_t i = 0; i < solvers.size(); ++i) {
+                Solver& solver = *solvers[i];
+                for (int s = 0; s < stepsPerFrame && !solver.isFinished(); ++s) solver.step();
+                running |= !solver.isFinished();
+                grids[i] = solver.getGrid();
+                titles[i] = names[i] + ": " + to_string(solver.getNodesExplored())
+                          + (solver.isFinished() ? (solver.getPathLength() > 0 ? " done" : " no path") : "");
+            }
+            renderer.setStatus("frame " + to_string(renderer.getFrames() + 1) + ", "
+                               + to_string(renderer.getBytesWritten()) + " bytes sent");
+            renderer.draw(grids, titles);
+
+            if (fps > 0) {
+                sf::Time left = sf::seconds(1.0f / fps) - frame.getElapsedTime();
+                if (left > sf::Time::Zero) sleep_ms(left.asMilliseconds());
+            }
+        }
+        frames = renderer.getFrames();
+        bytesWritten = (long long)renderer.getBytesWritten();
+        // A full repaint sends every panel cell once, plus a colour code per cell
+        for (const auto& g : grids) fullFrameBytes += g.size() * (g.empty() ? 0 : g[0].size()) * 12.0;
+    }
+
+    double seconds = total.getElapsedTime().asSeconds();
+    cout << frames << " frames in " << fixed << setprecision(2) << seconds << " s ("
+         << setprecision(1) << frames / max(seconds, 1e-6) << " fps), "
+         << bytesWritten / max(1, frames) << " bytes per frame on average (about "
+         << (long long)fullFrameBytes << " for a full colour repaint)\n";
+    return 0;
+}
+
+// Runs the same random queries through fresh Solver objects and through one
+// reused SearchWorkspace, checks they agree and compares the time per query
+static int workspaceQueries(int argc, char* argv[]) {
+    int rows = intArg(argc, argv, 2, 301);
+    int cols = intArg(argc, argv, 3, 501);
+    unsigned seed = (unsigned)intArg(argc, argv, 4, 1);
+    int queries = max(1, intArg(argc, argv, 5, 200));
+
+    Maze maze(rows, cols, seed);
+    mt19937 rng(seed);
+    vector<pair<pair<int, int>, pair<int, int>>> pairs(queries);
+    for (auto& q : pairs) q = {randomOpenCell(maze, rng), randomOpenCell(maze, rng)};
+
+    const SearchWorkspace::Algorithm algorithms[] = {
+        SearchWorkspace::Algorithm::BFS, SearchWorkspace::Algorithm::DFS, SearchWorkspace::Algorithm::AStar,
+        SearchWorkspace::Algorithm::Dijkstra, SearchWorkspace::Algorithm::Greedy};
+
+    SearchWorkspace workspace(maze);
+    cout << queries << " queries on " << maze.getRows() << " x " << maze.getCols() << " (seed " << seed << ")\n"
+         << left << setw(10) << "Algorithm" << right << setw(14) << "Solver us/q"
+         << setw(16) << "Workspace us/q" << setw(10) << "Speed-up" << "  Results\n";
+
+    bool allSame = true;
+    for (size_t a = 0; a < SOLVER_NAMES.size(); ++a) {
+        const string& name = SOLVER_NAMES[a];
+        vector<pair<int, int>> expected(queries); // (pathLength, nodesExplored)
+
+        Maze query = maze;
+        sf::Clock clock;
+        for (int i = 0; i < queries; ++i) {
+            query.setStartGoal(pairs[i].first, pairs[i].second);
+            auto solver = makeSolver(name, query);
+            runToCompletion(*solver);
+            expected[i] = {solver->wasPathFound() ? solver->getPathLength() : 0, solver->getNodesExplored()};
+        }
+        double solverUs = clock.getElapsedTime().asMicroseconds() / (double)queries;
+
+        clock.restart();
+        int mismatches = 0;
+        for (int i = 0; i < queries; ++i) {
+            SearchWorkspace::Result result = workspace.solve(algorithms[a], pairs[i].first, pairs[i].second);
+            if (make_pair(result.pathLength, result.nodesExplored) != expected[i]) ++mismatches;
+        }
+        double workspaceUs = clock.getElapsedTime().asMicroseconds() / (double)queries;
+        allSame = allSame && mismatches == 0;
+
+        cout << left << setw(10) << name << right << fixed << setprecision(1)
+             << setw(14) << solverUs << setw(16) << workspaceUs
+             << setw(9) << solverUs / max(workspaceUs, 0.001) << "x  "
+             << (mismatches == 0 ? "identical" : to_string(mismatches) + " MISMATCHES") << "\n";
+    }
+    cout << "Workspace keeps " << workspace.getBytesReserved() / 1024 << " KB between queries, "
+         << workspace.getFullClears() << " full clears in " << workspace.getQueries() << " queries\n";
+    return allSame ? 0 : 1;
+}
+
+// Searches from (0, 0) to a goal 'distance' rows away (and a third of that
+// across) in an unbounded maze, then repeats with a tiny chunk cache to show
+// evicted chunks regenerate identically
+static int infiniteMaze(int argc, char* argv[]) {
+    unsigned seed = (unsigned)intArg(argc, argv, 2, 1);
+    int density = intArg(argc, argv, 3, 25);
+    long long distance = max(1, intArg(argc, argv, 4, 2000));
+    size_t maxChunks = (size_t)max(1, intArg(argc, argv, 5, 4096));
+    uint64_t maxExpansions = (uint64_t)max(1, intArg(argc, argv, 6, 20000000));
+
+    OpenWorldSearch::Cell start = {0, 0};
+    OpenWorldSearch::Cell goal = {distance, -distance / 3};
+
+    OpenWorldSearch::Result results[2];
+    for (int run = 0; run < 2; ++run) {
+        size_t cache = run == 0 ? maxChunks : 16;
+        InfiniteMaze maze(seed, density, cache);
+        maze.keepOpen(start.first, start.second);
+        maze.keepOpen(goal.first, goal.second);
+
+        sf::Clock clock;
+        OpenWorldSearch::Result& result = results[run];
+        result = OpenWorldSearch(maze).search(start, goal, maxExpansions);
+        double ms = clock.getElapsedTime().asMicroseconds() / 1000.0;
+
+        // Every step must be to an adjacent open cell
+        bool valid = result.found;
+        for (size_t i = 0; valid && i < result.path.size(); ++i) {
+            auto [r, c] = result.path[i];
+            valid = maze.generatedOpen(r, c) || result.path[i] == start || result.path[i] == goal;
+            if (i > 0) {
+                valid = valid && llabs(r - result.path[i - 1].first) + llabs(c - result.path[i - 1].second) == 1;
+            }
+        }
+
+        cout << (run == 0 ? "" : "Again with a 16-chunk cache:\n")
+             << "(0, 0) -> (" << goal.first << ", " << goal.second << "), seed " << seed
+             << ", density " << density << "%: ";
+        if (result.found) {
+            cout << "distance " << result.distance << (valid ? " (path checked)" : " (INVALID PATH)");
+        } else {
+            cout << (result.budgetExhausted ? "gave up after the expansion budget" : "unreachable");
+        }
+        cout << " in " << fixed << setprecision(1) << ms << " ms\n"
+             << "  " << result.expanded << " expanded, " << result.touched << " cells touched, "
+             << result.bookkeepingBytes / 1024 << " KB search state\n"
+             << "  " << maze.getChunksGenerated() << " chunks generated, " << maze.getEvictions()
+             << " evicted, " << maze.getResidentChunks() << " resident ("
+             << maze.getResidentBytes() / 1024 << " KB)\n";
+        if (result.found && !valid) return 1;
+    }
+
+    if (results[0].found != results[1].found || results[0].distance != results[1].distance) {
+        cout << "MISMATCH between cache sizes\n";
+        return 1;
+    }
+    return 0;
+}
+
+static const char* storageName(CellStorage storage) {
+    switch (storage) {
+        case CellStorage::Dense: return "dense";
+        case CellStorage::Paged: return "paged";
+        case CellStorage::Hash:  return "hash";
+        default:                 return "auto";
+    }
+}
+
+// Short queries on a large maze: the dense R x C visited/parent/gScore arrays
+// cost far more than the search itself, the sparse backends scale with the
+// cells the search touches
+static int sparseStorage(int argc, char* argv[]) {
+    int rows = intArg(argc, argv, 2, 2001);
+    int cols = intArg(argc, argv, 3, 2001);
+    unsigned seed = (unsigned)intArg(argc, argv, 4, 1);
+    int queries = max(1, intArg(argc, argv, 5, 20));
+    int maxDistance = max(1, intArg(argc, argv, 6, 100));
+
+    Maze maze(rows, cols, seed);
+    mt19937 rng(seed);
+
+    // Goals within maxDistance of the start, so searches stay local
+    vector<pair<pair<int, int>, pair<int, int>>> pairs;
+    while ((int)pairs.size() < queries) {
+        pair<int, int> from = randomOpenCell(maze, rng);
+        uniform_int_distribution<int> offset(-maxDistance, maxDistance);
+        pair<int, int> to = {from.first + offset(rng), from.second + offset(rng)};
+        if (!isInside(maze.grid, to.first, to.second) || maze.grid[to.first][to.second] == '#' || to == from) continue;
+        pairs.push_back({from, to});
+    }
+
+    cout << queries << " queries within " << maxDistance << " cells on " << maze.getRows() << " x "
+         << maze.getCols() << " (seed " << seed << ")\n"
+         << left << setw(10) << "Algorithm" << setw(8) << "Storage" << right << setw(12) << "ms/query"
+         << setw(14) << "KB/query" << "  Results\n";
+
+    bool allSame = true;
+    for (const string& name : {string("A*"), string("Greedy")}) {
+        vector<pair<int, int>> expected(queries);
+        for (CellStorage storage : {CellStorage::Dense, CellStorage::Auto}) {
+            Maze query = maze;
+            map<CellStorage, int> chosen;
+            size_t bytes = 0;
+            int mismatches = 0;
+            sf::Clock clock;
+            for (int i = 0; i < queries; ++i) {
+                query.setStartGoal(pairs[i].first, pairs[i].second);
+                unique_ptr<Solver> solver;
+                if (name == "A*") {
+                    auto astar = make_unique<AStar_Solver>(query, nullptr, storage);
+                    runToCompletion(*astar);
+                    bytes += astar->getStorageBytes();
+                    solver = move(astar);
+                } else {
+                    auto greedy = make_unique<GreedyBestFirst_Solver>(query, nullptr, storage);
+                    runToCompletion(*greedy);
+                    bytes += greedy->getStorageBytes();
+                    solver = move(greedy);
+                }
+                chosen[solver->getStorage()]++;
+
+                pair<int, int> result = {solver->getPathLength(), solver->getNodesExplored()};
+                if (storage == CellStorage::Dense) expected[i] = result;
+                else if (result != expected[i]) ++mismatches;
+            }
+            double ms = clock.getElapsedTime().asMicroseconds() / 1000.0 / queries;
+            allSame = allSame && mismatches == 0;
+
+            string used;
+            for (auto [s, n] : chosen) used += (used.empty() ? "" : ", ") + to_string(n) + " " + storageName(s);
+            cout << left << setw(10) << name << setw(8) << storageName(storage) << right << fixed
+                 << setprecision(2) << setw(12) << ms << setw(14) << bytes / 1024 / queries << "  "
+                 << (storage == CellStorage::Dense ? "reference"
+                                                   : (mismatches == 0 ? "identical" : to_string(mismatches) + " MISMATCHES"))
+                 << " (" << used << ")\n";
+        }
+    }
+    return allSame ? 0 : 1;
+}
+
+// Runs ARA* asynchronously under a deadline, printing each improvement with
+// its proven bound against the true optimum, then shows cancellation
+static int anytimeSearch(int argc, char* argv[]) {
+    int rows = intArg(argc, argv, 2, 1001);
+    int cols = intArg(argc, argv, 3, 1001);
+    unsigned seed = (unsigned)intArg(argc, argv, 4, 1);
+    int deadlineMs = max(1, intArg(argc, argv, 5, 50));
+    double epsilon = argc > 6 ? atof(argv[6]) : 3.0;
+
+    Maze maze(rows, cols, seed);
+    BFS_Solver reference(maze);
+    runToCompletion(reference);
+    if (!reference.wasPathFound()) {
+        cout << "No path on this maze (seed " << seed << ")\n";
+        return 0;
+    }
+    int optimal = reference.getPathLength() - 1;
+
+    bool boundsHold = true;
+    auto report = [&](const AnytimeSearch::Solution& s) {
+        double ratio = (double)s.cost / optimal;
+        boundsHold = boundsHold && ratio <= s.bound + 1e-9;
+        cout << "  epsilon " << fixed << setprecision(2) << s.epsilon << ": cost " << s.cost
+             << ", proven bound " << s.bound << ", actual " << setprecision(3) << ratio
+             << " x optimal, " << s.expanded << " expanded, " << setprecision(2)
+             << s.time.asMicroseconds() / 1000.0 << " ms\n";
+    };
+
+    cout << maze.getRows() << " x " << maze.getCols() << " (seed " << seed << "), optimal cost "
+         << optimal << ", deadline " << deadlineMs << " ms, initial epsilon " << epsilon << "\n";
+    {
+        AnytimeSearch search(maze, {epsilon, 0.5, sf::milliseconds(deadlineMs)}, report);
+        AnytimeSearch::Solution best = search.getFuture().get();
+        cout << (best.found ? (best.bound <= 1.0 ? "Optimal before the deadline\n" : "Deadline reached, using the best path so far\n")
+                            : "No path before the deadline\n");
+    }
+
+    // Caller-side budget: take the first path and cancel the rest. Cancelling
+    // from the callback stops the search before it can expand another node.
+    {
+        sf::Clock clock;
+        AnytimeSearch search(maze, {epsilon, 0.5, sf::Time::Zero},
+                             [&search](const AnytimeSearch::Solution&) { search.cancel(); });
+        AnytimeSearch::Solution best = search.getFuture().get();
+        cout << "Cancelled after the first path: cost " << best.cost << " (bound " << fixed << setprecision(2)
+             << best.bound << ") in " << clock.getElapsedTime().asMicroseconds() / 1000.0 << " ms\n";
+    }
+
+    cout << "Bounds " << (boundsHold ? "hold" : "VIOLATED") << "\n";
+    return boundsHold ? 0 : 1;
+}
+
+// Builds a goal flow field, walks a crowd of agents to the goal with it and
+// compares that with one A* per agent. Then toggles walls a few times and
+// checks the incremental update against a full rebuild.
+static int flowField(int argc, char* argv[]) {
+    int rows = intArg(argc, argv, 2, 1001);
+    int cols = intArg(argc, argv, 3, 1001);
+    unsigned seed = (unsigned)intArg(argc, argv, 4, 1);
+    int agentCount = max(1, intArg(argc, argv, 5, 100000));
+    int changes = max(0, intArg(argc, argv, 6, 20));
+
+    Maze maze(rows, cols, seed);
+    sf::Clock clock;
+    FlowField field(maze);
+    double buildMs = clock.getElapsedTime().asMicroseconds() / 1000.0;
+    cout << maze.getRows() << " x " << maze.getCols() << " (seed " << seed << "): field built in " << fixed
+         << setprecision(2) << buildMs << " ms, " << field.getSizeBytes() / 1024 << " KB, farthest cell "
+         << field.getMaxDistance() << " moves from the goal\n";
+
+    // Agents start on random cells that can reach the goal
+    mt19937 rng(seed);
+    vector<int32_t> agents;
+    agents.reserve(agentCount);
+    int32_t longest = 0;
+    while ((int)agents.size() < agentCount) {
+        pair<int, int> cell = randomOpenCell(maze, rng);
+        int32_t dist = field.distance(cell.first, cell.second);
+        if (dist == FlowField::UNREACHABLE) continue;
+        agents.push_back(cell.first * cols + cell.second);
+        longest = max(longest, dist);
+    }
+
+    // One A* per agent, on a sample, for comparison
+    int sample = min(agentCount, 200);
+    Maze query = maze;
+    clock.restart();
+    for (int i = 0; i < sample; ++i) {
+        query.setStartGoal({agents[i] / cols, agents[i] % cols}, maze.getGoal());
+        AStar_Solver solver(query);
+        runToCompletion(solver);
+    }
+    double astarMs = clock.getElapsedTime().asMicroseconds() / 1000.0 / sample * agentCount;
+
+    // Every agent must arrive exactly when its distance says
+    long long ticks = 0;
+    size_t arrived = 0;
+    clock.restart();
+    while (arrived < agents.size() && ticks <= longest) {
+        arrived = field.step(agents);
+        ticks++;
+    }
+    double walkMs = clock.getElapsedTime().asMicroseconds() / 1000.0;
+    bool walkOk = arrived == agents.size() && ticks == max<int32_t>(longest, 1);
+    cout << agentCount << " agents reached the goal in " << ticks << " ticks, " << setprecision(2) << walkMs
+         << " ms (" << setprecision(1) << walkMs * 1e6 / ((double)ticks * agentCount) << " ns per agent per tick, "
+         << setprecision(3) << walkMs / ticks << " ms per tick)\n"
+         << "One A* per agent would take about " << setprecision(0) << astarMs << " ms (from " << sample
+         << " samples) vs " << setprecision(2) << buildMs << " ms for the field\n";
+
+    // Toggle interior cells, other than the start and goal, in batches
+    uniform_int_distribution<int> rowDist(1, rows - 2);
+    uniform_int_distribution<int> colDist(1, cols - 2);
+    double updateMs = 0, rebuildMs = 0;
+    size_t recomputed = 0;
+    bool updateOk = true;
+    const int rounds = 10;
+    for (int round = 0; round < rounds && changes > 0; ++round) {
+        vector<pair<int, int>> changed;
+        while ((int)changed.size() < changes) {
+            pair<int, int> cell = {rowDist(rng), colDist(rng)};
+            if (cell == maze.getStart() || cell == maze.getGoal()) continue;
+            char& ch = maze.grid[cell.first][cell.second];
+            if (ch != '#' && ch != ' ') continue;
+            ch = ch == '#' ? ' ' : '#';
+            changed.push_back(cell);
+        }
+
+        clock.restart();
+        recomputed += field.wallsChanged(maze, changed);
+        updateMs += clock.getElapsedTime().asMicroseconds() / 1000.0;
+        clock.restart();
+        FlowField fresh(maze);
+        rebuildMs += clock.getElapsedTime().asMicroseconds() / 1000.0;
+
+        // Distances must match; moves may break ties differently but must
+        // still lead one step closer
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                int32_t dist = field.distance(r, c);
+                if (dist != fresh.distance(r, c)) updateOk = false;
+                if (dist > 0) {
+                    pair<int, int> next = field.nextCell(r, c);
+                    if (field.distance(next.first, next.second) != dist - 1) updateOk = false;
+                }
+            }
+        }
+    }
+    if (changes > 0) {
+        cout << rounds << " rounds of " << changes << " wall toggles: incremental update " << setprecision(3)
+             << updateMs / rounds << " ms (" << recomputed / rounds << " cells recomputed) vs rebuild "
+             << rebuildMs / rounds << " ms per round\n";
+    }
+
+    bool ok = walkOk && updateOk;
+    cout << "Flow field " << (ok ? "consistent" : "INCONSISTENT") << "\n";
+    return ok ? 0 : 1;
+}
+
+// Turns a maze into a perfect maze (one path between any two cells) carved by
+// a randomised depth-first search on the odd rows and columns, from the top
+// left to the bottom right corner. Used as a corridor-heavy workload.
+static void carvePerfectMaze(Maze& maze, unsigned seed) {
+    int rows = maze.getRows(), cols = maze.getCols();
+    vector<string> carved(rows, string(cols, '#'));
+    mt19937 rng(seed);
+    vector<pair<int, int>> stack = {{1, 1}};
+    carved[1][1] = ' ';
+    while (!stack.empty()) {
+        auto [r, c] = stack.back();
+        int order[4] = {0, 1, 2, 3};
+        shuffle(order, order + 4, rng);
+        bool moved = false;
+        for (int d : order) {
+            int nr = r + 2 * directions[d].first, nc = c + 2 * directions[d].second;
+            if (nr < 1 || nc < 1 || nr > rows - 2 || nc > cols - 2 || carved[nr][nc] == ' ') continue;
+            carved[r + directions[d].first][c + directions[d].second] = ' ';
+            carved[nr][nc] = ' ';
+            stack.push_back({nr, nc});
+            moved = true;
+            break;
+        }
+        if (!moved) stack.pop_back();
+    }
+
+    pair<int, int> goal = {(rows - 2) | 1, (cols - 2) | 1};
+    if (goal.first > rows - 2) goal.first -= 2;
+    if (goal.second > cols - 2) goal.second -= 2;
+    maze.setStartGoal({1, 1}, goal);
+    maze.grid = carved;
+    maze.grid[1][1] = 'S';
+    maze.grid[goal.first][goal.second] = 'E';
+}
+
+// Contracts the maze's corridors into a CorridorGraph and runs the same
+// random queries on the grid (SearchWorkspace) and on the graph, checking
+// that every graph path is a valid grid path of the same length. Runs on the
+// usual random maze, then on a perfect maze of the same size.
+static bool compareCorridorGraph(Maze& maze, const string& label, int queries, unsigned seed) {
+    sf::Clock clock;
+    CorridorGraph graph(maze);
+    double buildMs = clock.getElapsedTime().asMicroseconds() / 1000.0;
+    cout << label << ": " << graph.getOpenCells() << " open cells -> " << graph.getNodeCount() << " nodes, "
+         << graph.getEdgeCount() << " edges (" << fixed << setprecision(1)
+         << (double)graph.getOpenCells() / max<size_t>(graph.getNodeCount(), 1) << "x fewer), built in "
+         << setprecision(2) << buildMs << " ms, " << graph.getSizeBytes() / 1024 << " KB\n";
+
+    mt19937 rng(seed);
+    vector<pair<pair<int, int>, pair<int, int>>> pairs(queries);
+    for (auto& q : pairs) q = {randomOpenCell(maze, rng), randomOpenCell(maze, rng)};
+
+    // A path must start and end at the query cells and move one open cell at a time
+    auto validPath = [&](const vector<pair<int, int>>& path, pair<int, int> s, pair<int, int> g) {
+        if (path.empty() || path.front() != s || path.back() != g) return false;
+        for (size_t i = 0; i < path.size(); ++i) {
+            if (maze.grid[path[i].first][path[i].second] == '#') return false;
+            if (i > 0 && abs(path[i].first - path[i - 1].first) + abs(path[i].second - path[i - 1].second) != 1)
+                return false;
+        }
+        return true;
+    };
+
+    struct Pair { const char* name; SearchWorkspace::Algorithm grid; CorridorGraph::Algorithm graph; };
+    const Pair algorithms[] = {
+        {"BFS", SearchWorkspace::Algorithm::BFS, CorridorGraph::Algorithm::BFS},
+        {"Dijkstra", SearchWorkspace::Algorithm::Dijkstra, CorridorGraph::Algorithm::Dijkstra},
+        {"A*", SearchWorkspace::Algorithm::AStar, CorridorGraph::Algorithm::AStar}};
+
+    cout << left << setw(10) << "Algorithm" << right << setw(12) << "Grid us/q" << setw(12) << "Graph us/q"
+         << setw(14) << "Grid nodes" << setw(14) << "Graph nodes" << "  Paths\n";
+
+    SearchWorkspace workspace(maze);
+    bool allExact = true;
+    for (const Pair& a : algorithms) {
+        vector<int> lengths(queries);
+        long long gridNodes = 0, graphNodes = 0;
+        clock.restart();
+        for (int i = 0; i < queries; ++i) {
+            SearchWorkspace::Result r = workspace.solve(a.grid, pairs[i].first, pairs[i].second);
+            lengths[i] = r.found ? r.pathLength : 0;
+            gridNodes += r.nodesExplored;
+        }
+        double gridUs = clock.getElapsedTime().asMicroseconds() / (double)queries;
+
+        vector<CorridorGraph::Result> results(queries);
+        clock.restart();
+        for (int i = 0; i < queries; ++i) {
+            results[i] = graph.solve(a.graph, pairs[i].first, pairs[i].second);
+        }
+        double graphUs = clock.getElapsedTime().asMicroseconds() / (double)queries;
+
+        int mismatches = 0;
+        for (int i = 0; i < queries; ++i) {
+            const CorridorGraph::Result& r = results[i];
+            graphNodes += r.nodesExplored;
+            bool exact = (r.found ? r.pathLength : 0) == lengths[i] &&
+                         (!r.found || validPath(r.path, pairs[i].first, pairs[i].second));
+            mismatches += !exact;
+        }
+        allExact = allExact && mismatches == 0;
+
+        cout << left << setw(10) << a.name << right << fixed << setprecision(1) << setw(12) << gridUs
+             << setw(12) << graphUs << setw(14) << gridNodes / queries << setw(14) << graphNodes / queries << "  "
+             << (mismatches == 0 ? "exact" : to_string(mismatches) + " MISMATCHES") << "\n";
+    }
+
+    // The step-by-step solver draws the same path on the grid
+    Corridor_Solver solver(maze, graph);
+    runToCompletion(solver);
+    BFS_Solver reference(maze);
+    runToCompletion(reference);
+    int marked = 0;
+    for (const string& row : solver.getGrid()) marked += (int)count(row.begin(), row.end(), 'X');
+    bool solverExact = solver.wasPathFound() == reference.wasPathFound() &&
+                       (!solver.wasPathFound() || (solver.getPathLength() == reference.getPathLength() &&
+                                                   marked == solver.getPathLength() - 2));
+    cout << "Corridor_Solver S -> E: " << (solver.wasPathFound() ? to_string(solver.getPathLength()) + " cells" : "no path")
+         << ", " << solver.getNodesExplored() << " nodes explored vs " << reference.getNodesExplored()
+         << " for BFS: " << (solverExact ? "exact" : "MISMATCH") << "\n";
+    return allExact && solverExact;
+}
+
+static int corridorGraph(int argc, char* argv[]) {
+    int rows = intArg(argc, argv, 2, 1001);
+    int cols = intArg(argc, argv, 3, 1001);
+    unsigned seed = (unsigned)intArg(argc, argv, 4, 1);
+    int density = intArg(argc, argv, 5, 25);
+    int queries = max(1, intArg(argc, argv, 6, 200));
+
+    cout << rows << " x " << cols << " (seed " << seed << "), " << queries << " random queries each\n";
+    Maze random(rows, cols, seed, density);
+    bool ok = compareCorridorGraph(random, "Random maze, " + to_string(density) + "% walls", queries, seed);
+
+    Maze perfect(rows, cols, seed);
+    carvePerfectMaze(perfect, seed);
+    ok = compareCorridorGraph(perfect, "Perfect maze", queries, seed) && ok;
+    return ok ? 0 : 1;
+}
+
+// Runs the optimal solvers on random queries before and after pruning:
+// dead-end filling for all of them, plus rectangular symmetry reduction for
+// the weighted ones. Path lengths must not change.
+static int pruneMaze(int argc, char* argv[]) {
+    int rows = intArg(argc, argv, 2, 301);
+    int cols = intArg(argc, argv, 3, 301);
+    unsigned seed = (unsigned)intArg(argc, argv, 4, 1);
+    int density = intArg(argc, argv, 5, 25);
+    int queries = max(1, intArg(argc, argv, 6, 50));
+
+    Maze maze(rows, cols, seed, density);
+    mt19937 rng(seed);
+
+    // Nodes explored and time per solver and variant
+    struct Totals { long long nodes = 0; double ms = 0; };
+    const vector<string> names = {"BFS", "Dijkstra", "A*"};
+    map<string, Totals> before, deadEnds, symmetry;
+    long long filled = 0, rectangles = 0, interior = 0, mismatches = 0;
+    double prepMs = 0;
+
+    auto run = [&](Solver& solver, Totals& totals) {
+        sf::Clock clock;
+        runToCompletion(solver);
+        totals.ms += clock.getElapsedTime().asMicroseconds() / 1000.0;
+        totals.nodes += solver.getNodesExplored();
+        return solver.wasPathFound() ? solver.getPathLength() : 0;
+    };
+
+    for (int q = 0; q < queries; ++q) {
+        pair<int, int> s = randomOpenCell(maze, rng), g;
+        do { g = randomOpenCell(maze, rng); } while (g == s);
+        maze.setStartGoal(s, g);
+
+        sf::Clock clock;
+        Maze pruned = maze;
+        filled += fillDeadEnds(pruned);
+        RectangleSymmetry rsr(pruned);
+        prepMs += clock.getElapsedTime().asMicroseconds() / 1000.0;
+        rectangles += rsr.getRectangleCount();
+        interior += rsr.getInteriorCells();
+
+        for (const string& name : names) {
+            auto original = makeSolver(name, maze);
+            int length = run(*original, before[name]);
+
+            auto filledOnly = makeSolver(name, pruned);
+            mismatches += run(*filledOnly, deadEnds[name]) != length;
+
+            unique_ptr<Solver> withRsr;
+            if (name == "Dijkstra") withRsr = make_unique<Dijkstra_Solver>(pruned, &rsr);
+            if (name == "A*")       withRsr = make_unique<AStar_Solver>(pruned, nullptr, CellStorage::Auto, &rsr);
+            if (!withRsr) continue;
+            mismatches += run(*withRsr, symmetry[name]) != length;
+
+            // The unfolded path must be a real grid path
+            vector<pair<int, int>> path = withRsr->getPath();
+            for (size_t i = 1; i < path.size(); ++i) {
+                int step = abs(path[i].first - path[i - 1].first) + abs(path[i].second - path[i - 1].second);
+                if (step != 1 || pruned.grid[path[i].first][path[i].second] == '#') {
+                    mismatches++;
+                    break;
+                }
+            }
+        }
+    }
+
+    cout << maze.getRows() << " x " << maze.getCols() << " (seed " << seed << "), " << density << "% walls, "
+         << queries << " random queries\n"
+         << "Per query: " << filled / queries << " dead-end cells filled, " << rectangles / queries
+         << " rectangles skipping " << interior / queries << " interior cells, preprocessing " << fixed
+         << setprecision(2) << prepMs / queries << " ms\n"
+         << left << setw(10) << "Algorithm" << right << setw(12) << "Original" << setw(14) << "Dead ends"
+         << setw(16) << "+ Symmetry" << "   (mean nodes explored / ms per query)\n";
+    auto cell = [&](const Totals& t) {
+        ostringstream out;
+        out << t.nodes / queries << " / " << fixed << setprecision(2) << t.ms / queries;
+        return out.str();
+    };
+    for (const string& name : names) {
+        cout << left << setw(10) << name << right << setw(14) << cell(before[name]) << setw(14)
+             << cell(deadEnds[name]) << setw(16) << (symmetry.count(name) ? cell(symmetry[name]) : "-") << "\n";
+    }
+    cout << "Path lengths " << (mismatches == 0 ? "unchanged" : to_string(mismatches) + " MISMATCHES") << "\n";
+    return mismatches == 0 ? 0 : 1;
+}
+
+// Runs Dijkstra_Solver and DeltaStepping_Solver on one cost grid and checks
+// that every cell closer than the goal gets the same distance from both, over
+// a sweep of deltas and then of thread counts
+static int deltaStepping(int argc, char* argv[]) {
+    int rows = intArg(argc, argv, 2, 2001);
+    int cols = intArg(argc, argv, 3, 2001);
+    unsigned seed = (unsigned)intArg(argc, argv, 4, 1);
+    int maxCost = max(1, min(CostGrid::MAX_COST, intArg(argc, argv, 5, 9)));
+    unsigned maxThreads = (unsigned)max(1, intArg(argc, argv, 6, (int)thread::hardware_concurrency()));
+    int bestDelta = max(0, intArg(argc, argv, 7, 0));
+
+    Maze maze(rows, cols, seed);
+    CostGrid costs(maze, seed, maxCost);
+
+    Dijkstra_Solver reference(maze, nullptr, &costs);
+    runToCompletion(reference);
+    double refMs = reference.getTimeTaken().asMicroseconds() / 1000.0;
+    pair<int, int> goal = maze.getGoal();
+    long long goalDist = reference.wasPathFound() ? reference.getDistance(goal.first, goal.second) : -1;
+
+    cout << "Maze " << maze.getRows() << " x " << maze.getCols() << ", seed " << seed
+         << ", cell costs 1-" << maxCost << "\n";
+    cout << "Dijkstra_Solver: " << fixed << setprecision(3) << refMs << " ms, "
+         << reference.getNodesExplored() << " nodes, goal distance "
+         << (goalDist >= 0 ? to_string(goalDist) : "unreachable") << "\n\n";
+
+    // Cells closer than the goal are final in both; with no path, every reachable cell is
+    auto sameDistances = [&](const DeltaStepping_Solver& solver) {
+        if (solver.wasPathFound() != reference.wasPathFound()) return false;
+        if (goalDist >= 0 && (solver.getGoalDistance() != goalDist ||
+                              costs.pathCost(solver.getPath()) != goalDist)) return false;
+        for (int r = 0; r < maze.getRows(); ++r) {
+            for (int c = 0; c < maze.getCols(); ++c) {
+                long long a = solver.getDistance(r, c);
+                long long b = reference.getDistance(r, c) == numeric_limits<int>::max() ? -1 : reference.getDistance(r, c);
+                bool finalA = a >= 0 && (goalDist < 0 || a < goalDist);
+                bool finalB = b >= 0 && (goalDist < 0 || b < goalDist);
+                if ((finalA || finalB) && a != b) return false;
+            }
+        }
+        return true;
+    };
+
+    bool allMatch = true;
+    auto report = [&](const DeltaStepping_Solver& solver, double baseMs) {
+        double ms = solver.getTimeTaken().asMicroseconds() / 1000.0;
+        bool match = sameDistances(solver);
+        allMatch = allMatch && match;
+        cout << setw(6) << solver.getDelta() << setw(9) << solver.getThreadCount() << setw(12) << ms
+             << setw(9) << setprecision(2) << (ms > 0 ? baseMs / ms : 0.0) << setprecision(3)
+             << setw(10) << solver.getBuckets() << setw(9) << solver.getLightRounds()
+             << setw(13) << solver.getRelaxations() << setw(8) << (match ? "ok" : "DIFF") << "\n";
+        return ms;
+    };
+    auto header = [&](const char* against) {
+        cout << setw(6) << "delta" << setw(9) << "threads" << setw(12) << "time (ms)" << setw(9) << against
+             << setw(10) << "buckets" << setw(9) << "rounds" << setw(13) << "relaxations" << setw(8) << "dist" << "\n";
+    };
+
+    // Small deltas mean many nearly empty buckets, large ones many re-relaxations
+    cout << "Delta sweep on " << maxThreads << " threads (speed-up vs Dijkstra_Solver):\n";
+    header("vs Dijk");
+    double bestMs = 0;
+    for (int delta = 1; delta <= 4 * maxCost; delta *= 2) {
+        DeltaStepping_Solver solver(maze, &costs, delta, maxThreads);
+        runToCompletion(solver);
+        double ms = report(solver, refMs);
+        if (argc <= 7 && (bestMs == 0 || ms < bestMs)) {
+            bestMs = ms;
+            bestDelta = delta;
+        }
+    }
+
+    cout << "\nThread sweep at delta " << bestDelta << " (speed-up vs 1 thread):\n";
+    header("speedup");
+    double baseMs = 0.0;
+    for (unsigned t : threadCounts(maxThreads)) {
+        DeltaStepping_Solver solver(maze, &costs, bestDelta, t);
+        runToCompletion(solver);
+        if (t == 1) baseMs = solver.getTimeTaken().asMicroseconds() / 1000.0;
+        report(solver, baseMs);
+    }
+    return allMatch ? 0 : 1;
+}
+
+static int nearestGoals(int argc, char* argv[]) {
+    int rows = intArg(argc, argv, 2, 1001);
+    int cols = intArg(argc, argv, 3, 1001);
+    unsigned seed = (unsigned)intArg(argc, argv, 4, 1);
+    int goalCount = max(1, intArg(argc, argv, 5, 64));
+    int k = max(1, intArg(argc, argv, 6, 5));
+
+    Maze maze(rows, cols, seed);
+
+    // Not the maze's own seed: the same draws would land next to the start
+    mt19937 rng(seed * 7919 + 1);
+    set<pair<int, int>> picked;
+    while ((int)picked.size() < goalCount) {
+        pair<int, int> cell = randomOpenCell(maze, rng);
+        if (cell != maze.getStart()) picked.insert(cell);
+    }
+    vector<pair<int, int>> goals(picked.begin(), picked.end());
+    shuffle(goals.begin(), goals.end(), rng);
+    cout << "Maze " << maze.getRows() << " x " << maze.getCols() << ", seed " << seed << ", "
+         << goalCount << " goals, k = " << k << "\n";
+
+    // One A* per goal: every distance, for checking
+    vector<int> distances;
+    long long separateNodes = 0;
+    sf::Clock clock;
+    {
+        Maze query = maze;
+        for (pair<int, int> goal : goals) {
+            query.setStartGoal(maze.getStart(), goal);
+            AStar_Solver solver(query);
+            runToCompletion(solver);
+            separateNodes += solver.getNodesExplored();
+            if (solver.wasPathFound()) distances.push_back((int)solver.getPath().size() - 1);
+        }
+    }
+    double separateMs = clock.getElapsedTime().asMicroseconds() / 1000.0;
+    sort(distances.begin(), distances.end());
+    distances.resize(min<size_t>(distances.size(), k));
+
+    cout << setw(24) << "search" << setw(12) << "time (ms)" << setw(12) << "nodes" << setw(8) << "check"
+         << "   distances\n";
+    cout << setw(24) << ("A* x " + to_string(goalCount)) << setw(12) << fixed << setprecision(3) << separateMs
+         << setw(12) << separateNodes << setw(8) << "";
+    for (int d : distances) cout << " " << d;
+    cout << "\n";
+
+    // Nearest only, then the k nearest, each from one search
+    maze.setGoals(goals);
+    bool allMatch = true;
+    for (int wanted : {1, k}) {
+        for (int i = 0; i < 3; ++i) {
+            unique_ptr<Solver> solver;
+            if (i == 0) solver = make_unique<BFS_Solver>(maze);
+            if (i == 1) solver = make_unique<Dijkstra_Solver>(maze);
+            if (i == 2) solver = make_unique<AStar_Solver>(maze);
+            solver->setGoalsWanted(wanted);
+            runToCompletion(*solver);
+
+            vector<int> found;
+            for (const auto& path : solver->getGoalPaths()) found.push_back((int)path.size() - 1);
+            vector<int> expected(distances.begin(), distances.begin() + min<size_t>(distances.size(), wanted));
+            bool match = found == expected;
+            allMatch = allMatch && match;
+
+            string label = string(i == 0 ? "BFS" : i == 1 ? "Dijkstra" : "A*") + " nearest " + to_string(wanted);
+            cout << setw(24) << label << setw(12) << solver->getTimeTaken().asMicroseconds() / 1000.0
+                 << setw(12) << solver->getNodesExplored() << setw(8) << (match ? "ok" : "DIFF");
+            for (int d : found) cout << " " << d;
+            cout << "\n";
+        }
+        if (k == 1) break;
+    }
+    return allMatch ? 0 : 1;
+}
+
+static int cooperativeAgents(int argc, char* argv[]) {
+    int rows = intArg(argc, argv, 2, 101);
+    int cols = intArg(argc, argv, 3, 101);
+    unsigned seed = (unsigned)intArg(argc, argv, 4, 1);
+    int agentCount = max(1, intArg(argc, argv, 5, 300));
+    int window = max(2, intArg(argc, argv, 6, 16));
+    unsigned maxThreads = (unsigned)max(1, intArg(argc, argv, 7, (int)thread::hardware_concurrency()));
+
+    Maze maze(rows, cols, seed);
+    vector<CooperativeAStar::Agent> agents = CooperativeAStar::randomAgents(maze, agentCount, seed);
+    cout << "Maze " << maze.getRows() << " x " << maze.getCols() << ", seed " << seed << ", "
+         << agents.size() << " agents, window " << window << "\n";
+
+    // Each agent alone on its shortest path, all moving at once
+    long long independentCollisions = 0;
+    int longest = 0;
+    {
+        Maze query = maze;
+        vector<vector<pair<int, int>>> paths;
+        for (const CooperativeAStar::Agent& agent : agents) {
+            query.setStartGoal(agent.start, agent.goal);
+            BFS_Solver solver(query);
+            runToCompletion(solver);
+            paths.push_back(solver.getPath());
+            longest = max(longest, (int)paths.back().size());
+        }
+        auto at = [&](size_t a, int t) { return paths[a][min<size_t>(t, paths[a].size() - 1)]; };
+        map<pair<int, int>, size_t> before, now;
+        for (size_t a = 0; a < paths.size(); ++a) before[at(a, 0)] = a;
+        for (int t = 1; t < longest; ++t) {
+            now.clear();
+            for (size_t a = 0; a < paths.size(); ++a) {
+                if (!now.insert({at(a, t), a}).second) independentCollisions++;
+
+                // Swapped with whoever was in the cell just entered
+                auto other = before.find(at(a, t));
+                if (at(a, t) != at(a, t - 1) && other != before.end() && other->second > a &&
+                    at(other->second, t) == at(a, t - 1)) independentCollisions++;
+            }
+            swap(before, now);
+        }
+    }
+    cout << "Independent shortest paths: " << independentCollisions << " collisions, longest "
+         << max(0, longest - 1) << " moves\n\n";
+
+    cout << setw(8) << "threads" << setw(8) << "ticks" << setw(9) << "arrived" << setw(12) << "plan (ms)"
+         << setw(12) << "replans/s" << setw(13) << "expansions" << setw(11) << "conflicts" << setw(8) << "failed"
+         << setw(12) << "collisions" << setw(12) << "waves/round" << setw(10) << "dist (MB)" << setw(9)
+         << "dropped" << "\n";
+
+    // Stuck agents can circle forever; give up well after the longest solo path
+    const long long maxTicks = 4LL * (longest + window);
+    bool clean = true;
+    for (unsigned t : threadCounts(maxThreads)) {
+        CooperativeAStar sim(maze, agents, window, t);
+        while (sim.getStats().ticks < maxTicks && sim.step()) {}
+
+        const CooperativeAStar::Stats& s = sim.getStats();
+        clean = clean && s.collisions == 0;
+        cout << setw(8) << t << setw(8) << s.ticks << setw(9) << sim.getArrived() << setw(12) << fixed
+             << setprecision(2) << s.planSeconds * 1000 << setw(12) << setprecision(0)
+             << (s.planSeconds > 0 ? s.replans / s.planSeconds : 0.0) << setw(13) << s.expansions
+             << setw(11) << s.conflictsAvoided << setw(8) << s.failedPlans << setw(12) << s.collisions
+             << setw(12) << setprecision(1) << (s.rounds ? (double)s.waves / s.rounds : 0.0) << setw(10)
+             << s.peakDistanceBytes / (1024.0 * 1024.0) << setw(9) << s.distanceResets << "\n";
+    }
+    cout << "\nconflicts: moves the reservation table ruled out; collisions: agents that still met\n"
+         << "dist: peak memory of the goal distances; dropped: distances freed to stay under "
+         << (CooperativeAStar::DEFAULT_DISTANCE_BUDGET >> 20) << " MB\n";
+    return clean ? 0 : 1;
+}
+
+int runHeadless(int argc, char* argv[]) {
+    string command = argv[1];
+
+    if (command == "bfs-scaling") return bfsScaling(argc, argv);
+    if (command == "hda")         return hdaStats(argc, argv);
+    if (command == "ext-bfs")     return externalBfs(argc, argv);
+    if (command == "alt")         return altCompare(argc, argv);
+    if (command == "cpd")         return pathDatabase(argc, argv);
+    if (command == "bounds")      return goalBounding(argc, argv);
+    if (command == "cache")       return resultCache(argc, argv);
+    if (command == "record")      return recordEvents(argc, argv);
+    if (command == "checkpoint")  return checkpointResume(argc, argv);
+    if (command == "resume")      return resumeCheckpoint(argc, argv);
+    if (command == "watch")       return watchSolvers(argc, argv);
+    if (command == "workspace")   return workspaceQueries(argc, argv);
+    if (command == "bench")       return Benchmark::main(argc, argv);
+    if (command == "infinite")    return infiniteMaze(argc, argv);
+    if (command == "sparse")      return sparseStorage(argc, argv);
+    if (command == "anytime")     return anytimeSearch(argc, argv);
+    if (command == "flow")        return flowField(argc, argv);
+    if (command == "corridor")    return corridorGraph(argc, argv);
+    if (command == "prune")       return pruneMaze(argc, argv);
+    if (command == "batch")       return BatchRunner::main(argc, argv);
+    if (command == "delta")       return deltaStepping(argc, argv);
+    if (command == "goals")       return nearestGoals(argc, argv);
+    if (command == "agents")      return cooperativeAgents(argc, argv);
+
+    printUsage();
+    return command == "help" || command == "--help" ? 0 : 1;
+}
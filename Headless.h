@@ -0,0 +1,14 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include "Solver.h"
+
+// Command-line (no window) entry point, used when the visualizer is started
+// with arguments, e.g. `./maze_visualizer bfs-scaling 2001 2001`.
+// Returns the process exit code.
+int runHeadless(int argc, char* argv[]);
+
+// Steps a solver until it is finished (search and path tracing)
+void runToCompletion(Solver& solver);
+
+#endif // HEADLESS_H
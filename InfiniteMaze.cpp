@@ -0,0 +1,82 @@
+#include "InfiniteMaze.h"
+#include <algorithm>
+
+using namespace std;
+
+// splitmix64 finaliser
+static uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+InfiniteMaze::InfiniteMaze(uint64_t seed, int wallDensity, size_t maxChunks)
+    : m_seed(mix(seed)),
+      m_wallDensity(wallDensity),
+      m_maxChunks(max<size_t>(1, maxChunks))
+{
+}
+
+// Packs two 32-bit signed coordinates into one key
+uint64_t InfiniteMaze::key(long long r, long long c) {
+    return ((uint64_t)(uint32_t)(int32_t)r << 32) | (uint32_t)(int32_t)c;
+}
+
+bool InfiniteMaze::generatedOpen(long long r, long long c) const {
+    return mix(m_seed ^ mix(key(r, c))) % 100 >= (uint64_t)m_wallDensity;
+}
+
+void InfiniteMaze::keepOpen(long long r, long long c) {
+    m_forcedOpen.insert(key(r, c));
+}
+
+const InfiniteMaze::Chunk& InfiniteMaze::chunk(long long chunkRow, long long chunkCol) {
+    uint64_t k = key(chunkRow, chunkCol);
+    auto it = m_cached.find(k);
+    if (it != m_cached.end()) {
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        return it->second->second;
+    }
+
+    if (m_lru.size() >= m_maxChunks) {
+        if (m_lru.back().first == m_lastKey) m_lastKey = UINT64_MAX;
+        m_cached.erase(m_lru.back().first);
+        m_lru.pop_back();
+        m_evictions++;
+    }
+
+    Chunk bits{};
+    long long top = chunkRow * CHUNK, left = chunkCol * CHUNK;
+    for (int r = 0; r < CHUNK; ++r) {
+        uint64_t row = 0;
+        for (int c = 0; c < CHUNK; ++c) {
+            if (generatedOpen(top + r, left + c)) row |= 1ull << c;
+        }
+        bits[r] = row;
+    }
+    m_generated++;
+
+    m_lru.emplace_front(k, bits);
+    m_cached[k] = m_lru.begin();
+    return m_lru.front().second;
+}
+
+bool InfiniteMaze::isOpen(long long r, long long c) {
+    if (r < INT32_MIN || r > INT32_MAX || c < INT32_MIN || c > INT32_MAX) return false;
+
+    // Floor division, so negative coordinates map to their own chunks
+    long long chunkRow = r >= 0 ? r / CHUNK : -((-r + CHUNK - 1) / CHUNK);
+    long long chunkCol = c >= 0 ? c / CHUNK : -((-c + CHUNK - 1) / CHUNK);
+
+    // Neighbouring lookups almost always hit the same chunk
+    uint64_t k = key(chunkRow, chunkCol);
+    if (k != m_lastKey) {
+        m_lastChunk = &chunk(chunkRow, chunkCol);
+        m_lastKey = k;
+    }
+    int inRow = (int)(r - chunkRow * CHUNK);
+    int inCol = (int)(c - chunkCol * CHUNK);
+    if (((*m_lastChunk)[inRow] >> inCol) & 1) return true;
+    return !m_forcedOpen.empty() && m_forcedOpen.count(key(r, c)) > 0;
+}
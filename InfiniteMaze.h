@@ -0,0 +1,64 @@
+#ifndef INFINITEMAZE_H
+#define INFINITEMAZE_H
+
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include "MazeSource.h"
+
+// An unbounded procedural maze: each cell is a wall or not depending only on
+// hash(seed, r, c), so any region can be produced on demand, in any order,
+// and always comes out the same.
+//
+// Cells are materialised a CHUNK x CHUNK block at a time (one 64-bit row mask
+// per chunk row) into an LRU cache; evicted chunks are simply regenerated if
+// the search comes back to them. Memory is proportional to the cached chunks,
+// not to any maze size.
+//
+// Rows and columns can be any value in the 32-bit signed range.
+class InfiniteMaze : public MazeSource {
+public:
+    static constexpr int CHUNK = 64;
+
+    // wallDensity: percentage of walls, as in Maze
+    // maxChunks: cache size (each chunk is CHUNK * 8 bytes of wall bits)
+    InfiniteMaze(std::uint64_t seed, int wallDensity = 25, std::size_t maxChunks = 4096);
+
+    bool isOpen(long long r, long long c) override;
+
+    // Forces a cell open (e.g. the start and goal of a query)
+    void keepOpen(long long r, long long c);
+
+    // Cell value straight from the hash, without the cache
+    bool generatedOpen(long long r, long long c) const;
+
+    std::uint64_t getChunksGenerated() const { return m_generated; }
+    std::uint64_t getEvictions() const { return m_evictions; }
+    std::size_t getResidentChunks() const { return m_lru.size(); }
+    std::size_t getResidentBytes() const { return m_lru.size() * sizeof(Chunk); }
+
+private:
+    using Chunk = std::array<std::uint64_t, CHUNK>; // Bit c of row r: 1 = open
+
+    static std::uint64_t key(long long r, long long c);
+    const Chunk& chunk(long long chunkRow, long long chunkCol);
+
+    std::uint64_t m_seed;
+    int m_wallDensity;
+    std::size_t m_maxChunks;
+    std::unordered_set<std::uint64_t> m_forcedOpen;
+
+    // LRU cache: most recently used chunk at the front
+    std::list<std::pair<std::uint64_t, Chunk>> m_lru;
+    std::unordered_map<std::uint64_t, decltype(m_lru)::iterator> m_cached;
+    std::uint64_t m_lastKey = UINT64_MAX;
+    const Chunk* m_lastChunk = nullptr;
+
+    std::uint64_t m_generated = 0;
+    std::uint64_t m_evictions = 0;
+};
+
+#endif // INFINITEMAZE_H
@@ -0,0 +1,135 @@
+#include "Landmarks.h"
+#include "Utils.h"
+#include <algorithm>
+#include <fstream>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+static const char LANDMARK_MAGIC[8] = {'M', 'Z', 'L', 'M', 'R', 'K', '1', '\0'};
+
+vector<int> Landmarks::bfsDistances(const Maze& maze, pair<int, int> from) {
+    const auto& g = maze.grid;
+    int R = (int)g.size(), C = (int)g[0].size();
+
+    vector<int> dist((size_t)R * C, UNREACHABLE);
+    vector<int> queue;
+    queue.reserve((size_t)R * C);
+
+    dist[(size_t)from.first * C + from.second] = 0;
+    queue.push_back(from.first * C + from.second);
+
+    // Flat array queue: every cell is pushed at most once
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int u = queue[head];
+        int r = u / C, c = u % C;
+        for (auto [dr, dc] : directions) {
+            int nr = r + dr, nc = c + dc;
+            if (!isInside(g, nr, nc) || g[nr][nc] == '#') continue;
+            int v = nr * C + nc;
+            if (dist[v] != UNREACHABLE) continue;
+            dist[v] = dist[u] + 1;
+            queue.push_back(v);
+        }
+    }
+    return dist;
+}
+
+Landmarks Landmarks::build(const Maze& maze, int k) {
+    Landmarks lm;
+    lm.rows = (int)maze.grid.size();
+    lm.cols = (int)maze.grid[0].size();
+    lm.mazeHash = maze.wallFingerprint();
+
+    // Distance to the nearest landmark chosen so far; the start's component
+    // is the one that matters, so selection begins from there
+    vector<int> nearest = bfsDistances(maze, maze.getStart());
+
+    for (int i = 0; i < k; ++i) {
+        // Farthest-point selection: the reachable cell farthest from all landmarks
+        int best = -1, bestDist = -1;
+        for (size_t v = 0; v < nearest.size(); ++v) {
+            if (nearest[v] > bestDist) {
+                bestDist = nearest[v];
+                best = (int)v;
+            }
+        }
+        if (best < 0 || (i > 0 && bestDist == 0)) break; // Every reachable cell is a landmark
+
+        pair<int, int> pos = {best / lm.cols, best % lm.cols};
+        lm.positions.push_back(pos);
+        lm.tables.push_back(bfsDistances(maze, pos));
+
+        const vector<int>& table = lm.tables.back();
+        for (size_t v = 0; v < nearest.size(); ++v) {
+            if (table[v] != UNREACHABLE && (i == 0 || table[v] < nearest[v])) {
+                nearest[v] = table[v];
+            }
+        }
+    }
+    return lm;
+}
+
+int Landmarks::heuristic(int r, int c, pair<int, int> goal) const {
+    size_t v = (size_t)r * cols + c;
+    size_t t = (size_t)goal.first * cols + goal.second;
+
+    int h = 0;
+    for (const vector<int>& table : tables) {
+        if (table[v] == UNREACHABLE || table[t] == UNREACHABLE) continue;
+        h = max(h, abs(table[t] - table[v]));
+    }
+    return h;
+}
+
+bool Landmarks::save(const string& path) const {
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out) return false;
+
+    int32_t header[3] = {rows, cols, (int32_t)positions.size()};
+    out.write(LANDMARK_MAGIC, sizeof(LANDMARK_MAGIC));
+    out.write(reinterpret_cast<const char*>(&mazeHash), sizeof(mazeHash));
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    for (size_t i = 0; i < positions.size(); ++i) {
+        int32_t pos[2] = {positions[i].first, positions[i].second};
+        out.write(reinterpret_cast<const char*>(pos), sizeof(pos));
+        out.write(reinterpret_cast<const char*>(tables[i].data()), tables[i].size() * sizeof(int));
+    }
+    return (bool)out;
+}
+
+bool Landmarks::load(const string& path, const Maze& maze) {
+    ifstream in(path, ios::binary);
+    if (!in) return false;
+
+    char magic[8];
+    uint64_t hash = 0;
+    int32_t header[3];
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!in || memcmp(magic, LANDMARK_MAGIC, sizeof(magic)) != 0) return false;
+
+    // Tables built for another maze would make the heuristic inadmissible
+    if (hash != maze.wallFingerprint() || header[0] != (int)maze.grid.size() ||
+        header[1] != (int)maze.grid[0].size()) {
+        return false;
+    }
+
+    Landmarks lm;
+    lm.rows = header[0];
+    lm.cols = header[1];
+    lm.mazeHash = hash;
+    for (int i = 0; i < header[2]; ++i) {
+        int32_t pos[2];
+        in.read(reinterpret_cast<char*>(pos), sizeof(pos));
+        lm.positions.push_back({pos[0], pos[1]});
+        lm.tables.emplace_back((size_t)lm.rows * lm.cols);
+        in.read(reinterpret_cast<char*>(lm.tables.back().data()), lm.tables.back().size() * sizeof(int));
+    }
+    if (!in) return false;
+
+    *this = move(lm);
+    return true;
+}
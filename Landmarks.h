@@ -0,0 +1,46 @@
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <cstdint>
+#include "Maze.h"
+
+// ALT (A*, Landmarks, Triangle inequality) preprocessing.
+// K landmarks are picked by farthest-point selection and an exact BFS distance
+// table is stored for each one. For any cell v and goal t,
+//     |d(L, t) - d(L, v)| <= d(v, t)
+// so the max over all landmarks is an admissible, consistent heuristic that
+// follows the walls, unlike Manhattan distance.
+class Landmarks {
+public:
+    static constexpr int UNREACHABLE = -1;
+
+    Landmarks() = default;
+
+    // Picks k landmarks on the maze and computes their distance tables
+    static Landmarks build(const Maze& maze, int k);
+
+    // Saves/loads the tables next to a maze; load() returns false if the
+    // file is missing or was built for a different maze
+    bool save(const std::string& path) const;
+    bool load(const std::string& path, const Maze& maze);
+
+    // Lower bound on the distance from (r, c) to 'goal'
+    int heuristic(int r, int c, std::pair<int, int> goal) const;
+
+    int getCount() const { return (int)positions.size(); }
+    const std::vector<std::pair<int, int>>& getPositions() const { return positions; }
+    int distance(int landmark, int r, int c) const { return tables[landmark][(size_t)r * cols + c]; }
+
+private:
+    static std::vector<int> bfsDistances(const Maze& maze, std::pair<int, int> from);
+
+    int rows = 0, cols = 0;
+    std::uint64_t mazeHash = 0;
+    std::vector<std::pair<int, int>> positions;
+    std::vector<std::vector<int>> tables; // tables[k][r * cols + c]
+};
+
+#endif // LANDMARKS_H
@@ -1,18 +1,17 @@
 #include "Maze.h"
+#include "Trace.h"
 #include <random>    
 #include <algorithm> 
 #include <ctime>     
 
 using namespace std;
 
-Maze::Maze(int rows, int cols, unsigned seed_)
-    : rows(rows), cols(cols)
+Maze::Maze(int rows, int cols, unsigned seed_, int wallDensity)
+    : rows(max(rows, 5)), cols(max(cols, 5)) // Ensure minimum usable dimensions
 {
-    // Ensure minimum usable dimensions
-    rows = max(rows, 5);
-    cols = max(cols, 5);
+    TRACE_SCOPE("Maze::generate");
 
-    grid.assign(rows, string(cols, '#'));
+    grid.assign(this->rows, string(this->cols, '#'));
 
     if (seed_ != 0) {
         seed = seed_;
@@ -21,50 +20,106 @@ Maze::Maze(int rows, int cols, unsigned seed_)
         seed = rd();
     }
 
-    generateSolvableMaze(25);  
+    generateSolvableMaze(wallDensity);
+    goals = {goal};
 }
 
+Maze::Maze(BlankTag, int rows, int cols)
+    : grid(max(rows, 5), string(max(cols, 5), '#')),
+      rows(max(rows, 5)), cols(max(cols, 5)), seed(0),
+      start(1, 1), goal(this->rows - 2, this->cols - 2), goals{goal}
+{
+    grid[start.first][start.second] = 'S';
+    grid[goal.first][goal.second] = 'E';
+}
 
-void Maze::generateSolvableMaze(int wallDensity) {
-    
-    // 1. Create the random number generator
-    mt19937 rng(seed);
-    uniform_int_distribution<int> rowDist(1, rows - 2);
-    uniform_int_distribution<int> colDist(1, cols - 2);
-    uniform_int_distribution<int> percent(0, 99);
-
-    // 2. Pick random start (S) and end (E) points *first*
+Maze Maze::blank(int rows, int cols) {
+    return Maze(BlankTag{}, rows, cols);
+}
+
+
+uint64_t Maze::wallFingerprint() const {
+    // FNV-1a over the wall layout
+    uint64_t h = 1469598103934665603ull;
+    for (const string& row : grid) {
+        for (char ch : row) {
+            h ^= (uint64_t)(ch == '#');
+            h *= 1099511628211ull;
+        }
+        h ^= 0xFF;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+void Maze::setStartGoal(pair<int, int> newStart, pair<int, int> newGoal) {
+    grid[start.first][start.second] = ' ';
+    for (auto [r, c] : goals) grid[r][c] = ' ';
+
+    start = newStart;
+    goal  = newGoal;
+    goals = {goal};
+    grid[start.first][start.second] = 'S';
+    grid[goal.first][goal.second]   = 'E';
+}
+
+void Maze::setGoals(const vector<pair<int, int>>& newGoals) {
+    if (newGoals.empty()) return;
+    for (auto [r, c] : goals) {
+        if (grid[r][c] == 'E') grid[r][c] = ' ';
+    }
+
+    goals = newGoals;
+    goal = goals[0];
+    for (auto [r, c] : goals) grid[r][c] = 'E';
+}
+
+Maze::RowGenerator::RowGenerator(long long rows, long long cols, unsigned seed, int wallDensity)
+    : rows(rows), cols(cols), wallDensity(wallDensity), rng(seed)
+{
+    // Same int distributions as before, so existing seeds give the same mazes
+    uniform_int_distribution<int> rowDist(1, (int)rows - 2);
+    uniform_int_distribution<int> colDist(1, (int)cols - 2);
+
+    // Pick random start (S) and end (E) points *first*
     start = {rowDist(rng), colDist(rng)};
     do {
         goal = {rowDist(rng), colDist(rng)};
     } while (start == goal); // Ensure they aren't the same spot
+}
 
-    // 3. Fill the entire grid with walls
-    for (auto& row : grid)
-        fill(row.begin(), row.end(), '#');
-
-    // 4. Carve out the *entire* inside area
-    for (int r = 1; r < rows - 1; ++r) {
-        for (int c = 1; c < cols - 1; ++c) {
-            grid[r][c] = ' ';
-        }
-    }
+void Maze::RowGenerator::nextRow(string& row) {
+    // Border rows and columns are walls, the inside is carved out
+    row.assign(cols, '#');
+    if (r > 0 && r < rows - 1) {
+        for (long long c = 1; c < cols - 1; ++c) {
+            row[c] = ' ';
 
-    // 5. Add random walls inside
-    for (int r = 1; r < rows - 1; ++r) {
-        for (int c = 1; c < cols - 1; ++c) {
             // Don't place a wall on S or E
             if ((r == start.first && c == start.second) ||
                 (r == goal.first  && c == goal.second))
                 continue;
 
             if (percent(rng) < wallDensity) {
-                grid[r][c] = '#';
+                row[c] = '#';
             }
         }
     }
 
-    // 6. Finally, place Start and End
-    grid[start.first][start.second] = 'S';
-    grid[goal.first][goal.second]   = 'E';
+    // Finally, place Start and End
+    if (r == start.first) row[start.second] = 'S';
+    if (r == goal.first)  row[goal.second]  = 'E';
+    ++r;
+}
+
+
+void Maze::generateSolvableMaze(int wallDensity) {
+
+    // Rows are produced in the same order the random numbers are drawn
+    RowGenerator gen(rows, cols, seed, wallDensity);
+    start = gen.getStart();
+    goal  = gen.getGoal();
+
+    for (auto& row : grid)
+        gen.nextRow(row);
 }
\ No newline at end of file
@@ -4,11 +4,19 @@
 #include <vector>
 #include <string>
 #include <utility> 
+#include <random>
+#include <cstdint>
 
 class Maze {
 public:
-    // Construct a maze with given dimensions and optional seed
-    Maze(int rows = 21, int cols = 41, unsigned seed = 0);
+    // Construct a maze with given dimensions and optional seed;
+    // wallDensity is the percentage of inner cells that become walls
+    Maze(int rows = 21, int cols = 41, unsigned seed = 0, int wallDensity = 25);
+
+    // All walls apart from S in the top-left and E in the bottom-right
+    // corner, without running the generator; for callers that only need a
+    // grid of the right size (e.g. a solver about to load a checkpoint)
+    static Maze blank(int rows, int cols);
 
     std::vector<std::string> grid;
 
@@ -18,12 +26,51 @@ public:
     int getRows() const { return rows; }
     int getCols() const { return cols; }
 
+    // Hash of the wall layout only (S/E positions don't change it); used to
+    // check that precomputed data saved next to a maze still matches it
+    std::uint64_t wallFingerprint() const;
+
+    // Moves S and E to new open cells (for running many queries on one maze);
+    // leaves a single goal
+    void setStartGoal(std::pair<int, int> newStart, std::pair<int, int> newGoal);
+
+    // Several goals (exits, pickup points), each marked 'E'. The first one is
+    // getGoal(); BFS, Dijkstra and A* stop at whichever is nearest.
+    void setGoals(const std::vector<std::pair<int, int>>& newGoals);
+    const std::vector<std::pair<int, int>>& getGoals() const { return goals; }
+
+    // Produces the rows of generateSolvableMaze() one at a time, so mazes too
+    // big for memory can be streamed to disk (see TiledMaze). Maze itself is
+    // built from this, so both give identical cells for the same seed.
+    class RowGenerator {
+    public:
+        RowGenerator(long long rows, long long cols, unsigned seed, int wallDensity);
+
+        std::pair<long long, long long> getStart() const { return start; }
+        std::pair<long long, long long> getGoal()  const { return goal;  }
+
+        // Writes the next row (top to bottom) into 'row', resized to cols
+        void nextRow(std::string& row);
+
+    private:
+        long long rows, cols, r = 0;
+        int wallDensity;
+        std::mt19937 rng;
+        std::uniform_int_distribution<int> percent{0, 99};
+        std::pair<long long, long long> start;
+        std::pair<long long, long long> goal;
+    };
+
 private:
+    struct BlankTag {};
+    Maze(BlankTag, int rows, int cols);
+
     int rows;
     int cols;
     unsigned seed;
     std::pair<int, int> start;
     std::pair<int, int> goal;
+    std::vector<std::pair<int, int>> goals; // goals[0] == goal
 
     void generateSolvableMaze(int wallDensity);
 };
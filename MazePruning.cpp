@@ -0,0 +1,99 @@
+#include "MazePruning.h"
+#include "Utils.h"
+#include <string>
+
+using namespace std;
+
+int fillDeadEnds(Maze& maze) {
+    vector<string>& grid = maze.grid;
+    auto openNeighbours = [&](int r, int c) {
+        int degree = 0;
+        for (auto [dr, dc] : directions) {
+            int nr = r + dr, nc = c + dc;
+            degree += isInside(grid, nr, nc) && grid[nr][nc] != '#';
+        }
+        return degree;
+    };
+    auto fillable = [&](int r, int c) {
+        char ch = grid[r][c];
+        return ch != '#' && ch != 'S' && ch != 'E' && openNeighbours(r, c) <= 1;
+    };
+
+    // Filling a dead end can turn its one neighbour into a new dead end
+    vector<pair<int, int>> stack;
+    for (int r = 0; r < (int)grid.size(); ++r) {
+        for (int c = 0; c < (int)grid[r].size(); ++c) {
+            if (fillable(r, c)) stack.push_back({r, c});
+        }
+    }
+
+    int filled = 0;
+    while (!stack.empty()) {
+        auto [r, c] = stack.back();
+        stack.pop_back();
+        if (!fillable(r, c)) continue;
+        grid[r][c] = '#';
+        filled++;
+        for (auto [dr, dc] : directions) {
+            int nr = r + dr, nc = c + dc;
+            if (isInside(grid, nr, nc) && fillable(nr, nc)) stack.push_back({nr, nc});
+        }
+    }
+    return filled;
+}
+
+void RectangleSymmetry::build(const Maze& maze) {
+    const vector<string>& grid = maze.grid;
+    m_rows = maze.getRows();
+    m_cols = maze.getCols();
+    m_rects.clear();
+    m_interior.assign((size_t)m_rows * m_cols, -1);
+    m_interiorCells = 0;
+
+    // Cells a new rectangle may use: open, not S/E, not in another rectangle
+    vector<uint8_t> used((size_t)m_rows * m_cols, 0);
+    auto freeCell = [&](int r, int c) {
+        if (r >= m_rows || c >= m_cols) return false;
+        char ch = grid[r][c];
+        return ch != '#' && ch != 'S' && ch != 'E' && !used[(size_t)r * m_cols + c];
+    };
+    auto freeRow = [&](int r, int c0, int c1) {
+        for (int c = c0; c <= c1; ++c) if (!freeCell(r, c)) return false;
+        return true;
+    };
+    auto freeCol = [&](int c, int r0, int r1) {
+        for (int r = r0; r <= r1; ++r) if (!freeCell(r, c)) return false;
+        return true;
+    };
+
+    // Greedy, in row-major order: the largest square from each free cell,
+    // then stretched right and down as far as it stays empty
+    for (int r = 0; r < m_rows; ++r) {
+        for (int c = 0; c < m_cols; ++c) {
+            if (!freeCell(r, c)) continue;
+
+            int bottom = r, right = c;
+            while (freeRow(bottom + 1, c, right + 1) && freeCol(right + 1, r, bottom)) {
+                bottom++;
+                right++;
+            }
+            while (freeCol(right + 1, r, bottom)) right++;
+            while (freeRow(bottom + 1, c, right)) bottom++;
+
+            // Needs at least one interior cell to save anything
+            if (bottom - r < 2 || right - c < 2) continue;
+
+            int32_t id = (int32_t)m_rects.size();
+            m_rects.push_back({r, c, bottom, right});
+            for (int y = r; y <= bottom; ++y) {
+                for (int x = c; x <= right; ++x) {
+                    used[(size_t)y * m_cols + x] = 1;
+                    if (y > r && y < bottom && x > c && x < right) {
+                        m_interior[(size_t)y * m_cols + x] = id;
+                        m_interiorCells++;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef MAZE_PRUNING_H
+#define MAZE_PRUNING_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Maze.h"
+
+// Optional preprocessing that removes cells an optimal search never needs.
+// Both passes keep every shortest start-goal path length unchanged.
+
+// Dead-end filling: repeatedly walls up open cells with at most one open
+// neighbour, other than S and E. No simple start-goal path can pass through
+// them. Works with every solver, since it only adds walls. Returns the
+// number of cells filled.
+int fillDeadEnds(Maze& maze);
+
+// Rectangular Symmetry Reduction (Harabor & Botea) for 4-connected grids.
+// Empty regions are covered by non-overlapping rectangles of at least 3 x 3
+// cells. Their interiors are never expanded: a move from a perimeter cell
+// into the interior jumps straight across to the opposite side, at the cost
+// of the cells crossed. Between two perimeter cells, a run along the
+// perimeter plus at most one jump is as short as any path through the
+// interior, so optimality is kept. S and E are never inside a rectangle.
+//
+// The jumps have costs above 1, so only the weighted solvers can use this
+// (AStar_Solver, Dijkstra_Solver); BFS can still use fillDeadEnds().
+class RectangleSymmetry {
+public:
+    RectangleSymmetry() = default;
+    explicit RectangleSymmetry(const Maze& maze) { build(maze); }
+
+    void build(const Maze& maze);
+
+    // (nr, nc) is a neighbour of (r, c). If it is inside a rectangle, moves
+    // it to the far side of that rectangle and sets cost to the distance.
+    void jump(int r, int c, int& nr, int& nc, int& cost) const {
+        std::int32_t id = m_interior[(std::size_t)nr * m_cols + nc];
+        if (id < 0) return;
+        const Rect& rect = m_rects[id];
+        if (nr > r) nr = rect.bottom;
+        else if (nr < r) nr = rect.top;
+        else if (nc > c) nc = rect.right;
+        else nc = rect.left;
+        cost = (nr - r) + (nc - c);
+        if (cost < 0) cost = -cost;
+    }
+
+    bool isInterior(int r, int c) const { return m_interior[(std::size_t)r * m_cols + c] >= 0; }
+    std::size_t getRectangleCount() const { return m_rects.size(); }
+    std::size_t getInteriorCells() const { return m_interiorCells; }
+
+private:
+    struct Rect {
+        int top, left, bottom, right; // Inclusive bounds, perimeter included
+    };
+
+    int m_rows = 0, m_cols = 0;
+    std::vector<Rect> m_rects;
+    std::vector<std::int32_t> m_interior; // Rectangle id for interior cells, -1 otherwise
+    std::size_t m_interiorCells = 0;
+};
+
+#endif // MAZE_PRUNING_H
@@ -0,0 +1,15 @@
+#ifndef MAZESOURCE_H
+#define MAZESOURCE_H
+
+// Read-only access to cells by coordinate, for mazes that are never held as
+// one grid (TiledMaze on disk, InfiniteMaze generated on demand).
+// Coordinates outside the maze are simply not open.
+class MazeSource {
+public:
+    virtual ~MazeSource() = default;
+
+    // True if (r, c) exists and is not a wall
+    virtual bool isOpen(long long r, long long c) = 0;
+};
+
+#endif // MAZESOURCE_H
@@ -0,0 +1,311 @@
+#include "MazeView.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+MazeView::MazeView(float x, float y, float width, float height)
+    : m_x(x), m_y(y), m_width(width), m_height(height) {}
+
+uint16_t* MazeView::layer(Counts& counts, Cell cell) {
+    switch (cell) {
+        case Cell::Wall:     return &counts.walls;
+        case Cell::Frontier: return &counts.frontier;
+        case Cell::Explored: return &counts.explored;
+        case Cell::Path:     return &counts.path;
+        default:             return nullptr;
+    }
+}
+
+void MazeView::setGrid(const vector<string>& grid) {
+    TRACE_SCOPE("MazeView::setGrid");
+    int rows = (int)grid.size(), cols = rows ? (int)grid[0].size() : 0;
+    bool resized = rows != m_rows || cols != m_cols;
+    m_rows = rows;
+    m_cols = cols;
+    m_startId = m_goalId = -1;
+    m_cells.assign((size_t)rows * cols, Cell::Open);
+
+    // Any other character is a solver's symbol
+    Cell kind[256];
+    fill(begin(kind), end(kind), Cell::Explored);
+    kind[(unsigned char)' '] = Cell::Open;
+    kind[(unsigned char)'#'] = Cell::Wall;
+    kind[(unsigned char)'S'] = Cell::Start;
+    kind[(unsigned char)'E'] = Cell::Goal;
+    kind[(unsigned char)'X'] = Cell::Path;
+
+    for (int r = 0; r < rows; ++r) {
+        Cell* row = &m_cells[(size_t)r * cols];
+        const char* text = grid[r].data();
+        for (int c = 0; c < cols; ++c) {
+            row[c] = kind[(unsigned char)text[c]];
+            if (row[c] == Cell::Start) m_startId = r * cols + c;
+            if (row[c] == Cell::Goal) m_goalId = r * cols + c;
+        }
+    }
+    buildPyramid();
+    if (resized) fit();
+}
+
+void MazeView::buildPyramid() {
+    m_levels.clear();
+    if (m_cells.empty()) return;
+
+    // First level straight from the cells, every level above from the one below
+    for (int level = FIRST_LEVEL; level <= MAX_LEVEL; ++level) {
+        int shift = level;
+        Level next;
+        next.rows = ((m_rows - 1) >> shift) + 1;
+        next.cols = ((m_cols - 1) >> shift) + 1;
+        next.counts.assign((size_t)next.rows * next.cols, Counts());
+
+        if (m_levels.empty()) {
+            for (int r = 0; r < m_rows; ++r) {
+                const Cell* row = &m_cells[(size_t)r * m_cols];
+                Counts* blocks = &next.counts[(size_t)(r >> shift) * next.cols];
+                for (int c = 0; c < m_cols; ++c) {
+                    if (row[c] == Cell::Open) continue;
+                    if (uint16_t* n = layer(blocks[c >> shift], row[c])) ++*n;
+                }
+            }
+        } else {
+            const Level& below = m_levels.back();
+            for (int r = 0; r < below.rows; ++r) {
+                for (int c = 0; c < below.cols; ++c) {
+                    const Counts& from = below.counts[(size_t)r * below.cols + c];
+                    Counts& to = next.counts[(size_t)(r >> 1) * next.cols + (c >> 1)];
+                    to.walls += from.walls;
+                    to.frontier += from.frontier;
+                    to.explored += from.explored;
+                    to.path += from.path;
+                }
+            }
+        }
+        m_levels.push_back(move(next));
+        if (m_levels.back().counts.size() == 1) break; // One block covers the maze
+    }
+}
+
+void MazeView::setCell(int r, int c, Cell cell) {
+    Cell& old = m_cells[(size_t)r * m_cols + c];
+    if (old == cell) return;
+
+    for (size_t i = 0; i < m_levels.size(); ++i) {
+        int shift = FIRST_LEVEL + (int)i;
+        Level& level = m_levels[i];
+        Counts& block = level.counts[(size_t)(r >> shift) * level.cols + (c >> shift)];
+        if (uint16_t* n = layer(block, old)) --*n;
+        if (uint16_t* n = layer(block, cell)) ++*n;
+    }
+    old = cell;
+}
+
+void MazeView::apply(const EventLog::Event& e) {
+    int r = (int)e.cell / m_cols, c = (int)e.cell % m_cols;
+    Cell current = m_cells[e.cell];
+    if (current == Cell::Start || current == Cell::Goal || current == Cell::Wall) return;
+
+    switch (e.type) {
+        case EventLog::Type::Expanded: if (current != Cell::Path) setCell(r, c, Cell::Explored); break;
+        case EventLog::Type::Enqueued: if (current == Cell::Open) setCell(r, c, Cell::Frontier); break;
+        case EventLog::Type::Path:     setCell(r, c, Cell::Path); break;
+        default: break;
+    }
+}
+
+void MazeView::setColors(sf::Color explored, sf::Color frontier) {
+    m_explored = explored;
+    m_frontier = frontier;
+}
+
+sf::Color MazeView::cellColor(Cell cell) const {
+    switch (cell) {
+        case Cell::Wall:     return sf::Color(50, 50, 50);
+        case Cell::Start:    return sf::Color::Green;
+        case Cell::Goal:     return sf::Color::Yellow;
+        case Cell::Frontier: return m_frontier;
+        case Cell::Explored: return m_explored;
+        case Cell::Path:     return sf::Color::Red;
+        default:             return sf::Color::White;
+    }
+}
+
+sf::Color MazeView::blockColor(const Counts& counts, int area) const {
+    // Keep the path visible at any zoom
+    if (counts.path > 0) return sf::Color::Red;
+
+    // Average of the cells' colours; start and goal count as open
+    int open = area - counts.walls - counts.frontier - counts.explored;
+    sf::Color wall = cellColor(Cell::Wall), white = sf::Color::White;
+    auto mix = [&](uint8_t sf::Color::*channel) {
+        int sum = open * (white.*channel) + counts.walls * (wall.*channel) +
+                  counts.frontier * (m_frontier.*channel) + counts.explored * (m_explored.*channel);
+        return (uint8_t)(sum / area);
+    };
+    return sf::Color(mix(&sf::Color::r), mix(&sf::Color::g), mix(&sf::Color::b), mix(&sf::Color::a));
+}
+
+// ---- Camera ----
+
+void MazeView::fit() {
+    if (m_rows == 0) return;
+    m_zoom = min(MAX_ZOOM, min(m_width / m_cols, m_height / m_rows));
+    m_minZoom = m_zoom * 0.5f;
+    m_centerR = m_rows / 2.0f;
+    m_centerC = m_cols / 2.0f;
+}
+
+void MazeView::zoomAt(float x, float y, float factor) {
+    float midX = m_x + m_width / 2, midY = m_y + m_height / 2;
+    float c = m_centerC + (x - midX) / m_zoom;
+    float r = m_centerR + (y - midY) / m_zoom;
+
+    m_zoom = max(m_minZoom, min(MAX_ZOOM, m_zoom * factor));
+    m_centerC = c - (x - midX) / m_zoom;
+    m_centerR = r - (y - midY) / m_zoom;
+    clampCenter();
+}
+
+void MazeView::pan(float dx, float dy) {
+    m_centerC -= dx / m_zoom;
+    m_centerR -= dy / m_zoom;
+    clampCenter();
+}
+
+void MazeView::clampCenter() {
+    m_centerC = max(0.0f, min((float)m_cols, m_centerC));
+    m_centerR = max(0.0f, min((float)m_rows, m_centerR));
+}
+
+bool MazeView::handleEvent(const sf::Event& event) {
+    auto inside = [&](int x, int y) {
+        return x >= m_x && x < m_x + m_width && y >= m_y && y < m_y + m_height;
+    };
+
+    switch (event.type) {
+        case sf::Event::MouseWheelScrolled:
+            if (!inside(event.mouseWheelScroll.x, event.mouseWheelScroll.y)) return false;
+            zoomAt((float)event.mouseWheelScroll.x, (float)event.mouseWheelScroll.y,
+                   pow(1.25f, event.mouseWheelScroll.delta));
+            return true;
+
+        case sf::Event::MouseButtonPressed:
+            if (event.mouseButton.button != sf::Mouse::Left) return false;
+            if (!inside(event.mouseButton.x, event.mouseButton.y)) return false;
+            m_dragging = true;
+            m_dragX = event.mouseButton.x;
+            m_dragY = event.mouseButton.y;
+            return true;
+
+        case sf::Event::MouseButtonReleased:
+            if (event.mouseButton.button != sf::Mouse::Left || !m_dragging) return false;
+            m_dragging = false;
+            return true;
+
+        case sf::Event::MouseMoved:
+            if (!m_dragging) return false;
+            pan((float)(event.mouseMove.x - m_dragX), (float)(event.mouseMove.y - m_dragY));
+            m_dragX = event.mouseMove.x;
+            m_dragY = event.mouseMove.y;
+            return true;
+
+        case sf::Event::KeyPressed: {
+            float midX = m_x + m_width / 2, midY = m_y + m_height / 2;
+            switch (event.key.code) {
+                case sf::Keyboard::Equal:
+                case sf::Keyboard::Add:      zoomAt(midX, midY, 1.25f); return true;
+                case sf::Keyboard::Hyphen:
+                case sf::Keyboard::Subtract: zoomAt(midX, midY, 0.8f); return true;
+                case sf::Keyboard::W:        pan(0, m_height / 8); return true;
+                case sf::Keyboard::S:        pan(0, -m_height / 8); return true;
+                case sf::Keyboard::A:        pan(m_width / 8, 0); return true;
+                case sf::Keyboard::D:        pan(-m_width / 8, 0); return true;
+                case sf::Keyboard::Num0:     fit(); return true;
+                default:                     return false;
+            }
+        }
+        default:
+            return false;
+    }
+}
+
+sf::Vector2f MazeView::toScreen(float c, float r) const {
+    return sf::Vector2f(m_x + m_width / 2 + (c - m_centerC) * m_zoom, m_y + m_height / 2 + (r - m_centerR) * m_zoom);
+}
+
+void MazeView::visibleCells(int& r0, int& c0, int& r1, int& c1) const {
+    c0 = max(0, (int)floor(m_centerC - m_width / 2 / m_zoom));
+    c1 = min(m_cols, (int)ceil(m_centerC + m_width / 2 / m_zoom));
+    r0 = max(0, (int)floor(m_centerR - m_height / 2 / m_zoom));
+    r1 = min(m_rows, (int)ceil(m_centerR + m_height / 2 / m_zoom));
+}
+
+int MazeView::getLevel() const {
+    if (m_zoom >= MIN_CELL_PIXELS || m_levels.empty()) return 0;
+    int level = FIRST_LEVEL;
+    while (level - FIRST_LEVEL + 1 < (int)m_levels.size() && m_zoom * (1 << level) < MIN_CELL_PIXELS) level++;
+    return level;
+}
+
+// ---- Drawing ----
+
+void MazeView::addQuad(float x0, float y0, float x1, float y1, sf::Color color) {
+    m_quads.append(sf::Vertex(sf::Vector2f(x0, y0), color));
+    m_quads.append(sf::Vertex(sf::Vector2f(x1, y0), color));
+    m_quads.append(sf::Vertex(sf::Vector2f(x1, y1), color));
+    m_quads.append(sf::Vertex(sf::Vector2f(x0, y1), color));
+}
+
+void MazeView::draw(sf::RenderWindow& window) {
+    TRACE_SCOPE("MazeView::draw");
+    m_quads.clear();
+    if (m_cells.empty()) return;
+
+    int r0, c0, r1, c1;
+    visibleCells(r0, c0, r1, c1);
+    int level = getLevel();
+
+    if (level == 0) {
+        for (int r = r0; r < r1; ++r) {
+            for (int c = c0; c < c1; ++c) {
+                sf::Vector2f a = toScreen((float)c, (float)r);
+                addQuad(a.x, a.y, a.x + m_zoom, a.y + m_zoom, cellColor(m_cells[(size_t)r * m_cols + c]));
+            }
+        }
+    } else {
+        const Level& blocks = m_levels[level - FIRST_LEVEL];
+        int size = 1 << level;
+        for (int br = r0 >> level; br <= (r1 - 1) >> level; ++br) {
+            for (int bc = c0 >> level; bc <= (c1 - 1) >> level; ++bc) {
+                // Blocks on the bottom and right edges may be cut short by the maze
+                int top = br * size, left = bc * size;
+                int bottom = min(m_rows, top + size), right = min(m_cols, left + size);
+                sf::Vector2f a = toScreen((float)left, (float)top), b = toScreen((float)right, (float)bottom);
+                addQuad(a.x, a.y, b.x, b.y,
+                        blockColor(blocks.counts[(size_t)br * blocks.cols + bc], (bottom - top) * (right - left)));
+            }
+        }
+    }
+    m_drawnQuads = m_quads.getVertexCount() / 4;
+
+    // Start and goal stay at least a few pixels across however far out the view is
+    float marker = max(m_zoom, 6.0f);
+    for (int id : {m_startId, m_goalId}) {
+        if (id < 0) continue;
+        sf::Vector2f mid = toScreen(id % m_cols + 0.5f, id / m_cols + 0.5f);
+        addQuad(mid.x - marker / 2, mid.y - marker / 2, mid.x + marker / 2, mid.y + marker / 2,
+                cellColor(m_cells[id]));
+    }
+    drawClipped(window, m_quads);
+}
+
+void MazeView::drawClipped(sf::RenderWindow& window, const sf::Drawable& drawable) const {
+    sf::Vector2u size = window.getSize();
+    sf::View clip(sf::FloatRect(m_x, m_y, m_width, m_height));
+    clip.setViewport(sf::FloatRect(m_x / size.x, m_y / size.y, m_width / size.x, m_height / size.y));
+    window.setView(clip);
+    window.draw(drawable);
+    window.setView(window.getDefaultView());
+}
@@ -0,0 +1,97 @@
+#ifndef MAZE_VIEW_H
+#define MAZE_VIEW_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <SFML/Graphics.hpp>
+#include "EventLog.h"
+
+// Pan/zoom camera over a maze, for the windows in main_gui.cpp.
+// Only cells inside the view are drawn, so the cost of a frame depends on the
+// window size, not the maze size. Once cells get smaller than MIN_CELL_PIXELS
+// it draws blocks of 2^k x 2^k cells instead, read from a mip pyramid. Each
+// block counts its wall, frontier, explored and path cells and is drawn in
+// their average colour (red if the path crosses it).
+// setCell() updates one block per level, so the pyramid follows a running
+// solver without being rebuilt.
+//
+// Controls (handleEvent): mouse wheel or +/- zoom, left drag or W/A/S/D pan,
+// 0 fits the whole maze.
+class MazeView {
+public:
+    enum class Cell : std::uint8_t { Open, Wall, Start, Goal, Frontier, Explored, Path };
+
+    static constexpr float MIN_CELL_PIXELS = 3.0f; // Smaller cells are drawn as blocks
+    static constexpr float MAX_ZOOM = 64.0f;       // Pixels per cell
+    static constexpr int FIRST_LEVEL = 2;          // Smallest block: 4 x 4 cells
+    static constexpr int MAX_LEVEL = 7;            // Largest block: 128 x 128 (fits the 16-bit counts)
+
+    // The screen rectangle the maze is drawn into
+    MazeView(float x, float y, float width, float height);
+
+    // Replaces every cell: '#' wall, ' ' open, 'S'/'E', 'X' path and anything
+    // else explored, like the solvers' grids. A maze of a new size is fitted.
+    void setGrid(const std::vector<std::string>& grid);
+    void setCell(int r, int c, Cell cell);
+    // Applies one solver event (see EventLog); start and goal keep their colours
+    void apply(const EventLog::Event& e);
+
+    void setColors(sf::Color explored, sf::Color frontier);
+
+    // Camera
+    void fit();
+    void zoomAt(float x, float y, float factor); // Keeps the cell under (x, y) in place
+    void pan(float dx, float dy);                // In pixels
+    // Mouse and key controls; returns true if the event was used
+    bool handleEvent(const sf::Event& event);
+
+    void draw(sf::RenderWindow& window);
+    // Draws screen-space geometry (e.g. an overlay) clipped to the view's rectangle
+    void drawClipped(sf::RenderWindow& window, const sf::Drawable& drawable) const;
+
+    float getZoom() const { return m_zoom; }
+    // Pyramid level draw() uses at the current zoom (0 = single cells)
+    int getLevel() const;
+    // Screen position of a point in cell coordinates (column, row)
+    sf::Vector2f toScreen(float c, float r) const;
+    // Cells at least partly on screen: rows [r0, r1), columns [c0, c1)
+    void visibleCells(int& r0, int& c0, int& r1, int& c1) const;
+    std::size_t getDrawnQuads() const { return m_drawnQuads; }
+
+private:
+    struct Counts {
+        std::uint16_t walls = 0, frontier = 0, explored = 0, path = 0;
+    };
+    struct Level {
+        int rows = 0, cols = 0;
+        std::vector<Counts> counts;
+    };
+
+    static std::uint16_t* layer(Counts& counts, Cell cell); // nullptr for open, start, goal
+    sf::Color cellColor(Cell cell) const;
+    sf::Color blockColor(const Counts& counts, int area) const;
+    void buildPyramid();
+    void clampCenter();
+    void addQuad(float x0, float y0, float x1, float y1, sf::Color color);
+
+    float m_x, m_y, m_width, m_height;
+    int m_rows = 0, m_cols = 0;
+    std::vector<Cell> m_cells;
+    std::vector<Level> m_levels; // m_levels[i] has blocks of 2^(FIRST_LEVEL + i) cells
+    int m_startId = -1, m_goalId = -1;
+
+    sf::Color m_explored = sf::Color(0, 150, 255);
+    sf::Color m_frontier = sf::Color::White;
+
+    float m_centerR = 0, m_centerC = 0; // Cell coordinates at the middle of the view
+    float m_zoom = 1, m_minZoom = 1;
+    bool m_dragging = false;
+    int m_dragX = 0, m_dragY = 0;
+
+    sf::VertexArray m_quads{sf::Quads};
+    std::size_t m_drawnQuads = 0;
+};
+
+#endif // MAZE_VIEW_H
@@ -0,0 +1,96 @@
+#include "OpenWorldSearch.h"
+#include "Utils.h"
+#include <queue>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+// Cells are keyed by their two coordinates packed as 32-bit values
+static uint64_t cellKey(long long r, long long c) {
+    return ((uint64_t)(uint32_t)(int32_t)r << 32) | (uint32_t)(int32_t)c;
+}
+
+static OpenWorldSearch::Cell cellOf(uint64_t key) {
+    return {(long long)(int32_t)(uint32_t)(key >> 32), (long long)(int32_t)(uint32_t)key};
+}
+
+OpenWorldSearch::Result OpenWorldSearch::search(Cell start, Cell goal, uint64_t maxExpansions) {
+    struct Node {
+        long long g;
+        uint64_t parent;
+        bool closed;
+    };
+    struct Entry {
+        long long f, g;
+        uint64_t key;
+        // Lowest f first; among equal f prefer the deeper node
+        bool operator>(const Entry& o) const { return f != o.f ? f > o.f : g < o.g; }
+    };
+    auto heuristic = [&](long long r, long long c) {
+        return llabs(goal.first - r) + llabs(goal.second - c);
+    };
+
+    Result result;
+    if (!m_source.isOpen(start.first, start.second) || !m_source.isOpen(goal.first, goal.second)) {
+        return result;
+    }
+
+    unordered_map<uint64_t, Node> nodes;
+    priority_queue<Entry, vector<Entry>, greater<Entry>> open;
+
+    uint64_t startKey = cellKey(start.first, start.second);
+    uint64_t goalKey = cellKey(goal.first, goal.second);
+    nodes[startKey] = {0, startKey, false};
+    open.push({heuristic(start.first, start.second), 0, startKey});
+
+    while (!open.empty()) {
+        result.peakOpen = max(result.peakOpen, open.size());
+        Entry cur = open.top();
+        open.pop();
+
+        Node& node = nodes[cur.key];
+        if (node.closed || cur.g != node.g) continue; // Stale entry
+        node.closed = true;
+
+        if (cur.key == goalKey) {
+            result.found = true;
+            result.distance = cur.g;
+            for (uint64_t k = goalKey; ; k = nodes[k].parent) {
+                result.path.push_back(cellOf(k));
+                if (k == startKey) break;
+            }
+            reverse(result.path.begin(), result.path.end());
+            break;
+        }
+        if (result.expanded == maxExpansions) {
+            result.budgetExhausted = true;
+            break;
+        }
+        result.expanded++;
+
+        Cell here = cellOf(cur.key);
+        for (auto [dr, dc] : directions) {
+            long long nr = here.first + dr, nc = here.second + dc;
+            if (!m_source.isOpen(nr, nc)) continue;
+
+            uint64_t nextKey = cellKey(nr, nc);
+            long long g = cur.g + 1;
+            auto [it, inserted] = nodes.try_emplace(nextKey, Node{g, cur.key, false});
+            if (!inserted) {
+                if (it->second.closed || g >= it->second.g) continue;
+                it->second.g = g;
+                it->second.parent = cur.key;
+            }
+            open.push({g + heuristic(nr, nc), g, nextKey});
+        }
+    }
+
+    result.touched = nodes.size();
+    // Map nodes plus bucket array, and the heap
+    result.bookkeepingBytes = nodes.size() * (sizeof(pair<const uint64_t, Node>) + 2 * sizeof(void*))
+                            + nodes.bucket_count() * sizeof(void*)
+                            + result.peakOpen * sizeof(Entry);
+    return result;
+}
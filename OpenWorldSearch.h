@@ -0,0 +1,39 @@
+#ifndef OPENWORLDSEARCH_H
+#define OPENWORLDSEARCH_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include "MazeSource.h"
+
+// A* over a MazeSource with no fixed bounds (InfiniteMaze, TiledMaze).
+// Nothing is allocated per maze cell: g-scores and parents live in a hash map
+// keyed by cell, so memory grows with the cells the search touches, and the
+// source only materialises the chunks the frontier reaches.
+class OpenWorldSearch {
+public:
+    using Cell = std::pair<long long, long long>;
+
+    struct Result {
+        bool found = false;
+        bool budgetExhausted = false; // Stopped at maxExpansions
+        long long distance = -1;
+        std::vector<Cell> path;       // Start to goal
+        std::uint64_t expanded = 0;
+        std::uint64_t touched = 0;    // Cells given a g-score
+        std::size_t peakOpen = 0;
+        std::size_t bookkeepingBytes = 0; // Approximate size of the search state
+    };
+
+    explicit OpenWorldSearch(MazeSource& source) : m_source(source) {}
+
+    // In an unbounded maze an unreachable goal would never be proven
+    // unreachable, so the search gives up after maxExpansions
+    Result search(Cell start, Cell goal, std::uint64_t maxExpansions = 10000000);
+
+private:
+    MazeSource& m_source;
+};
+
+#endif // OPENWORLDSEARCH_H
@@ -0,0 +1,222 @@
+#include "ParallelBFS_Solver.h"
+
+using namespace std;
+
+ParallelBFS_Solver::ParallelBFS_Solver(const Maze& maze, unsigned threads)
+    : Solver(maze, 'P'),
+      R(maze.getRows()),
+      C(maze.getCols()),
+      m_pool(threads)
+{
+    // Flat wall map so worker threads never read 'grid' while others colour it
+    open.assign((size_t)R * C, 0);
+    for (int r = 0; r < R; ++r) {
+        for (int c = 0; c < C; ++c) {
+            if (grid[r][c] != '#') {
+                open[(size_t)r * C + c] = 1;
+                m_openCells++;
+            }
+        }
+    }
+    degree.assign((size_t)R * C, 0);
+    for (int r = 0; r < R; ++r) {
+        for (int c = 0; c < C; ++c) {
+            if (!open[(size_t)r * C + c]) continue;
+            for (auto [dr, dc] : directions) {
+                int nr = r + dr, nc = c + dc;
+                if (nr >= 0 && nc >= 0 && nr < R && nc < C && open[(size_t)nr * C + nc]) degree[(size_t)r * C + c]++;
+            }
+            m_unvisitedEdges += degree[(size_t)r * C + c];
+        }
+    }
+
+    m_words = ((size_t)R * C + 63) / 64;
+    visitedBits.reset(new atomic<uint64_t>[m_words]);
+    frontierBits.reset(new atomic<uint64_t>[m_words]);
+    for (size_t i = 0; i < m_words; ++i) {
+        visitedBits[i].store(0, memory_order_relaxed);
+        frontierBits[i].store(0, memory_order_relaxed);
+    }
+
+    localNext.resize(m_pool.size());
+
+    int s = start.first * C + start.second;
+    claim(s);
+    frontier.push_back(s);
+    m_frontierEdges = degree[s];
+    m_unvisitedEdges -= degree[s];
+
+    // Start the algorithm's timer
+    m_clock.restart();
+}
+
+bool ParallelBFS_Solver::claim(int id) {
+    uint64_t mask = uint64_t(1) << (id & 63);
+    // Only the thread that flips the bit owns the cell (parent, colour, buffer)
+    return (visitedBits[id >> 6].fetch_or(mask, memory_order_relaxed) & mask) == 0;
+}
+
+bool ParallelBFS_Solver::isVisited(int id) const {
+    return (visitedBits[id >> 6].load(memory_order_relaxed) >> (id & 63)) & 1;
+}
+
+void ParallelBFS_Solver::expandTopDown() {
+    m_pool.parallelFor(frontier.size(), [&](unsigned t, size_t begin, size_t end) {
+        vector<int>& next = localNext[t];
+        for (size_t i = begin; i < end; ++i) {
+            int u = frontier[i];
+            int r = u / C, c = u % C;
+            if (grid[r][c] == ' ') grid[r][c] = symbol;
+
+            for (auto [dr, dc] : directions) {
+                int nr = r + dr, nc = c + dc;
+                if (nr < 0 || nc < 0 || nr >= R || nc >= C) continue;
+                int v = nr * C + nc;
+                if (!open[v] || isVisited(v)) continue; // Cheap pre-check before the atomic RMW
+                if (!claim(v)) continue;
+
+                parent[nr][nc] = {r, c};
+                next.push_back(v);
+            }
+        }
+    });
+}
+
+void ParallelBFS_Solver::expandBottomUp() {
+    // Publish the current frontier as a bitmap
+    m_pool.parallelFor(frontier.size(), [&](unsigned, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            int u = frontier[i];
+            frontierBits[u >> 6].fetch_or(uint64_t(1) << (u & 63), memory_order_relaxed);
+            int r = u / C, c = u % C;
+            if (grid[r][c] == ' ') grid[r][c] = symbol;
+        }
+    });
+
+    // Every unvisited open cell looks for a parent in the frontier.
+    // Work is split by whole bitmap words so threads never share one.
+    m_pool.parallelFor(m_words, [&](unsigned t, size_t begin, size_t end) {
+        vector<int>& next = localNext[t];
+        int total = R * C;
+        for (size_t w = begin; w < end; ++w) {
+            uint64_t seen = visitedBits[w].load(memory_order_relaxed);
+            if (seen == ~uint64_t(0)) continue;
+
+            int first = (int)(w * 64);
+            int last  = min(total, first + 64);
+            for (int v = first; v < last; ++v) {
+                if (!open[v] || ((seen >> (v & 63)) & 1)) continue;
+                int r = v / C, c = v % C;
+
+                for (auto [dr, dc] : directions) {
+                    int pr = r + dr, pc = c + dc;
+                    if (pr < 0 || pc < 0 || pr >= R || pc >= C) continue;
+                    int u = pr * C + pc;
+                    if (!((frontierBits[u >> 6].load(memory_order_relaxed) >> (u & 63)) & 1)) continue;
+
+                    // This thread owns word w, so a plain claim is uncontended
+                    claim(v);
+                    parent[r][c] = {pr, pc};
+                    next.push_back(v);
+                    break;
+                }
+            }
+        }
+    });
+
+    // Clear only the words we touched
+    m_pool.parallelFor(frontier.size(), [&](unsigned, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            frontierBits[frontier[i] >> 6].store(0, memory_order_relaxed);
+        }
+    });
+}
+
+void ParallelBFS_Solver::step() {
+
+    if (currentState == State::TRACING_PATH) {
+
+        // Count this node as part of the final path
+        m_pathLength++;
+
+        if (tracePos == start) {
+            currentState = State::DONE;
+            return;
+        }
+        if (grid[tracePos.first][tracePos.second] != 'E') {
+            grid[tracePos.first][tracePos.second] = 'X';
+            logEvent(EventLog::Type::Path, tracePos.first, tracePos.second);
+        }
+        tracePos = parent[tracePos.first][tracePos.second];
+        return;
+    }
+
+    if (currentState != State::SEARCHING) return;
+
+    // Empty frontier means path not found
+    if (frontier.empty()) {
+        currentState = State::DONE;
+        found = false;
+
+        // Stop the clock if the search fails
+        m_timeTaken = m_clock.getElapsedTime();
+
+        return;
+    }
+
+    // Decide the direction for this level
+    long long frontierSize = (long long)frontier.size();
+    if (!m_bottomUp && m_frontierEdges * ALPHA > m_unvisitedEdges) {
+        m_bottomUp = true;
+    } else if (m_bottomUp && frontierSize * BETA < m_openCells && frontier.size() < m_lastFrontier) {
+        m_bottomUp = false;
+    }
+    m_lastFrontier = frontier.size();
+
+    // Every cell of the level is processed in this step
+    m_nodesExplored += (int)frontier.size();
+
+    // Events are logged here on the calling thread, never from the workers
+    if (m_events) {
+        for (int u : frontier) logEvent(EventLog::Type::Expanded, u / C, u % C);
+    }
+
+    if (m_bottomUp) {
+        expandBottomUp();
+        m_bottomUpLevels++;
+    } else {
+        expandTopDown();
+    }
+    m_level++;
+
+    // Concatenate the thread-local buffers into the next frontier
+    frontier.clear();
+    for (auto& next : localNext) {
+        frontier.insert(frontier.end(), next.begin(), next.end());
+        next.clear();
+    }
+    m_frontierEdges = 0;
+    for (int v : frontier) m_frontierEdges += degree[v];
+    m_unvisitedEdges -= m_frontierEdges;
+    if (m_events) {
+        for (int v : frontier) logEvent(EventLog::Type::Enqueued, v / C, v % C);
+    }
+
+    // Goal claimed during this level, switch to tracing
+    if (isVisited(goal.first * C + goal.second)) {
+        found = true;
+        m_goalDistance = m_level;
+        currentState = State::TRACING_PATH;
+        tracePos = goal;
+
+        // Stop the clock on success
+        m_timeTaken = m_clock.getElapsedTime();
+    }
+}
+
+size_t ParallelBFS_Solver::getMemoryBytes() const {
+    size_t bytes = Solver::getMemoryBytes() + open.capacity() + degree.capacity() + 2 * m_words * sizeof(uint64_t) +
+                   frontier.capacity() * sizeof(int);
+    for (const vector<int>& next : localNext) bytes += next.capacity() * sizeof(int);
+    return bytes;
+}
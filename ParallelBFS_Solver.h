@@ -0,0 +1,74 @@
+#ifndef PARALLEL_BFS_SOLVER_H
+#define PARALLEL_BFS_SOLVER_H
+
+#include "Solver.h"
+#include "Utils.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <SFML/System/Clock.hpp>
+
+// Level-synchronous parallel BFS (direction-optimising).
+// Each step() expands one whole BFS level across the thread pool:
+//  - top-down: the frontier is split between threads, neighbours are claimed
+//    with an atomic visited bitmap and pushed into thread-local buffers
+//  - bottom-up: when the frontier is large, every unvisited cell checks if
+//    one of its neighbours is in the frontier instead
+// Distances (and so path lengths) are identical to BFS_Solver.
+class ParallelBFS_Solver : public Solver {
+public:
+    // threads == 0 means "one per hardware core"
+    explicit ParallelBFS_Solver(const Maze& maze, unsigned threads = 0);
+
+    void step() override;
+
+    // Performance HUD readings (see Solver.h)
+    std::size_t getOpenSetSize() const override { return frontier.size(); }
+    std::size_t getMemoryBytes() const override;
+
+    // BFS level of the goal, or -1 if it has not been reached
+    int getGoalDistance() const { return m_goalDistance; }
+    unsigned getThreadCount() const { return m_pool.size(); }
+    int getBottomUpLevels() const { return m_bottomUpLevels; }
+
+private:
+    // Heuristic switch points from direction-optimising BFS (Beamer et al.):
+    // bottom-up once the frontier's edges exceed 1/ALPHA of the unvisited
+    // cells' edges, top-down again once a shrinking frontier holds fewer than
+    // 1/BETA of all open cells
+    static constexpr int ALPHA = 14;
+    static constexpr int BETA  = 24;
+
+    bool claim(int id);
+    bool isVisited(int id) const;
+    void expandTopDown();
+    void expandBottomUp();
+
+    int R, C;
+    ThreadPool m_pool;
+
+    std::vector<std::uint8_t> open;              // Read-only wall map (1 = walkable)
+    std::vector<std::uint8_t> degree;            // Open neighbours of each open cell
+    std::unique_ptr<std::atomic<std::uint64_t>[]> visitedBits;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> frontierBits;
+    std::size_t m_words = 0;
+
+    std::vector<int> frontier;                   // Cell ids (r * C + c) of the current level
+    std::vector<std::vector<int>> localNext;     // One next-frontier buffer per thread
+
+    long long m_openCells = 0;
+    long long m_frontierEdges = 0;   // m_f: edges out of the frontier
+    long long m_unvisitedEdges = 0;  // m_u: edges out of unvisited cells
+    std::size_t m_lastFrontier = 0;
+    bool m_bottomUp = false;
+    int m_level = 0;
+    int m_goalDistance = -1;
+    int m_bottomUpLevels = 0;
+
+    // Clock for timing the algorithm
+    sf::Clock m_clock;
+};
+
+#endif // PARALLEL_BFS_SOLVER_H
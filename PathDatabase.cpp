@@ -0,0 +1,198 @@
+#include "PathDatabase.h"
+#include "Utils.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <cstring>
+
+using namespace std;
+
+static const char CPD_MAGIC[8] = {'M', 'Z', 'C', 'P', 'D', '0', '1', '\0'};
+
+vector<int32_t> PathDatabase::dfsOrder(const Maze& maze, int& openCount) {
+    const auto& g = maze.grid;
+    int R = (int)g.size(), C = (int)g[0].size();
+    vector<int32_t> order((size_t)R * C, -1);
+    vector<int> stk;
+    openCount = 0;
+
+    // Seeds in row-major order so every component gets ranked
+    for (int seed = 0; seed < R * C; ++seed) {
+        if (order[seed] != -1 || g[seed / C][seed % C] == '#') continue;
+
+        stk.push_back(seed);
+        while (!stk.empty()) {
+            int u = stk.back();
+            stk.pop_back();
+            if (order[u] != -1) continue;
+            order[u] = openCount++;
+
+            int r = u / C, c = u % C;
+            for (int i = 3; i >= 0; --i) {
+                int nr = r + directions[i].first, nc = c + directions[i].second;
+                if (!isInside(g, nr, nc) || g[nr][nc] == '#') continue;
+                if (order[nr * C + nc] == -1) stk.push_back(nr * C + nc);
+            }
+        }
+    }
+    return order;
+}
+
+PathDatabase PathDatabase::build(const Maze& maze, unsigned threads) {
+    PathDatabase db;
+    const auto& g = maze.grid;
+    db.rows = (int)g.size();
+    db.cols = (int)g[0].size();
+    db.mazeHash = maze.wallFingerprint();
+
+    int openCount = 0;
+    db.rank = dfsOrder(maze, openCount);
+
+    // Sources are numbered in rank order as well
+    vector<int> cellOfRank(openCount);
+    for (size_t v = 0; v < db.rank.size(); ++v) {
+        if (db.rank[v] >= 0) cellOfRank[db.rank[v]] = (int)v;
+    }
+
+    int R = db.rows, C = db.cols;
+    vector<vector<uint32_t>> rowRuns(openCount);
+
+    // Neighbour ids of every open cell (-1 = wall or outside), shared read-only
+    vector<array<int, 4>> neighbours((size_t)R * C);
+    for (int v = 0; v < R * C; ++v) {
+        for (int d = 0; d < 4; ++d) {
+            int nr = v / C + directions[d].first, nc = v % C + directions[d].second;
+            bool ok = isInside(g, nr, nc) && g[nr][nc] != '#';
+            neighbours[v][d] = ok ? nr * C + nc : -1;
+        }
+    }
+    atomic<int> nextSource(0);
+    ThreadPool pool(threads);
+
+    pool.runOnAll([&](unsigned) {
+        // Per-thread BFS scratch, reused for every source
+        vector<uint8_t> move((size_t)R * C, NO_MOVE);
+        vector<uint8_t> rowMoves(openCount);
+        vector<int> queue;
+        queue.reserve(openCount);
+
+        // Sources are handed out one at a time so threads stay balanced
+        for (int s = nextSource++; s < openCount; s = nextSource++) {
+            int src = cellOfRank[s];
+            for (int v : queue) move[v] = NO_MOVE;
+            queue.clear();
+
+            // BFS where every cell inherits the first move of its parent
+            queue.push_back(src);
+            move[src] = 0;
+            for (size_t head = 0; head < queue.size(); ++head) {
+                int u = queue[head];
+                for (int d = 0; d < 4; ++d) {
+                    int v = neighbours[u][d];
+                    if (v < 0 || move[v] != NO_MOVE || v == src) continue;
+                    move[v] = u == src ? (uint8_t)d : move[u];
+                    queue.push_back(v);
+                }
+            }
+
+            // Run-length encode the first moves in target rank order
+            fill(rowMoves.begin(), rowMoves.end(), (uint8_t)NO_MOVE);
+            for (int v : queue) rowMoves[db.rank[v]] = move[v];
+
+            vector<uint32_t>& out = rowRuns[s];
+            for (int t = 0; t < openCount; ++t) {
+                if (t == 0 || rowMoves[t] != rowMoves[t - 1]) {
+                    out.push_back((uint32_t)t << 3 | rowMoves[t]);
+                }
+            }
+            out.shrink_to_fit();
+        }
+    });
+
+    // Flatten into one run array
+    db.rowStart.reserve(openCount + 1);
+    for (int s = 0; s < openCount; ++s) {
+        db.rowStart.push_back(db.runs.size());
+        db.runs.insert(db.runs.end(), rowRuns[s].begin(), rowRuns[s].end());
+        vector<uint32_t>().swap(rowRuns[s]);
+    }
+    db.rowStart.push_back(db.runs.size());
+    return db;
+}
+
+int PathDatabase::firstMove(pair<int, int> from, pair<int, int> to) const {
+    int32_t s = rank[(size_t)from.first * cols + from.second];
+    int32_t t = rank[(size_t)to.first * cols + to.second];
+    if (s < 0 || t < 0) return NO_MOVE;
+
+    // Last run starting at or before t
+    auto begin = runs.begin() + rowStart[s];
+    auto end   = runs.begin() + rowStart[s + 1];
+    auto it = upper_bound(begin, end, ((uint32_t)t << 3) | 7u);
+    return (int)(*(it - 1) & 7u);
+}
+
+vector<pair<int, int>> PathDatabase::path(pair<int, int> from, pair<int, int> to) const {
+    vector<pair<int, int>> result{from};
+    pair<int, int> cur = from;
+
+    while (cur != to) {
+        int d = firstMove(cur, to);
+        if (d == NO_MOVE) return {};
+        cur = {cur.first + directions[d].first, cur.second + directions[d].second};
+        result.push_back(cur);
+    }
+    return result;
+}
+
+bool PathDatabase::save(const string& path) const {
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out) return false;
+
+    int32_t dims[2] = {rows, cols};
+    uint64_t counts[2] = {rowStart.size(), runs.size()};
+    out.write(CPD_MAGIC, sizeof(CPD_MAGIC));
+    out.write(reinterpret_cast<const char*>(&mazeHash), sizeof(mazeHash));
+    out.write(reinterpret_cast<const char*>(dims), sizeof(dims));
+    out.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+    out.write(reinterpret_cast<const char*>(rank.data()), rank.size() * sizeof(int32_t));
+    out.write(reinterpret_cast<const char*>(rowStart.data()), rowStart.size() * sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(runs.data()), runs.size() * sizeof(uint32_t));
+    return (bool)out;
+}
+
+bool PathDatabase::load(const string& path, const Maze& maze) {
+    ifstream in(path, ios::binary);
+    if (!in) return false;
+
+    char magic[8];
+    uint64_t hash = 0;
+    int32_t dims[2];
+    uint64_t counts[2];
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+    in.read(reinterpret_cast<char*>(dims), sizeof(dims));
+    in.read(reinterpret_cast<char*>(counts), sizeof(counts));
+    if (!in || memcmp(magic, CPD_MAGIC, sizeof(magic)) != 0) return false;
+    if (hash != maze.wallFingerprint() || dims[0] != (int)maze.grid.size() ||
+        dims[1] != (int)maze.grid[0].size()) {
+        return false;
+    }
+
+    PathDatabase db;
+    db.rows = dims[0];
+    db.cols = dims[1];
+    db.mazeHash = hash;
+    db.rank.resize((size_t)db.rows * db.cols);
+    db.rowStart.resize(counts[0]);
+    db.runs.resize(counts[1]);
+    in.read(reinterpret_cast<char*>(db.rank.data()), db.rank.size() * sizeof(int32_t));
+    in.read(reinterpret_cast<char*>(db.rowStart.data()), db.rowStart.size() * sizeof(uint64_t));
+    in.read(reinterpret_cast<char*>(db.runs.data()), db.runs.size() * sizeof(uint32_t));
+    if (!in) return false;
+
+    *this = move(db);
+    return true;
+}
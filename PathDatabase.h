@@ -0,0 +1,52 @@
+#ifndef PATH_DATABASE_H
+#define PATH_DATABASE_H
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <cstdint>
+#include "Maze.h"
+
+// Compressed path database (CPD) for a static maze.
+// An offline build runs a BFS from every open cell (spread over all cores) and
+// records, for every target, the first move of an optimal path. Targets are
+// ranked in DFS order so nearby cells share first moves, and each source row
+// is run-length encoded. A query then follows first moves from table to table:
+// no search, cost proportional to the path length.
+class PathDatabase {
+public:
+    static constexpr int NO_MOVE = 4; // Target unreachable from this source
+
+    PathDatabase() = default;
+
+    // threads == 0 means "one per hardware core"
+    static PathDatabase build(const Maze& maze, unsigned threads = 0);
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path, const Maze& maze);
+
+    // Index into 'directions' of an optimal first step, or NO_MOVE
+    int firstMove(std::pair<int, int> from, std::pair<int, int> to) const;
+
+    // Whole optimal path, start and goal included; empty if unreachable
+    std::vector<std::pair<int, int>> path(std::pair<int, int> from, std::pair<int, int> to) const;
+
+    std::size_t getSourceCount() const { return rowStart.empty() ? 0 : rowStart.size() - 1; }
+    std::size_t getRunCount() const { return runs.size(); }
+    std::size_t getSizeBytes() const {
+        return runs.size() * sizeof(std::uint32_t) + rowStart.size() * sizeof(std::uint64_t) +
+               rank.size() * sizeof(std::int32_t);
+    }
+
+private:
+    // DFS preorder over open cells; walls get rank -1
+    static std::vector<std::int32_t> dfsOrder(const Maze& maze, int& openCount);
+
+    int rows = 0, cols = 0;
+    std::uint64_t mazeHash = 0;
+    std::vector<std::int32_t> rank;      // Cell id -> rank, used for both targets and source rows (-1 = wall)
+    std::vector<std::uint64_t> rowStart; // Source row -> first run; one extra sentinel
+    std::vector<std::uint32_t> runs;     // (first target rank << 3) | move
+};
+
+#endif // PATH_DATABASE_H
@@ -0,0 +1,137 @@
+#include "PerfHud.h"
+#include <algorithm>
+#include <cstdio>
+
+using namespace std;
+
+// "1.23 M" style numbers for the readings
+static string human(double value, const char* unit) {
+    const char* prefixes[] = {"", " k", " M", " G"};
+    int p = 0;
+    while (value >= 1000.0 && p < 3) {
+        value /= 1000.0;
+        p++;
+    }
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), p == 0 ? "%.0f%s%s" : "%.2f%s%s", value, prefixes[p], unit);
+    return buffer;
+}
+
+static string megabytes(size_t bytes) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.1f MB", bytes / (1024.0 * 1024.0));
+    return buffer;
+}
+
+void PerfHud::reset() {
+    m_samples.clear();
+    m_next = m_count = 0;
+    m_peakOpen = m_peakMemory = 0;
+    m_sinceReset.restart();
+}
+
+void PerfHud::beginFrame() {
+    // The previous frame is complete now
+    m_lastFrame = m_frameClock.restart();
+    m_lastStep = m_stepTime;
+    m_lastDraw = m_drawTime;
+    m_stepTime = m_drawTime = sf::Time::Zero;
+}
+
+void PerfHud::sample(const Solver* solver) {
+    Sample s;
+    s.seconds = m_sinceReset.getElapsedTime().asSeconds();
+    s.nodes = solver ? solver->getNodesExplored() : 0;
+    s.openSet = solver ? solver->getOpenSetSize() : 0;
+    s.memory = solver ? solver->getMemoryBytes() : 0;
+    s.frameMs = m_lastFrame.asMicroseconds() / 1000.0f;
+    s.stepMs = m_lastStep.asMicroseconds() / 1000.0f;
+    s.drawMs = m_lastDraw.asMicroseconds() / 1000.0f;
+
+    m_peakOpen = max(m_peakOpen, s.openSet);
+    m_peakMemory = max(m_peakMemory, s.memory);
+    if (m_samples.size() < HISTORY) {
+        m_samples.push_back(s);
+    } else {
+        m_samples[m_next] = s;
+    }
+    m_next = (m_next + 1) % HISTORY;
+    m_count = min(m_count + 1, HISTORY);
+}
+
+const PerfHud::Sample& PerfHud::at(size_t back) const {
+    return m_samples[(m_next + HISTORY - 1 - back) % HISTORY];
+}
+
+double PerfHud::nodesPerSecond(size_t back) const {
+    if (back + 1 >= m_count) return 0.0;
+    size_t older = min(back + RATE_WINDOW, m_count - 1);
+    double seconds = at(back).seconds - at(older).seconds;
+    return seconds > 0 ? (at(back).nodes - at(older).nodes) / seconds : 0.0;
+}
+
+void PerfHud::addGraph(sf::VertexArray& lines, float x, float y, float width, float height,
+                       const vector<double>& values, sf::Color color) const {
+    // Oldest on the left, scaled to the largest value shown
+    double top = max(1.0, *max_element(values.begin(), values.end()));
+    float dx = width / (HISTORY - 1);
+    for (size_t i = 1; i < values.size(); ++i) {
+        float x0 = x + width - (values.size() - i) * dx;
+        lines.append(sf::Vertex(sf::Vector2f(x0, y + height * (1 - (float)(values[i - 1] / top))), color));
+        lines.append(sf::Vertex(sf::Vector2f(x0 + dx, y + height * (1 - (float)(values[i] / top))), color));
+    }
+}
+
+void PerfHud::draw(sf::RenderWindow& window, const sf::Font& font, float right, float top) {
+    if (!m_visible || m_count == 0) return;
+
+    const float width = 320.0f, graphHeight = 40.0f, line = 18.0f;
+    float x = right - width, y = top;
+
+    sf::RectangleShape background(sf::Vector2f(width, 4 * line + 2 * (graphHeight + 6) + 12.0f));
+    background.setPosition(x, y);
+    background.setFillColor(sf::Color(0, 0, 0, 190));
+    window.draw(background);
+
+    // Frame times averaged over the rate window, so the numbers are readable
+    size_t frames = min(m_count, RATE_WINDOW);
+    float frameMs = 0, stepMs = 0, drawMs = 0;
+    for (size_t i = 0; i < frames; ++i) {
+        frameMs += at(i).frameMs;
+        stepMs += at(i).stepMs;
+        drawMs += at(i).drawMs;
+    }
+    char timing[96];
+    snprintf(timing, sizeof(timing), "Frame %.1f ms  (step %.1f, draw %.1f)", frameMs / frames, stepMs / frames,
+             drawMs / frames);
+
+    vector<double> rates, open;
+    for (size_t i = m_count; i-- > 0;) {
+        rates.push_back(nodesPerSecond(i));
+        open.push_back((double)at(i).openSet);
+    }
+
+    sf::Text text("", font, 13);
+    auto print = [&](const string& s, sf::Color color) {
+        text.setString(s);
+        text.setFillColor(color);
+        text.setPosition(x + 10, y);
+        window.draw(text);
+        y += line;
+    };
+
+    const sf::Color rateColor(120, 230, 120), openColor(255, 170, 60);
+    sf::VertexArray graphs(sf::Lines);
+    y += 6;
+    print("Nodes/s " + human(nodesPerSecond(0), "") + "   (explored " + human((double)at(0).nodes, "") + ")",
+          rateColor);
+    addGraph(graphs, x + 10, y, width - 20, graphHeight, rates, rateColor);
+    y += graphHeight + 6;
+    print("Open set " + human((double)at(0).openSet, "") + "   (peak " + human((double)m_peakOpen, "") + ")",
+          openColor);
+    addGraph(graphs, x + 10, y, width - 20, graphHeight, open, openColor);
+    y += graphHeight + 6;
+    print("Memory " + megabytes(at(0).memory) + "   (peak " + megabytes(m_peakMemory) + ")", sf::Color::White);
+    print(timing, sf::Color::White);
+    window.draw(graphs);
+}
@@ -0,0 +1,67 @@
+#ifndef PERF_HUD_H
+#define PERF_HUD_H
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <SFML/Graphics.hpp>
+#include <SFML/System/Clock.hpp>
+#include "Solver.h"
+
+// Live performance overlay for the window in main_gui.cpp (toggled with H).
+// Shows nodes per second and open-set size over the last HISTORY frames, the
+// current solver's memory, and the frame time split into step and draw time.
+//
+// sample() only calls the solver's cheap getters, once per frame, between
+// ticks. None of it runs inside the solver's own timing, and nothing is drawn
+// while the HUD is hidden. Samples keep being taken while it is hidden so the
+// graphs are full as soon as it is shown.
+class PerfHud {
+public:
+    static constexpr std::size_t HISTORY = 240;   // Frames kept for the graphs
+    static constexpr std::size_t RATE_WINDOW = 30; // Frames nodes/s is averaged over
+
+    void toggle() { m_visible = !m_visible; }
+    bool isVisible() const { return m_visible; }
+
+    // Forgets the previous solver's samples
+    void reset();
+
+    // Frame timing: call beginFrame() once per frame, and add the time spent
+    // stepping the solver and drawing
+    void beginFrame();
+    void addStepTime(sf::Time t) { m_stepTime += t; }
+    void addDrawTime(sf::Time t) { m_drawTime += t; }
+
+    // Records this frame's readings (solver may be null between runs)
+    void sample(const Solver* solver);
+
+    // Drawn with its top-right corner at (right, top)
+    void draw(sf::RenderWindow& window, const sf::Font& font, float right, float top);
+
+private:
+    struct Sample {
+        float seconds;        // Since reset()
+        long long nodes;      // Explored so far
+        std::size_t openSet;
+        std::size_t memory;
+        float frameMs, stepMs, drawMs;
+    };
+
+    const Sample& at(std::size_t back) const; // 0 = newest
+    double nodesPerSecond(std::size_t back) const;
+    void addGraph(sf::VertexArray& lines, float x, float y, float width, float height,
+                  const std::vector<double>& values, sf::Color color) const;
+
+    bool m_visible = false;
+    std::vector<Sample> m_samples; // Ring of HISTORY
+    std::size_t m_next = 0, m_count = 0;
+    std::size_t m_peakOpen = 0, m_peakMemory = 0;
+
+    sf::Clock m_sinceReset;
+    sf::Clock m_frameClock;
+    sf::Time m_lastFrame, m_stepTime, m_drawTime;
+    sf::Time m_lastStep, m_lastDraw;
+};
+
+#endif // PERF_HUD_H
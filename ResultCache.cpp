@@ -0,0 +1,276 @@
+#include "ResultCache.h"
+#include "Utils.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <unordered_set>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+static const char CACHE_MAGIC[8] = {'M', 'Z', 'R', 'E', 'S', '0', '1', '\0'};
+
+size_t ResultCache::Entry::sizeBytes() const {
+    return sizeof(Entry) + algorithm.size() + path.size() * sizeof(path[0]) +
+           explored.size() * sizeof(explored[0]);
+}
+
+bool ResultCache::Entry::touches(int r, int c) const {
+    // A wall change matters if the search expanded the cell or one of its
+    // neighbours (it tested the cell while expanding that neighbour)
+    if (binary_search(explored.begin(), explored.end(), (uint32_t)(r * cols + c))) return true;
+    for (auto [dr, dc] : directions) {
+        int nr = r + dr, nc = c + dc;
+        if (nr < 0 || nc < 0 || nc >= cols) continue;
+        if (binary_search(explored.begin(), explored.end(), (uint32_t)(nr * cols + nc))) return true;
+    }
+    return false;
+}
+
+vector<string> ResultCache::Entry::renderGrid(const Maze& maze, char symbol) const {
+    vector<string> g = maze.grid;
+    for (uint32_t id : explored) {
+        char& ch = g[id / cols][id % cols];
+        if (ch == ' ') ch = symbol;
+    }
+    for (auto [r, c] : path) {
+        if (g[r][c] != 'S' && g[r][c] != 'E') g[r][c] = 'X';
+    }
+    return g;
+}
+
+ResultCache::ResultCache(size_t maxBytes, const string& diskDir)
+    : m_maxBytes(maxBytes), m_diskDir(diskDir)
+{
+    if (!m_diskDir.empty()) fs::create_directories(m_diskDir);
+}
+
+uint64_t ResultCache::keyOf(uint64_t mazeHash, pair<int, int> start, pair<int, int> goal,
+                            const string& algorithm)
+{
+    // FNV-1a over every key field
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&](uint64_t v) {
+        for (int i = 0; i < 8; ++i) {
+            h ^= (v >> (i * 8)) & 0xFF;
+            h *= 1099511628211ull;
+        }
+    };
+    mix(mazeHash);
+    mix((uint64_t)(uint32_t)start.first << 32 | (uint32_t)start.second);
+    mix((uint64_t)(uint32_t)goal.first << 32 | (uint32_t)goal.second);
+    for (char ch : algorithm) mix((unsigned char)ch);
+    return h;
+}
+
+bool ResultCache::sameQuery(const Entry& e, uint64_t mazeHash, pair<int, int> start,
+                            pair<int, int> goal, const string& algorithm)
+{
+    return e.mazeHash == mazeHash && e.start == start && e.goal == goal && e.algorithm == algorithm;
+}
+
+const ResultCache::Entry* ResultCache::find(const Maze& maze, const string& algorithm) {
+    // Entries are keyed by one goal, so mazes with several are never cached
+    if (maze.getGoals().size() > 1) return nullptr;
+
+    uint64_t hash = maze.wallFingerprint();
+    uint64_t key = keyOf(hash, maze.getStart(), maze.getGoal(), algorithm);
+
+    auto it = index.find(key);
+    if (it != index.end() && sameQuery(it->second->second, hash, maze.getStart(), maze.getGoal(), algorithm)) {
+        lru.splice(lru.begin(), lru, it->second);
+        m_stats.hits++;
+        return &lru.front().second;
+    }
+
+    // Second tier: promote a disk entry into memory
+    Entry e;
+    if (!m_diskDir.empty() && readDisk(diskPath(key), e) &&
+        sameQuery(e, hash, maze.getStart(), maze.getGoal(), algorithm)) {
+        m_stats.hits++;
+        m_stats.diskHits++;
+        insert(key, move(e));
+        return index.count(key) ? &lru.front().second : nullptr;
+    }
+
+    m_stats.misses++;
+    return nullptr;
+}
+
+void ResultCache::store(const Maze& maze, const string& algorithm, const Solver& solver) {
+    if (maze.getGoals().size() > 1) return;
+
+    Entry e;
+    e.mazeHash = maze.wallFingerprint();
+    e.start = maze.getStart();
+    e.goal = maze.getGoal();
+    e.algorithm = algorithm;
+    e.found = solver.wasPathFound();
+    e.nodesExplored = solver.getNodesExplored();
+    e.pathLength = solver.getPathLength();
+    e.timeTaken = solver.getTimeTaken();
+    e.path = solver.getPath();
+    e.cols = maze.getCols();
+    for (auto [r, c] : solver.getExploredCells()) {
+        e.explored.push_back((uint32_t)(r * e.cols + c));
+    }
+    sort(e.explored.begin(), e.explored.end());
+
+    uint64_t key = keyOf(e.mazeHash, e.start, e.goal, algorithm);
+    if (!m_diskDir.empty()) writeDisk(key, e);
+    insert(key, move(e));
+}
+
+void ResultCache::insert(uint64_t key, Entry entry) {
+    erase(key);
+
+    size_t bytes = entry.sizeBytes();
+    if (bytes > m_maxBytes) return; // Would evict everything else; disk only
+
+    lru.emplace_front(key, move(entry));
+    index[key] = lru.begin();
+    m_bytes += bytes;
+
+    while (m_bytes > m_maxBytes) {
+        m_bytes -= lru.back().second.sizeBytes();
+        index.erase(lru.back().first);
+        lru.pop_back();
+        m_stats.evictions++;
+    }
+}
+
+void ResultCache::erase(uint64_t key) {
+    auto it = index.find(key);
+    if (it == index.end()) return;
+    m_bytes -= it->second->second.sizeBytes();
+    lru.erase(it->second);
+    index.erase(it);
+}
+
+void ResultCache::wallsChanged(uint64_t oldHash, const Maze& updated,
+                               const vector<pair<int, int>>& cells)
+{
+    uint64_t newHash = updated.wallFingerprint();
+    auto stillValid = [&](const Entry& e) {
+        for (auto [r, c] : cells) {
+            if (e.touches(r, c)) return false;
+        }
+        return true;
+    };
+
+    // Memory tier: collect first, the re-keyed entries are re-inserted after
+    vector<pair<uint64_t, Entry>> carried;
+    unordered_set<uint64_t> handled;
+    for (auto it = lru.begin(); it != lru.end();) {
+        if (it->second.mazeHash != oldHash) { ++it; continue; }
+
+        m_bytes -= it->second.sizeBytes();
+        index.erase(it->first);
+        handled.insert(it->first);
+        if (stillValid(it->second)) {
+            carried.push_back(move(*it));
+        } else {
+            m_stats.invalidated++;
+        }
+        it = lru.erase(it);
+    }
+
+    // Disk tier: every file for the old layout goes; valid ones are rewritten
+    if (!m_diskDir.empty()) {
+        error_code ec;
+        vector<fs::path> files;
+        for (const auto& file : fs::directory_iterator(m_diskDir, ec)) files.push_back(file.path());
+
+        for (const fs::path& file : files) {
+            Entry e;
+            if (!readDisk(file.string(), e) || e.mazeHash != oldHash) continue;
+            fs::remove(file, ec);
+            if (handled.count(keyOf(e.mazeHash, e.start, e.goal, e.algorithm))) continue;
+
+            if (stillValid(e)) {
+                e.mazeHash = newHash;
+                writeDisk(keyOf(newHash, e.start, e.goal, e.algorithm), e);
+                m_stats.carried++;
+            } else {
+                m_stats.invalidated++;
+            }
+        }
+    }
+
+    for (auto& kv : carried) {
+        Entry& e = kv.second;
+        e.mazeHash = newHash;
+        uint64_t key = keyOf(newHash, e.start, e.goal, e.algorithm);
+        if (!m_diskDir.empty()) writeDisk(key, e);
+        insert(key, move(e));
+        m_stats.carried++;
+    }
+}
+
+void ResultCache::clear() {
+    lru.clear();
+    index.clear();
+    m_bytes = 0;
+}
+
+string ResultCache::diskPath(uint64_t key) const {
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.res", (unsigned long long)key);
+    return (fs::path(m_diskDir) / name).string();
+}
+
+bool ResultCache::writeDisk(uint64_t key, const Entry& e) const {
+    ofstream out(diskPath(key), ios::binary | ios::trunc);
+    if (!out) return false;
+
+    int32_t ints[9] = {e.start.first, e.start.second, e.goal.first, e.goal.second,
+                       e.found, e.nodesExplored, e.pathLength, e.cols, (int32_t)e.algorithm.size()};
+    int64_t sizes[3] = {e.timeTaken.asMicroseconds(), (int64_t)e.path.size(), (int64_t)e.explored.size()};
+    out.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    out.write(reinterpret_cast<const char*>(&e.mazeHash), sizeof(e.mazeHash));
+    out.write(reinterpret_cast<const char*>(ints), sizeof(ints));
+    out.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+    out.write(e.algorithm.data(), e.algorithm.size());
+    for (auto [r, c] : e.path) {
+        int32_t cell[2] = {r, c};
+        out.write(reinterpret_cast<const char*>(cell), sizeof(cell));
+    }
+    out.write(reinterpret_cast<const char*>(e.explored.data()), e.explored.size() * sizeof(uint32_t));
+    return (bool)out;
+}
+
+bool ResultCache::readDisk(const string& path, Entry& e) const {
+    ifstream in(path, ios::binary);
+    if (!in) return false;
+
+    char magic[8];
+    int32_t ints[9];
+    int64_t sizes[3];
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&e.mazeHash), sizeof(e.mazeHash));
+    in.read(reinterpret_cast<char*>(ints), sizeof(ints));
+    in.read(reinterpret_cast<char*>(sizes), sizeof(sizes));
+    if (!in || memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0) return false;
+
+    e.start = {ints[0], ints[1]};
+    e.goal = {ints[2], ints[3]};
+    e.found = ints[4] != 0;
+    e.nodesExplored = ints[5];
+    e.pathLength = ints[6];
+    e.cols = ints[7];
+    e.algorithm.resize(ints[8]);
+    e.timeTaken = sf::microseconds(sizes[0]);
+    in.read(&e.algorithm[0], e.algorithm.size());
+
+    e.path.resize(sizes[1]);
+    for (auto& cell : e.path) {
+        int32_t rc[2];
+        in.read(reinterpret_cast<char*>(rc), sizeof(rc));
+        cell = {rc[0], rc[1]};
+    }
+    e.explored.resize(sizes[2]);
+    in.read(reinterpret_cast<char*>(e.explored.data()), e.explored.size() * sizeof(uint32_t));
+    return (bool)in;
+}
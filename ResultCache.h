@@ -0,0 +1,95 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <vector>
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <cstdint>
+#include <SFML/System/Time.hpp>
+#include "Maze.h"
+#include "Solver.h"
+
+// Content-addressed cache of finished searches.
+// The key is (wall layout hash, start, goal, algorithm name), so rerunning the
+// same query on the same maze returns the stored path and stats at once.
+// Entries live in a byte-bounded LRU in memory and, optionally, as one file
+// each in a directory on disk.
+class ResultCache {
+public:
+    struct Entry {
+        std::uint64_t mazeHash = 0;
+        std::pair<int, int> start, goal;
+        std::string algorithm;
+
+        bool found = false;
+        int nodesExplored = 0;
+        int pathLength = 0;
+        sf::Time timeTaken;
+        std::vector<std::pair<int, int>> path;
+        std::vector<std::uint32_t> explored; // Sorted r * cols + c
+        int cols = 0;
+
+        std::size_t sizeBytes() const;
+        // True if the search looked at this cell (expanded it or a neighbour)
+        bool touches(int r, int c) const;
+        // Rebuilds the solver's final grid on top of the base maze
+        std::vector<std::string> renderGrid(const Maze& maze, char symbol) const;
+    };
+
+    struct Stats {
+        long long hits = 0;
+        long long diskHits = 0;     // Hits that had to be read from disk
+        long long misses = 0;
+        long long evictions = 0;
+        long long invalidated = 0;  // Dropped after a wall change
+        long long carried = 0;      // Kept across a wall change
+    };
+
+    // diskDir empty = memory only
+    explicit ResultCache(std::size_t maxBytes = 64u << 20, const std::string& diskDir = "");
+
+    // nullptr on a miss; the pointer is valid until the next non-const call
+    const Entry* find(const Maze& maze, const std::string& algorithm);
+
+    // Stores a finished solver's result for this maze/query
+    void store(const Maze& maze, const std::string& algorithm, const Solver& solver);
+
+    // The walls at 'cells' changed; oldHash is the maze's wallFingerprint()
+    // from before the change. Entries whose search touched a changed cell are
+    // dropped, the rest are moved over to the new layout.
+    void wallsChanged(std::uint64_t oldHash, const Maze& updated,
+                      const std::vector<std::pair<int, int>>& cells);
+
+    void clear();
+
+    const Stats& getStats() const { return m_stats; }
+    std::size_t getEntryCount() const { return lru.size(); }
+    std::size_t getBytesUsed() const { return m_bytes; }
+
+private:
+    static std::uint64_t keyOf(std::uint64_t mazeHash, std::pair<int, int> start,
+                               std::pair<int, int> goal, const std::string& algorithm);
+    static bool sameQuery(const Entry& e, std::uint64_t mazeHash, std::pair<int, int> start,
+                          std::pair<int, int> goal, const std::string& algorithm);
+
+    void insert(std::uint64_t key, Entry entry);
+    void erase(std::uint64_t key);
+
+    std::string diskPath(std::uint64_t key) const;
+    bool writeDisk(std::uint64_t key, const Entry& e) const;
+    bool readDisk(const std::string& path, Entry& e) const;
+
+    std::size_t m_maxBytes;
+    std::string m_diskDir;
+    std::size_t m_bytes = 0;
+
+    // Most recently used at the front
+    std::list<std::pair<std::uint64_t, Entry>> lru;
+    std::unordered_map<std::uint64_t, decltype(lru)::iterator> index;
+
+    Stats m_stats;
+};
+
+#endif // RESULT_CACHE_H
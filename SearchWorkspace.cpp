@@ -0,0 +1,192 @@
+#include "SearchWorkspace.h"
+#include "Trace.h"
+#include "Landmarks.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+void SearchWorkspace::bind(const Maze& maze) {
+    int rows = maze.getRows();
+    int cols = maze.getCols();
+    size_t cells = (size_t)rows * cols;
+
+    if (rows != m_rows || cols != m_cols) {
+        m_rows = rows;
+        m_cols = cols;
+        m_open.assign(cells, 0);
+        m_closedStamp.assign(cells, 0);
+        m_reachedStamp.assign(cells, 0);
+        m_g.assign(cells, 0);
+        m_parent.assign(cells, -1);
+        m_epoch = 0;
+    }
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            m_open[(size_t)r * cols + c] = maze.grid[r][c] != '#';
+        }
+    }
+}
+
+void SearchWorkspace::nextEpoch() {
+    if (++m_epoch == 0) {
+        // Wrapped after 2^32 queries: stale stamps could match again
+        fill(m_closedStamp.begin(), m_closedStamp.end(), 0);
+        fill(m_reachedStamp.begin(), m_reachedStamp.end(), 0);
+        m_epoch = 1;
+        ++m_fullClears;
+    }
+}
+
+size_t SearchWorkspace::getBytesReserved() const {
+    return m_open.capacity()
+         + (m_closedStamp.capacity() + m_reachedStamp.capacity()) * sizeof(uint32_t)
+         + (m_g.capacity() + m_parent.capacity() + m_queue.capacity()) * sizeof(int)
+         + m_heap.capacity() * sizeof(HeapEntry)
+         + m_path.capacity() * sizeof(pair<int, int>);
+}
+
+SearchWorkspace::Result SearchWorkspace::solve(Algorithm algorithm, pair<int, int> start,
+                                               pair<int, int> goal, const Landmarks* landmarks) {
+    TRACE_SCOPE("SearchWorkspace::solve");
+    Result result;
+    m_path.clear();
+    ++m_queries;
+    nextEpoch();
+    m_explored = 0;
+
+    int s = start.first * m_cols + start.second;
+    int t = goal.first * m_cols + goal.second;
+
+    int found;
+    switch (algorithm) {
+        case Algorithm::BFS: found = bfs(s, t); break;
+        case Algorithm::DFS: found = dfs(s, t); break;
+        default:             found = bestFirst(algorithm, s, t, landmarks); break;
+    }
+
+    result.found = found != 0;
+    result.nodesExplored = m_explored;
+    if (result.found) tracePath(s, t, result);
+    return result;
+}
+
+// Mirrors BFS_Solver: cells are marked when enqueued
+int SearchWorkspace::bfs(int start, int goal) {
+    m_queue.clear();
+    m_queue.push_back(start);
+    reach(start, -1, 0);
+
+    for (size_t head = 0; head < m_queue.size(); ++head) {
+        int cur = m_queue[head];
+        ++m_explored;
+        if (cur == goal) return 1;
+
+        int r = cur / m_cols, c = cur % m_cols;
+        for (auto [dr, dc] : directions) {
+            int nr = r + dr, nc = c + dc;
+            if (nr < 0 || nc < 0 || nr >= m_rows || nc >= m_cols) continue;
+            int next = nr * m_cols + nc;
+            if (!isOpen(next) || reached(next)) continue;
+            reach(next, cur, 0);
+            m_queue.push_back(next);
+        }
+    }
+    return 0;
+}
+
+// Mirrors DFS_Solver: lazy deletion, neighbours pushed in reverse order,
+// parent overwritten by the latest push
+int SearchWorkspace::dfs(int start, int goal) {
+    m_queue.clear();
+    m_queue.push_back(start);
+    m_parent[start] = -1;
+
+    while (!m_queue.empty()) {
+        int cur = m_queue.back();
+        m_queue.pop_back();
+        if (closed(cur)) continue;
+
+        ++m_explored;
+        close(cur);
+        if (cur == goal) return 1;
+
+        int r = cur / m_cols, c = cur % m_cols;
+        for (int i = 3; i >= 0; --i) {
+            int nr = r + directions[i].first;
+            int nc = c + directions[i].second;
+            if (nr < 0 || nc < 0 || nr >= m_rows || nc >= m_cols) continue;
+            int next = nr * m_cols + nc;
+            if (!isOpen(next) || closed(next)) continue;
+            m_parent[next] = cur;
+            m_queue.push_back(next);
+        }
+    }
+    return 0;
+}
+
+// Mirrors AStar_Solver, Dijkstra_Solver and GreedyBestFirst_Solver
+int SearchWorkspace::bestFirst(Algorithm algorithm, int start, int goal, const Landmarks* landmarks) {
+    pair<int, int> goalCell = {goal / m_cols, goal % m_cols};
+    auto heuristic = [&](int cell) {
+        int r = cell / m_cols, c = cell % m_cols;
+        int h = abs(goalCell.first - r) + abs(goalCell.second - c);
+        if (landmarks) h = max(h, landmarks->heuristic(r, c, goalCell));
+        return h;
+    };
+    // Same ordering as std::priority_queue<..., std::greater<>> in the solvers
+    auto after = [](const HeapEntry& a, const HeapEntry& b) { return a.key > b.key; };
+    auto push = [&](int key, int cell) {
+        m_heap.push_back({key, cell});
+        push_heap(m_heap.begin(), m_heap.end(), after);
+    };
+
+    m_heap.clear();
+    reach(start, -1, 0);
+    push(algorithm == Algorithm::Dijkstra ? 0 : heuristic(start), start);
+
+    while (!m_heap.empty()) {
+        int cur = m_heap.front().cell;
+        pop_heap(m_heap.begin(), m_heap.end(), after);
+        m_heap.pop_back();
+        if (closed(cur)) continue;
+
+        close(cur);
+        ++m_explored;
+        if (cur == goal) return 1;
+
+        int r = cur / m_cols, c = cur % m_cols;
+        for (auto [dr, dc] : directions) {
+            int nr = r + dr, nc = c + dc;
+            if (nr < 0 || nc < 0 || nr >= m_rows || nc >= m_cols) continue;
+            int next = nr * m_cols + nc;
+            if (!isOpen(next)) continue;
+
+            if (algorithm == Algorithm::Greedy) {
+                if (closed(next)) continue;
+                m_parent[next] = cur;
+                push(heuristic(next), next);
+                continue;
+            }
+
+            int g = m_g[cur] + 1;
+            if (!reached(next) || g < m_g[next]) {
+                reach(next, cur, g);
+                push(algorithm == Algorithm::AStar ? g + heuristic(next) : g, next);
+            }
+        }
+    }
+    return 0;
+}
+
+void SearchWorkspace::tracePath(int start, int goal, Result& result) {
+    for (int cell = goal; ; cell = m_parent[cell]) {
+        m_path.push_back({cell / m_cols, cell % m_cols});
+        if (cell == start) break;
+    }
+    reverse(m_path.begin(), m_path.end());
+    result.pathLength = (int)m_path.size();
+    result.path = m_path.data();
+    result.pathSize = m_path.size();
+}
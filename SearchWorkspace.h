@@ -0,0 +1,99 @@
+#ifndef SEARCHWORKSPACE_H
+#define SEARCHWORKSPACE_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include "Maze.h"
+
+class Landmarks;
+
+// Reusable scratch memory for running many (start, goal) queries on one maze
+// without building a Solver each time.
+//
+// Every per-cell array is allocated once per maze size. "Visited" and "has a
+// distance" are generation stamps compared against the current query's
+// epoch, so starting a new query is O(1) instead of clearing R x C cells.
+// The queue, stack, heap and path buffers keep their capacity between
+// queries.
+//
+// Each algorithm expands cells in exactly the same order as its Solver class
+// (same neighbour order, same heap operations), so nodesExplored and the path
+// match the step-by-step solvers.
+class SearchWorkspace {
+public:
+    enum class Algorithm { BFS, DFS, AStar, Dijkstra, Greedy };
+
+    struct Result {
+        bool found = false;
+        int pathLength = 0;     // Cells on the path including start and goal, like Solver
+        int nodesExplored = 0;
+        // Start-to-goal cells, stored in the workspace: valid until the next query
+        const std::pair<int, int>* path = nullptr;
+        std::size_t pathSize = 0;
+    };
+
+    SearchWorkspace() = default;
+    explicit SearchWorkspace(const Maze& maze) { bind(maze); }
+
+    // Switches to another maze. Arrays are only reallocated if the size
+    // changed; otherwise just the wall map is refreshed.
+    void bind(const Maze& maze);
+
+    // Runs one query. landmarks (optional) tightens the A*/Greedy heuristic
+    // as in AStar_Solver / GreedyBestFirst_Solver.
+    Result solve(Algorithm algorithm, std::pair<int, int> start, std::pair<int, int> goal,
+                 const Landmarks* landmarks = nullptr);
+
+    int getRows() const { return m_rows; }
+    int getCols() const { return m_cols; }
+    std::uint64_t getQueries() const { return m_queries; }
+    int getFullClears() const { return m_fullClears; }     // Stamp wrap-arounds
+    std::size_t getBytesReserved() const;                  // All retained buffers
+
+private:
+    struct HeapEntry {
+        int key; // f for A*, distance for Dijkstra, h for Greedy
+        int cell;
+    };
+
+    // Starts a new generation; clears the stamps only when the counter wraps
+    void nextEpoch();
+
+    bool isOpen(int cell) const { return m_open[cell] != 0; }
+    bool closed(int cell) const { return m_closedStamp[cell] == m_epoch; }
+    bool reached(int cell) const { return m_reachedStamp[cell] == m_epoch; }
+    void close(int cell) { m_closedStamp[cell] = m_epoch; }
+    void reach(int cell, int parent, int g) {
+        m_reachedStamp[cell] = m_epoch;
+        m_parent[cell] = parent;
+        m_g[cell] = g;
+    }
+
+    int bfs(int start, int goal);
+    int dfs(int start, int goal);
+    int bestFirst(Algorithm algorithm, int start, int goal, const Landmarks* landmarks);
+    void tracePath(int start, int goal, Result& result);
+
+    int m_rows = 0;
+    int m_cols = 0;
+    std::vector<std::uint8_t> m_open;        // 1 = not a wall
+
+    std::uint32_t m_epoch = 0;
+    std::vector<std::uint32_t> m_closedStamp;  // == epoch: expanded this query
+    std::vector<std::uint32_t> m_reachedStamp; // == epoch: m_g / m_parent are valid
+    std::vector<int> m_g;
+    std::vector<int> m_parent;
+
+    // Retained between queries
+    std::vector<int> m_queue;
+    std::vector<HeapEntry> m_heap;
+    std::vector<std::pair<int, int>> m_path;
+
+    int m_explored = 0;
+    std::uint64_t m_queries = 0;
+    int m_fullClears = 0;
+};
+
+#endif // SEARCHWORKSPACE_H
@@ -1,19 +1,153 @@
 #include "Solver.h"
+#include "Checkpoint.h"
 using namespace std;
 
-Solver::Solver(const Maze& maze, char marker) 
+Solver::Solver(const Maze& maze, char marker, CellStorage parentStorage)
     : symbol(marker),
       currentState(State::SEARCHING),
       found(false)
 {
+    TRACE_SCOPE("Solver::Solver");
+
     // Deep copy the base maze grid
     grid = maze.grid;
 
     start = maze.getStart();
     goal  = maze.getGoal();
+    m_severalGoals = maze.getGoals().size() > 1;
 
     // Initialize parent map for all solvers
     int R = maze.getRows();
     int C = maze.getCols();
-    parent.assign(R, vector<pair<int,int>>(C, {-1,-1}));
+    parent.reset(R, C, {-1,-1}, parentStorage);
+}
+
+// Start-to-'to' cells along the parent map. Straight jumps left in it
+// (RectangleSymmetry) are filled in here, without touching the map.
+static vector<pair<int,int>> pathTo(const CellStore<pair<int,int>>& parent, pair<int,int> start, pair<int,int> to) {
+    vector<pair<int,int>> path;
+    for (pair<int,int> cur = to; cur != make_pair(-1, -1); cur = parent[cur.first][cur.second]) {
+        if (!path.empty()) {
+            pair<int,int> prev = path.back();
+            int dr = (cur.first > prev.first) - (cur.first < prev.first);
+            int dc = (cur.second > prev.second) - (cur.second < prev.second);
+            for (prev = {prev.first + dr, prev.second + dc}; prev != cur; prev = {prev.first + dr, prev.second + dc}) {
+                path.push_back(prev);
+            }
+        }
+        path.push_back(cur);
+        if (cur == start) break;
+    }
+    return vector<pair<int,int>>(path.rbegin(), path.rend());
+}
+
+vector<pair<int,int>> Solver::getPath() const {
+    if (!found) return {};
+    return pathTo(parent, start, goal);
+}
+
+vector<vector<pair<int,int>>> Solver::getGoalPaths() const {
+    vector<vector<pair<int,int>>> paths;
+    if (!found) return paths;
+    if (m_reachedGoals.empty()) return {getPath()};
+    for (pair<int,int> g : m_reachedGoals) paths.push_back(pathTo(parent, start, g));
+    return paths;
+}
+
+bool Solver::goalReached(int r, int c) {
+    m_reachedGoals.push_back({r, c});
+    if ((int)m_reachedGoals.size() < m_goalsWanted) return false;
+    return anyGoalReached();
+}
+
+bool Solver::anyGoalReached() {
+    if (m_reachedGoals.empty()) return false;
+    found = true;
+    currentState = State::TRACING_PATH;
+    goal = m_reachedGoals[0];
+    tracePos = goal;
+    return true;
+}
+
+size_t Solver::getMemoryBytes() const {
+    size_t gridBytes = grid.size() * (sizeof(string) + (grid.empty() ? 0 : grid[0].capacity()));
+    return gridBytes + parent.getBytes();
+}
+
+void Solver::unfoldJumps() {
+    pair<int,int> cur = goal;
+    while (cur != start) {
+        pair<int,int> p = parent[cur.first][cur.second];
+        if (p == make_pair(-1, -1)) return;
+
+        // Jumps are straight, so the next cell is one step towards the parent
+        int dr = (p.first > cur.first) - (p.first < cur.first);
+        int dc = (p.second > cur.second) - (p.second < cur.second);
+        pair<int,int> next = {cur.first + dr, cur.second + dc};
+        if (next != p) {
+            parent[next.first][next.second] = p;
+            parent[cur.first][cur.second] = next;
+        }
+        cur = next;
+    }
+}
+
+vector<pair<int,int>> Solver::getExploredCells() const {
+    vector<pair<int,int>> cells;
+    for (int r = 0; r < (int)grid.size(); ++r) {
+        for (int c = 0; c < (int)grid[r].size(); ++c) {
+            char ch = grid[r][c];
+            if (ch == symbol || ch == 'X' || ch == 'S' || ch == 'E') {
+                cells.push_back({r, c});
+            }
+        }
+    }
+    return cells;
+}
+
+
+void Solver::saveBaseState(CheckpointWriter& w, const sf::Clock& clock) const {
+    // Time is stored as "spent so far", so it keeps counting after a resume
+    sf::Time spent = currentState == State::SEARCHING ? m_resumedTime + clock.getElapsedTime()
+                                                       : m_timeTaken;
+    w.pod((int32_t)currentState);
+    w.pod((int32_t)found);
+    int32_t cells[6] = {start.first, start.second, goal.first, goal.second,
+                        tracePos.first, tracePos.second};
+    w.pod(cells);
+    w.pod((int32_t)m_nodesExplored);
+    w.pod((int32_t)m_pathLength);
+    w.pod((int64_t)m_timeTaken.asMicroseconds());
+    w.pod((int64_t)spent.asMicroseconds());
+    w.grid(grid);
+    w.pairs(parent.toMatrix());
+}
+
+bool Solver::loadBaseState(CheckpointReader& r) {
+    int32_t state = 0, wasFound = 0, nodes = 0, length = 0;
+    int32_t cells[6];
+    int64_t taken = 0, spent = 0;
+    r.pod(state);
+    r.pod(wasFound);
+    r.pod(cells);
+    r.pod(nodes);
+    r.pod(length);
+    r.pod(taken);
+    r.pod(spent);
+    r.grid(grid);
+    vector<vector<pair<int, int>>> parents;
+    r.pairs(parents);
+    parent.fromMatrix(parents);
+    if (!r.ok() || state < 0 || state > (int32_t)State::DONE) return false;
+
+    currentState = (State)state;
+    found = wasFound != 0;
+    start = {cells[0], cells[1]};
+    goal = {cells[2], cells[3]};
+    tracePos = {cells[4], cells[5]};
+    m_nodesExplored = nodes;
+    m_pathLength = length;
+    m_timeTaken = sf::microseconds(taken);
+    m_resumedTime = sf::microseconds(spent);
+    return true;
 }
\ No newline at end of file
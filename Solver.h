@@ -5,7 +5,14 @@
 #include <string>
 #include <utility>
 #include <SFML/System/Time.hpp>
+#include <SFML/System/Clock.hpp>
 #include "Maze.h" 
+#include "EventLog.h"
+#include "CellStore.h"
+#include "Trace.h"
+
+class CheckpointWriter;
+class CheckpointReader;
 
 class Solver {
 public:
@@ -16,7 +23,9 @@ public:
         DONE
     };
 
-    Solver(const Maze& maze, char marker);
+    // parentStorage: backend for the parent map (see CellStore.h); solvers
+    // that expand few cells of a large maze can pick a sparse one
+    Solver(const Maze& maze, char marker, CellStorage parentStorage = CellStorage::Dense);
     virtual ~Solver() = default;
 
 
@@ -28,13 +37,57 @@ public:
         return currentState == State::DONE; 
     }
 
+    // Still searching (as opposed to tracing the path or done)
+    bool isSearching() const { return currentState == State::SEARCHING; }
+
     bool wasPathFound() const { return found; }
-    std::vector<std::string> getGrid() const { return grid; }
+    std::vector<std::string> getGrid() const {
+        TRACE_SCOPE("Solver::getGrid");
+        return grid;
+    }
     int getNodesExplored() const { return m_nodesExplored; }
     int getPathLength() const { return m_pathLength; }
     sf::Time getTimeTaken() const { return m_timeTaken; }
     bool isPathFound() const { return found; } 
 
+    // Start-to-goal cells from the parent map (empty if no path was found)
+    std::vector<std::pair<int, int>> getPath() const;
+
+    // Mazes with several goals (Maze::setGoals): BFS, Dijkstra and A* stop at
+    // the first goal they expand, which is the nearest. With count > 1 the
+    // same search carries on until 'count' goals are expanded (or it runs out
+    // of cells). getPath() and the traced path go to the nearest.
+    void setGoalsWanted(int count) { m_goalsWanted = count > 1 ? count : 1; }
+    // Paths to the goals reached, nearest first
+    std::vector<std::vector<std::pair<int, int>>> getGoalPaths() const;
+
+    // Live readings for the performance HUD, sampled once per frame between
+    // steps. Neither touches every cell, but they aren't all O(1): bit-matrix
+    // sizes walk the rows, and bucketed solvers walk their workers' buckets.
+    // Entries waiting in the solver's queue, stack or heap (stale heap
+    // entries included); 0 if it has none to report
+    virtual std::size_t getOpenSetSize() const { return 0; }
+    // Bytes held by the search: grid copy, parent map and the solver's own structures
+    virtual std::size_t getMemoryBytes() const;
+
+    // Cells the search expanded, i.e. coloured with this solver's symbol or
+    // on the final path, plus start and goal
+    std::vector<std::pair<int, int>> getExploredCells() const;
+
+    // Optional recording of expanded/enqueued/path events (not owned);
+    // the caller closes each step with log->endStep()
+    void setEventLog(EventLog* log) { m_events = log; }
+
+    // Snapshot support (see Checkpoint.h). Solvers that can't be checkpointed
+    // keep these defaults and return false. Snapshots don't hold a goal set,
+    // so BFS, Dijkstra and A* refuse to save on mazes with several goals.
+    virtual bool saveState(CheckpointWriter&) const { return false; }
+    virtual bool loadState(CheckpointReader&) { return false; }
+    char getSymbol() const { return symbol; }
+
+    // Backend of the parent map (and of the solver's own per-cell state)
+    CellStorage getStorage() const { return parent.getStorage(); }
+
 
 protected:
     char symbol;         // The character to draw 
@@ -47,13 +100,42 @@ protected:
     std::pair<int, int> goal;
     std::pair<int, int> tracePos; // For tracing the path back
     
-    // Path reconstruction
-    std::vector<std::vector<std::pair<int, int>>> parent; 
+    // Path reconstruction ({-1, -1} = no parent)
+    CellStore<std::pair<int, int>> parent;
 
     // All algorithms (BFS, A*, etc.) must update these
     int m_nodesExplored = 0;
     int m_pathLength = 0;
     sf::Time m_timeTaken = sf::Time::Zero;
+    sf::Time m_resumedTime = sf::Time::Zero; // Search time spent before the last resume
+
+    // Shared part of saveState()/loadState(): state, stats, grid and parents.
+    // 'clock' is the solver's running search clock.
+    void saveBaseState(CheckpointWriter& w, const sf::Clock& clock) const;
+    bool loadBaseState(CheckpointReader& r);
+
+    // Solvers that jump across cells (RectangleSymmetry) call this once the
+    // goal is found, so the parent chain steps one cell at a time again.
+    // Only the nearest goal's chain is rewritten: other goals' chains can
+    // cross it, and getGoalPaths() fills in their jumps itself.
+    void unfoldJumps();
+
+    // Multi-goal bookkeeping for the solvers that support it. goalReached()
+    // records the goal just expanded and, once enough are reached, switches to
+    // tracing the nearest one; anyGoalReached() does the same when the search
+    // runs out of cells first. Both return true if tracing started.
+    bool isGoal(int r, int c) const { return grid[r][c] == 'E'; }
+    bool goalReached(int r, int c);
+    bool anyGoalReached();
+    std::vector<std::pair<int, int>> m_reachedGoals;
+    int m_goalsWanted = 1;
+    bool m_severalGoals = false; // The maze had more than one goal
+
+    // Event recording, a no-op unless a log is attached
+    EventLog* m_events = nullptr;
+    void logEvent(EventLog::Type type, int r, int c) {
+        if (m_events) m_events->add(type, (std::uint32_t)(r * (int)grid[0].size() + c));
+    }
 };
 
 #endif // SOLVER_H
\ No newline at end of file
@@ -0,0 +1,193 @@
+#include "TerminalRenderer.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cerrno>
+#include <cstdio>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+    #include <sys/ioctl.h>
+#endif
+
+using namespace std;
+
+// Nearest colour in the xterm-256 6x6x6 cube
+static uint8_t cube(int r, int g, int b) {
+    auto level = [](int v) { return (v + 25) / 51; };
+    return (uint8_t)(16 + 36 * level(r) + 6 * level(g) + level(b));
+}
+
+// Same colours as the visualizer window
+uint8_t TerminalRenderer::colorFor(char cell) {
+    switch (cell) {
+        case '#': return 240;                 // Wall
+        case 'S': return cube(0, 255, 0);     // Start
+        case 'E': return cube(255, 255, 0);   // End
+        case 'X': return cube(255, 0, 0);     // Final Path
+        case 'B': return cube(0, 150, 255);   // BFS
+        case 'D': return cube(0, 200, 100);   // DFS
+        case 'A': return cube(200, 0, 200);   // A*
+        case 'K': return cube(255, 150, 0);   // Dijkstra
+        case 'G': return cube(0, 200, 200);   // Greedy
+        case 'P': return cube(100, 100, 255); // Parallel BFS
+        case 'H': return cube(255, 100, 150); // HDA*
+        case 'R': return cube(255, 220, 120); // ARA*
+        case 'C': return cube(150, 220, 0);   // Corridor graph
+        case 'W': return cube(180, 120, 60);  // Delta-stepping
+        default:  return 0;
+    }
+}
+
+TerminalRenderer::TerminalRenderer(int fd) : m_fd(fd) {}
+
+TerminalRenderer::~TerminalRenderer() {
+    if (m_frames == 0) return;
+    // Reset colours, show the cursor and leave it below the last frame
+    writeAll("\x1b[0m\x1b[" + to_string(m_height + 1) + ";1H\x1b[?25h");
+}
+
+pair<int, int> TerminalRenderer::terminalSize(int fd) {
+#ifndef _WIN32
+    winsize ws{};
+    if (ioctl(fd, TIOCGWINSZ, &ws) == 0 && ws.ws_col > 0 && ws.ws_row > 0) {
+        return {ws.ws_col, ws.ws_row};
+    }
+#else
+    (void)fd;
+#endif
+    // Not a terminal (e.g. piped to a file): honour COLUMNS / LINES if set
+    const char* cols = getenv("COLUMNS");
+    const char* lines = getenv("LINES");
+    return {cols ? max(1, atoi(cols)) : 80, lines ? max(1, atoi(lines)) : 24};
+}
+
+void TerminalRenderer::resize(int width, int height) {
+    m_width = width;
+    m_height = height;
+    m_front.assign((size_t)width * height, Cell{});
+    m_back.assign((size_t)width * height, Cell{});
+    m_fullRedraw = true;
+}
+
+void TerminalRenderer::put(int row, int col, char ch, uint8_t color) {
+    if (row < 0 || col < 0 || row >= m_height || col >= m_width) return; // Clipped
+    m_back[(size_t)row * m_width + col] = Cell{ch, color};
+}
+
+void TerminalRenderer::text(int row, int col, const string& s, uint8_t color) {
+    for (size_t i = 0; i < s.size(); ++i) put(row, col + (int)i, s[i], color);
+}
+
+void TerminalRenderer::draw(const vector<vector<string>>& grids, const vector<string>& titles) {
+    TRACE_SCOPE("TerminalRenderer::draw");
+    // Panel size from the largest grid, so panels line up in columns
+    int gridRows = 0;
+    int gridCols = 0;
+    for (const auto& g : grids) {
+        gridRows = max(gridRows, (int)g.size());
+        if (!g.empty()) gridCols = max(gridCols, (int)g[0].size());
+    }
+    int panelWidth = gridCols + 3;
+    for (const string& t : titles) panelWidth = max(panelWidth, (int)t.size() + 1);
+    int panelHeight = gridRows + 3; // Title, blank line, grid, blank line
+
+    pair<int, int> term = terminalSize(m_fd);
+    int perRow = max(1, min((int)grids.size(), term.first / max(1, panelWidth)));
+    int panelRows = ((int)grids.size() + perRow - 1) / perRow;
+
+    // Frames larger than the terminal are clipped rather than scrolled
+    int width = min(term.first, max(perRow * panelWidth, (int)m_status.size()));
+    int height = min(term.second - 1, panelRows * panelHeight + (m_status.empty() ? 0 : 1));
+    width = max(width, 1);
+    height = max(height, 1);
+    if (width != m_width || height != m_height) resize(width, height);
+
+    fill(m_back.begin(), m_back.end(), Cell{});
+    for (size_t i = 0; i < grids.size(); ++i) {
+        int top = (int)(i / perRow) * panelHeight;
+        int left = (int)(i % perRow) * panelWidth;
+        if (i < titles.size()) text(top, left, titles[i], 0);
+        const vector<string>& g = grids[i];
+        for (int r = 0; r < (int)g.size() && top + 2 + r < m_height; ++r) {
+            const string& line = g[r];
+            for (int c = 0; c < (int)line.size(); ++c) {
+                put(top + 2 + r, left + c, line[c], colorFor(line[c]));
+            }
+        }
+    }
+    if (!m_status.empty()) text(panelRows * panelHeight, 0, m_status, 0);
+
+    present();
+}
+
+void TerminalRenderer::present() {
+    TRACE_SCOPE("TerminalRenderer::present");
+    m_out.clear();
+    if (m_fullRedraw) {
+        // Hide the cursor and clear; the front buffer is now all blanks
+        m_out += "\x1b[?25l\x1b[0m\x1b[2J";
+        fill(m_front.begin(), m_front.end(), Cell{});
+        m_fullRedraw = false;
+    }
+
+    int cursorRow = -1;
+    int cursorCol = -1;
+    uint8_t color = 0; // Every frame ends with a colour reset
+    char number[24];
+
+    for (int r = 0; r < m_height; ++r) {
+        for (int c = 0; c < m_width; ++c) {
+            size_t i = (size_t)r * m_width + c;
+            const Cell& cell = m_back[i];
+            if (cell == m_front[i]) continue;
+
+            if (r != cursorRow || c != cursorCol) {
+                int n = snprintf(number, sizeof(number), "\x1b[%d;%dH", r + 1, c + 1);
+                m_out.append(number, n);
+            }
+            if (cell.color != color) {
+                if (cell.color == 0) {
+                    m_out += "\x1b[0m";
+                } else {
+                    int n = snprintf(number, sizeof(number), "\x1b[38;5;%dm", cell.color);
+                    m_out.append(number, n);
+                }
+                color = cell.color;
+            }
+            m_out += cell.ch;
+            m_front[i] = cell;
+            ++m_cellsChanged;
+
+            cursorRow = r;
+            // After the last column the cursor position depends on the terminal
+            cursorCol = c + 1 < m_width ? c + 1 : -1;
+        }
+    }
+    if (color != 0) m_out += "\x1b[0m";
+
+    ++m_frames;
+    if (!m_out.empty()) writeAll(m_out);
+}
+
+// One write() per frame, unless the kernel accepts only part of it
+void TerminalRenderer::writeAll(const string& data) {
+    const char* p = data.data();
+    size_t left = data.size();
+    while (left > 0) {
+#ifdef _WIN32
+        int n = _write(m_fd, p, (unsigned)left);
+#else
+        ssize_t n = ::write(m_fd, p, left);
+#endif
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        p += n;
+        left -= (size_t)n;
+        m_bytesWritten += (uint64_t)n;
+    }
+}
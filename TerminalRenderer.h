@@ -0,0 +1,63 @@
+#ifndef TERMINALRENDERER_H
+#define TERMINALRENDERER_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// Draws solver grids as coloured text panels on an ANSI terminal.
+// Keeps the last frame that was sent (front) and the frame being built
+// (back); present() sends only the cells that changed, as cursor moves and
+// colour escapes, in a single write() to the output.
+class TerminalRenderer {
+public:
+    // fd: file descriptor to write frames to (stdout by default)
+    explicit TerminalRenderer(int fd = 1);
+    ~TerminalRenderer(); // Restores the cursor and colours
+
+    // Lays out any number of panels in rows that fit the terminal width,
+    // each with its title above it, and sends the changes
+    void draw(const std::vector<std::vector<std::string>>& grids,
+              const std::vector<std::string>& titles);
+
+    // Text line below the panels (e.g. live stats); empty to remove
+    void setStatus(const std::string& status) { m_status = status; }
+
+    // Terminal size in characters (falls back to 80 x 24 if unknown)
+    static std::pair<int, int> terminalSize(int fd);
+
+    int getFrames() const { return m_frames; }
+    std::uint64_t getBytesWritten() const { return m_bytesWritten; }
+    std::uint64_t getCellsChanged() const { return m_cellsChanged; }
+
+private:
+    struct Cell {
+        char ch = ' ';
+        std::uint8_t color = 0; // 0 = terminal default, else xterm-256 index
+        bool operator==(const Cell& o) const { return ch == o.ch && color == o.color; }
+        bool operator!=(const Cell& o) const { return !(*this == o); }
+    };
+
+    void resize(int width, int height);
+    void put(int row, int col, char ch, std::uint8_t color);
+    void text(int row, int col, const std::string& s, std::uint8_t color);
+    void present();
+    void writeAll(const std::string& data);
+
+    static std::uint8_t colorFor(char cell);
+
+    int m_fd;
+    int m_width = 0;
+    int m_height = 0;
+    std::vector<Cell> m_front;
+    std::vector<Cell> m_back;
+    bool m_fullRedraw = true;
+    std::string m_out;       // Escape sequences for one frame
+    std::string m_status;
+
+    int m_frames = 0;
+    std::uint64_t m_bytesWritten = 0;
+    std::uint64_t m_cellsChanged = 0;
+};
+
+#endif // TERMINALRENDERER_H
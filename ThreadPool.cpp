@@ -0,0 +1,85 @@
+#include "ThreadPool.h"
+#include "Trace.h"
+#include <algorithm>
+#include <string>
+
+using namespace std;
+
+ThreadPool::ThreadPool(unsigned threads)
+{
+    if (threads == 0) {
+        threads = thread::hardware_concurrency();
+    }
+    m_threadCount = max(1u, threads);
+
+    // Worker 0 is the caller, so only spawn the remaining ones
+    for (unsigned i = 1; i < m_threadCount; ++i) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& t : m_workers) t.join();
+}
+
+void ThreadPool::workerLoop(unsigned index) {
+    Trace::setThreadName("pool worker " + to_string(index));
+    unsigned long seen = 0;
+    while (true) {
+        function<void(unsigned)> task;
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stopping || m_generation != seen; });
+            if (m_stopping) return;
+            seen = m_generation;
+            task = m_task;
+        }
+
+        {
+            TRACE_SCOPE("ThreadPool task");
+            task(index);
+        }
+
+        lock_guard<mutex> lock(m_mutex);
+        if (--m_pending == 0) m_done.notify_one();
+    }
+}
+
+void ThreadPool::runOnAll(const function<void(unsigned)>& fn) {
+    if (m_threadCount == 1) {
+        fn(0);
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_task = fn;
+        m_pending = m_threadCount - 1;
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    {
+        TRACE_SCOPE("ThreadPool task");
+        fn(0); // The caller does its share too
+    }
+
+    unique_lock<mutex> lock(m_mutex);
+    m_done.wait(lock, [&] { return m_pending == 0; });
+}
+
+void ThreadPool::parallelFor(size_t n,
+                             const function<void(unsigned, size_t, size_t)>& fn)
+{
+    size_t chunk = (n + m_threadCount - 1) / m_threadCount;
+    runOnAll([&](unsigned t) {
+        size_t begin = min(n, t * chunk);
+        size_t end   = min(n, begin + chunk);
+        fn(t, begin, end);
+    });
+}
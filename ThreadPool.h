@@ -0,0 +1,48 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstddef>
+
+// Small fixed-size pool used by the parallel solvers.
+// parallelFor() splits [0, n) into one contiguous chunk per worker and blocks
+// until every chunk is done, so callers get a barrier after each phase.
+class ThreadPool {
+public:
+    // threads == 0 means "one per hardware core"
+    explicit ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return m_threadCount; }
+
+    // fn(threadIndex, begin, end) is called once per worker (the calling
+    // thread acts as worker 0)
+    void parallelFor(std::size_t n,
+                     const std::function<void(unsigned, std::size_t, std::size_t)>& fn);
+
+    // fn(threadIndex) is called once on every worker
+    void runOnAll(const std::function<void(unsigned)>& fn);
+
+private:
+    void workerLoop(unsigned index);
+
+    unsigned m_threadCount;
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    std::function<void(unsigned)> m_task;
+    unsigned long m_generation = 0;
+    unsigned m_pending = 0;
+    bool m_stopping = false;
+};
+
+#endif // THREAD_POOL_H
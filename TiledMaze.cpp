@@ -0,0 +1,148 @@
+#include "TiledMaze.h"
+#include "Maze.h"
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+static const char TILE_MAGIC[8] = {'M', 'Z', 'T', 'I', 'L', 'E', '1', '\0'};
+
+class TiledMaze::Writer {
+public:
+    Writer(const string& path, long long rows, long long cols, int tileSize,
+           CellId start, CellId goal)
+        : out(path, ios::binary | ios::trunc), cols(cols), tileSize(tileSize)
+    {
+        if (tileSize <= 0 || tileSize % 8 != 0) {
+            throw invalid_argument("TiledMaze: tile size must be a positive multiple of 8");
+        }
+        if (!out) throw runtime_error("TiledMaze: cannot create " + path);
+
+        Header h{};
+        memcpy(h.magic, TILE_MAGIC, sizeof(h.magic));
+        h.rows = rows;
+        h.cols = cols;
+        h.tileSize = tileSize;
+        h.start = start;
+        h.goal = goal;
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+
+        tilesAcross = (cols + tileSize - 1) / tileSize;
+        tileBytes = (size_t)tileSize * tileSize / 8;
+        band.assign(tilesAcross * tileBytes, 0);
+    }
+
+    void addRow(const string& row) {
+        long long local = rowInBand;
+        for (long long c = 0; c < cols; ++c) {
+            if (row[c] == '#') continue;
+            long long bit = local * tileSize + c % tileSize;
+            band[(c / tileSize) * tileBytes + bit / 8] |= uint8_t(1u << (bit % 8));
+        }
+        if (++rowInBand == tileSize) flushBand();
+    }
+
+    void finish() {
+        if (rowInBand > 0) flushBand();
+        if (!out) throw runtime_error("TiledMaze: write failed");
+    }
+
+private:
+    void flushBand() {
+        out.write(reinterpret_cast<const char*>(band.data()), band.size());
+        fill(band.begin(), band.end(), 0);
+        rowInBand = 0;
+    }
+
+    ofstream out;
+    long long cols;
+    long long tileSize;
+    long long tilesAcross;
+    size_t tileBytes;
+    long long rowInBand = 0;
+    vector<uint8_t> band; // One row of tiles
+};
+
+void TiledMaze::write(const Maze& maze, const string& path, int tileSize) {
+    long long C = maze.getCols();
+    auto s = maze.getStart();
+    auto g = maze.getGoal();
+
+    Writer w(path, (long long)maze.grid.size(), C, tileSize,
+             (CellId)s.first * C + s.second, (CellId)g.first * C + g.second);
+    for (const string& row : maze.grid) w.addRow(row);
+    w.finish();
+}
+
+void TiledMaze::generate(const string& path, long long rows, long long cols,
+                         unsigned seed, int wallDensity, int tileSize)
+{
+    // Same minimum size Maze enforces
+    rows = max(rows, 5LL);
+    cols = max(cols, 5LL);
+
+    Maze::RowGenerator gen(rows, cols, seed, wallDensity);
+    auto s = gen.getStart();
+    auto g = gen.getGoal();
+
+    Writer w(path, rows, cols, tileSize,
+             (CellId)(s.first * cols + s.second), (CellId)(g.first * cols + g.second));
+    string row;
+    for (long long r = 0; r < rows; ++r) {
+        gen.nextRow(row);
+        w.addRow(row);
+    }
+    w.finish();
+}
+
+TiledMaze::TiledMaze(const string& path, size_t cacheTiles)
+    : file(path, ios::binary), m_cacheTiles(max<size_t>(1, cacheTiles))
+{
+    if (!file) throw runtime_error("TiledMaze: cannot open " + path);
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || memcmp(header.magic, TILE_MAGIC, sizeof(TILE_MAGIC)) != 0) {
+        throw runtime_error("TiledMaze: " + path + " is not a tile file");
+    }
+    tilesAcross = (header.cols + header.tileSize - 1) / header.tileSize;
+}
+
+const vector<uint8_t>& TiledMaze::tile(uint64_t index) {
+    auto it = cached.find(index);
+    if (it != cached.end()) {
+        lru.splice(lru.begin(), lru, it->second);
+        return it->second->second;
+    }
+
+    // Reuse the least recently used buffer once the cache is full
+    vector<uint8_t> data;
+    if (lru.size() >= m_cacheTiles) {
+        cached.erase(lru.back().first);
+        data = move(lru.back().second);
+        lru.pop_back();
+    }
+    data.resize(tileBytes());
+
+    file.seekg((streamoff)(sizeof(Header) + index * tileBytes()));
+    file.read(reinterpret_cast<char*>(data.data()), tileBytes());
+    if (!file) throw runtime_error("TiledMaze: short read on tile " + to_string(index));
+    m_tileLoads++;
+
+    lru.emplace_front(index, move(data));
+    cached[index] = lru.begin();
+    return lru.front().second;
+}
+
+bool TiledMaze::isOpen(long long r, long long c) {
+    if (r < 0 || c < 0 || r >= header.rows || c >= header.cols) return false;
+
+    long long ts = header.tileSize;
+    uint64_t index = (uint64_t)((r / ts) * tilesAcross + c / ts);
+
+    // Consecutive lookups almost always hit the same tile
+    if (index != m_lastIndex) {
+        m_lastTile = &tile(index);
+        m_lastIndex = index;
+    }
+    long long bit = (r % ts) * ts + c % ts;
+    return ((*m_lastTile)[bit / 8] >> (bit % 8)) & 1;
+}
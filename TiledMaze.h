@@ -0,0 +1,75 @@
+#ifndef TILED_MAZE_H
+#define TILED_MAZE_H
+
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <fstream>
+#include <cstdint>
+#include <utility>
+#include "MazeSource.h"
+
+class Maze;
+
+// A maze stored on disk as square tiles of packed wall bits, so it can be far
+// larger than RAM. Tiles are laid out row-band by row-band; only a bounded LRU
+// set of tiles is kept in memory while reading.
+//
+// File layout: a fixed Header, then tilesDown * tilesAcross tiles of
+// tileSize * tileSize bits each (1 = walkable), cells outside the maze are walls.
+class TiledMaze : public MazeSource {
+public:
+    using CellId = std::uint64_t; // r * cols + c
+
+    // Writes an in-memory maze as a tile file
+    static void write(const Maze& maze, const std::string& path, int tileSize = 256);
+
+    // Streams Maze::RowGenerator straight to disk; gives the same cells as
+    // Maze(rows, cols, seed) without ever holding the grid in memory
+    static void generate(const std::string& path, long long rows, long long cols,
+                         unsigned seed, int wallDensity = 25, int tileSize = 256);
+
+    // Opens a tile file for reading; keeps at most cacheTiles tiles in memory
+    explicit TiledMaze(const std::string& path, std::size_t cacheTiles = 1024);
+
+    long long getRows() const { return header.rows; }
+    long long getCols() const { return header.cols; }
+    CellId getStart() const { return header.start; }
+    CellId getGoal()  const { return header.goal;  }
+
+    // True if the cell is inside the maze and not a wall
+    bool isOpen(long long r, long long c) override;
+
+    // I/O counters
+    std::uint64_t getTileLoads() const { return m_tileLoads; }
+    std::uint64_t getBytesRead() const { return m_tileLoads * tileBytes(); }
+
+private:
+    struct Header {
+        char magic[8];
+        std::int64_t rows, cols;
+        std::int32_t tileSize, reserved;
+        std::uint64_t start, goal;
+    };
+
+    // Streams rows into tile bands and writes them out
+    class Writer;
+
+    std::size_t tileBytes() const { return (std::size_t)header.tileSize * header.tileSize / 8; }
+    const std::vector<std::uint8_t>& tile(std::uint64_t index);
+
+    Header header;
+    long long tilesAcross = 0;
+    std::ifstream file;
+
+    // LRU cache: most recently used tile at the front
+    std::size_t m_cacheTiles;
+    std::list<std::pair<std::uint64_t, std::vector<std::uint8_t>>> lru;
+    std::unordered_map<std::uint64_t, decltype(lru)::iterator> cached;
+    std::uint64_t m_lastIndex = UINT64_MAX;
+    const std::vector<std::uint8_t>* m_lastTile = nullptr;
+    std::uint64_t m_tileLoads = 0;
+};
+
+#endif // TILED_MAZE_H
@@ -0,0 +1,114 @@
+#include "Trace.h"
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cstdio>
+
+using namespace std;
+
+atomic<bool> Trace::s_enabled{false};
+
+namespace {
+
+struct Event {
+    const char* name;
+    int64_t begin, end; // ns
+};
+
+struct ThreadBuffer {
+    int tid;
+    string name;
+    vector<Event> events;
+};
+
+// Never destroyed, so threads and atexit handlers can use it at any time
+struct Registry {
+    mutex lock;
+    vector<unique_ptr<ThreadBuffer>> buffers;
+    chrono::steady_clock::time_point epoch = chrono::steady_clock::now();
+};
+
+Registry& registry() {
+    static Registry* r = new Registry;
+    return *r;
+}
+
+thread_local ThreadBuffer* t_buffer = nullptr;
+
+// The calling thread's buffer, registered on first use
+ThreadBuffer& threadBuffer() {
+    if (!t_buffer) {
+        Registry& r = registry();
+        lock_guard<mutex> guard(r.lock);
+        r.buffers.push_back(make_unique<ThreadBuffer>());
+        t_buffer = r.buffers.back().get();
+        t_buffer->tid = (int)r.buffers.size();
+        t_buffer->events.reserve(4096);
+    }
+    return *t_buffer;
+}
+
+// Names are literals from this codebase; escape anyway
+string jsonString(const string& s) {
+    string out = "\"";
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') out += '\\';
+        if ((unsigned char)ch < 0x20) continue;
+        out += ch;
+    }
+    return out + "\"";
+}
+
+} // namespace
+
+void Trace::enable() {
+    registry().epoch = chrono::steady_clock::now();
+    s_enabled.store(true, memory_order_relaxed);
+}
+
+int64_t Trace::now() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - registry().epoch).count();
+}
+
+void Trace::record(const char* name, int64_t begin, int64_t end) {
+    threadBuffer().events.push_back({name, begin, end});
+}
+
+void Trace::setThreadName(const string& name) {
+    if (isEnabled()) threadBuffer().name = name;
+}
+
+size_t Trace::getEventCount() {
+    Registry& r = registry();
+    lock_guard<mutex> guard(r.lock);
+    size_t count = 0;
+    for (const auto& b : r.buffers) count += b->events.size();
+    return count;
+}
+
+bool Trace::write(const string& path) {
+    ofstream out(path, ios::binary);
+    if (!out) return false;
+
+    Registry& r = registry();
+    lock_guard<mutex> guard(r.lock);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first = true;
+    char line[64];
+    for (const auto& b : r.buffers) {
+        string name = b->name.empty() ? "thread " + to_string(b->tid) : b->name;
+        out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << b->tid
+            << ",\"args\":{\"name\":" << jsonString(name) << "}}";
+        first = false;
+
+        // Complete events ("X"), timestamps in microseconds
+        for (const Event& e : b->events) {
+            snprintf(line, sizeof(line), ",\"ts\":%.3f,\"dur\":%.3f", e.begin / 1000.0, (e.end - e.begin) / 1000.0);
+            out << ",\n{\"name\":" << jsonString(e.name) << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << b->tid << line << "}";
+        }
+    }
+    out << "\n]}\n";
+    return (bool)out;
+}
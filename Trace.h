@@ -0,0 +1,66 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+// Timeline markers exported as Chrome trace-event JSON (open the file in
+// Perfetto or chrome://tracing).
+//
+//     void Maze::generate() {
+//         TRACE_SCOPE("Maze::generate");
+//         ...
+//     }
+//
+// Each scope becomes one complete event on its thread's track. Events go to
+// a per-thread buffer with no locking. While tracing is off a scope costs a
+// single relaxed atomic load.
+//
+// Names must be string literals (only the pointer is kept).
+class Trace {
+public:
+    // Starts recording on all threads; timestamps count from here
+    static void enable();
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    // Nanoseconds since enable()
+    static std::int64_t now();
+
+    static void record(const char* name, std::int64_t begin, std::int64_t end);
+
+    // Label for the calling thread's track
+    static void setThreadName(const std::string& name);
+
+    // Writes every recorded event. Other threads must not be recording
+    // while this runs (call it at the end of a run).
+    static bool write(const std::string& path);
+
+    static std::size_t getEventCount();
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+class TraceScope {
+public:
+    explicit TraceScope(const char* name)
+        : m_name(name), m_begin(Trace::isEnabled() ? Trace::now() : -1) {}
+    ~TraceScope() {
+        if (m_begin >= 0) Trace::record(m_name, m_begin, Trace::now());
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_name;
+    std::int64_t m_begin;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name)
+
+#endif // TRACE_H
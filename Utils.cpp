@@ -14,6 +14,12 @@ const array<pair<int,int>,4> directions {{
     {0, -1}   // 3: Left
 }};
 
+size_t bitMatrixBytes(const vector<vector<bool>>& m) {
+    size_t bytes = m.size() * sizeof(vector<bool>);
+    for (const vector<bool>& row : m) bytes += (row.capacity() + 7) / 8;
+    return bytes;
+}
+
 bool isInside(const vector<string>& g, int r, int c) {
     return r >= 0 && c >= 0 &&
            r < (int)g.size() &&
@@ -24,7 +30,8 @@ void clearConsole() {
     #ifdef _WIN32
         system("cls");
     #else
-        system("clear");
+        // Escape sequence instead of spawning `clear` every frame
+        cout << "\x1b[2J\x1b[H" << flush;
     #endif
 }
 
@@ -32,7 +39,9 @@ void sleep_ms(int ms) {
     this_thread::sleep_for(chrono::milliseconds(ms));
 }
 
-// Print function to display multiple mazes side by side
+// Print function to display multiple mazes side by side, three per row.
+// The whole frame is built in one string and written at once; for live
+// redraws use TerminalRenderer, which only sends the changed cells.
 void printSideBySide(const vector<vector<string>>& grids,
                      const vector<string>& titles)
 {
@@ -42,52 +51,35 @@ void printSideBySide(const vector<vector<string>>& grids,
     size_t R = grids[0].size();
     // Calculate width of one maze + padding
     size_t C_WIDTH = (grids[0].empty() ? 0 : grids[0][0].size()) + 3;
-    size_t TITLE_WIDTH = C_WIDTH; 
+    size_t TITLE_WIDTH = C_WIDTH;
 
-    // Print Top Row (Solvers 0, 1, 2)
-    if (N > 0) {
-        // Print top 3 titles
-        for (size_t i = 0; i < 3 && i < N; i++) {
-            cout << titles[i];
-            // Add padding
-            if (titles[i].size() < TITLE_WIDTH) {
-                cout << string(TITLE_WIDTH - titles[i].size(), ' ');
-            }
-        }
-        cout << "\n\n";
+    string frame;
+    frame.reserve((C_WIDTH * 3 + 1) * (R + 4) * ((N + 2) / 3));
 
-        // Print top 3 grids, row by row
-        for (size_t r = 0; r < R; r++) {
-            for (size_t i = 0; i < 3 && i < N; i++) {
-                if (r < grids[i].size()) {
-                    cout << grids[i][r] << "   ";
-                }
-            }
-            cout << "\n";
-        }
-    }
-
-    cout << "\n\n"; // Spacer between rows
+    for (size_t first = 0; first < N; first += 3) {
+        if (first > 0) frame += "\n\n"; // Spacer between rows
 
-    // Print Bottom Row (Solvers 3, 4)
-    if (N > 3) {
-        // Print bottom 3 titles
-        for (size_t i = 3; i < 6 && i < N; i++) {
-            cout << titles[i];
-            if (titles[i].size() < TITLE_WIDTH) {
-                cout << string(TITLE_WIDTH - titles[i].size(), ' ');
-            }
+        // Titles
+        for (size_t i = first; i < first + 3 && i < N; i++) {
+            frame += i < titles.size() ? titles[i] : string();
+            // Add padding
+            size_t len = i < titles.size() ? titles[i].size() : 0;
+            if (len < TITLE_WIDTH) frame.append(TITLE_WIDTH - len, ' ');
         }
-        cout << "\n\n";
+        frame += "\n\n";
 
-        // Print bottom 3 grids, row by row
+        // Grids, row by row
         for (size_t r = 0; r < R; r++) {
-            for (size_t i = 3; i < 6 && i < N; i++) {
+            for (size_t i = first; i < first + 3 && i < N; i++) {
                 if (r < grids[i].size()) {
-                    cout << grids[i][r] << "   ";
+                    frame += grids[i][r];
+                    frame += "   ";
                 }
             }
-            cout << "\n";
+            frame += '\n';
         }
     }
+
+    cout.write(frame.data(), (streamsize)frame.size());
+    cout.flush();
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <string>
 #include <utility>
 #include <array>
+#include <cstddef>
 
 extern const std::array<std::pair<int,int>,4> directions;
 
@@ -13,5 +14,7 @@ void clearConsole();
 void sleep_ms(int ms);
 void printSideBySide(const std::vector<std::vector<std::string>>& grids,
                      const std::vector<std::string>& titles);
+// Heap bytes of a vector<vector<bool>> (one bit per cell plus row headers)
+std::size_t bitMatrixBytes(const std::vector<std::vector<bool>>& m);
 
 #endif
@@ -0,0 +1,73 @@
+#include "WorkStealing.h"
+#include "Trace.h"
+
+using namespace std;
+
+bool WorkStealingScheduler::takeOwn(unsigned worker, size_t& job) {
+    Block& block = m_blocks[worker];
+    lock_guard<mutex> guard(block.lock);
+    if (block.begin >= block.end) return false;
+    job = block.begin++;
+    return true;
+}
+
+bool WorkStealingScheduler::steal(unsigned worker, unsigned& rng) {
+    unsigned workers = size();
+    rng = rng * 1664525u + 1013904223u; // LCG: a different first victim each time
+    unsigned first = (rng >> 16) % workers;
+
+    for (unsigned i = 0; i < workers; ++i) {
+        unsigned victim = (first + i) % workers;
+        if (victim == worker) continue;
+
+        size_t begin, end;
+        {
+            Block& block = m_blocks[victim];
+            lock_guard<mutex> guard(block.lock);
+            size_t left = block.end - block.begin;
+            if (left == 0) {
+                m_stats[worker].failedSteals++;
+                continue;
+            }
+            // The back half, rounded up so a single job can be stolen too
+            end = block.end;
+            begin = block.end - (left + 1) / 2;
+            block.end = begin;
+        }
+
+        Block& own = m_blocks[worker];
+        lock_guard<mutex> guard(own.lock);
+        own.begin = begin;
+        own.end = end;
+        m_stats[worker].steals++;
+        m_stats[worker].stolenJobs += (long long)(end - begin);
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingScheduler::run(size_t jobs, const function<void(unsigned, size_t)>& fn) {
+    unsigned workers = size();
+    m_blocks = vector<Block>(workers);
+    m_stats.assign(workers, WorkerStats());
+
+    // Equal contiguous blocks to start with
+    size_t chunk = (jobs + workers - 1) / workers;
+    for (unsigned w = 0; w < workers; ++w) {
+        m_blocks[w].begin = min(jobs, w * chunk);
+        m_blocks[w].end = min(jobs, m_blocks[w].begin + chunk);
+    }
+
+    m_pool.runOnAll([&](unsigned worker) {
+        unsigned rng = 2654435761u * (worker + 1);
+        size_t job;
+        while (true) {
+            while (takeOwn(worker, job)) {
+                fn(worker, job);
+                m_stats[worker].executed++;
+            }
+            TRACE_SCOPE("steal");
+            if (!steal(worker, rng)) break;
+        }
+    });
+}
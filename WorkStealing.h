@@ -0,0 +1,53 @@
+#ifndef WORK_STEALING_H
+#define WORK_STEALING_H
+
+#include <vector>
+#include <mutex>
+#include <functional>
+#include <cstddef>
+#include "ThreadPool.h"
+
+// Work-stealing loop over independent jobs [0, n), for batches whose jobs
+// vary a lot in cost (mazes of different sizes, solvable or not).
+//
+// Each worker starts with one contiguous block of job indices and runs them
+// from the front. A worker that runs dry picks victims in turn, starting at a
+// random one, and takes the back half of the first non-empty block it finds.
+// Jobs never create new jobs, so a worker whose sweep finds nothing is done.
+// The threads come from a ThreadPool, so the caller works as worker 0.
+class WorkStealingScheduler {
+public:
+    struct WorkerStats {
+        long long executed = 0;     // Jobs run by this worker
+        long long steals = 0;       // Successful steals (each takes half a block)
+        long long stolenJobs = 0;   // Jobs gained by stealing
+        long long failedSteals = 0; // Victims found empty
+    };
+
+    // threads == 0 means "one per hardware core"
+    explicit WorkStealingScheduler(unsigned threads = 0) : m_pool(threads) {}
+
+    unsigned size() const { return m_pool.size(); }
+
+    // Calls fn(worker, job) once for every job; returns when all are done
+    void run(std::size_t jobs, const std::function<void(unsigned, std::size_t)>& fn);
+
+    // Stats of the last run(), one entry per worker
+    const std::vector<WorkerStats>& getStats() const { return m_stats; }
+
+private:
+    // A worker's remaining jobs [begin, end); on its own cache line
+    struct alignas(64) Block {
+        std::mutex lock;
+        std::size_t begin = 0, end = 0;
+    };
+
+    bool takeOwn(unsigned worker, std::size_t& job);
+    bool steal(unsigned worker, unsigned& rng);
+
+    ThreadPool m_pool;
+    std::vector<Block> m_blocks;
+    std::vector<WorkerStats> m_stats;
+};
+
+#endif // WORK_STEALING_H
@@ -5,6 +5,7 @@
 #include <memory>       //  Data Structure: Using std::unique_ptr for smart pointers (manages solver memory)
 #include <map>          // Data Structure: Using std::map to store results (key=algo name, value=stats)
 #include <limits>   
+#include <algorithm>
 #include <SFML/Graphics.hpp> 
 #include "Maze.h"
 #include "Utils.h" 
@@ -14,16 +15,31 @@
 #include "Dijkstra_Solver.h"
 #include "AStar_Solver.h"
 #include "GreedyBestFirst_Solver.h"
+#include "ParallelBFS_Solver.h"
+#include "HDAStar_Solver.h"
+#include "Headless.h"
+#include "ResultCache.h"
+#include "EventLog.h"
+#include "FlowField.h"
+#include "CooperativeAStar.h"
+#include "MazeView.h"
+#include "PerfHud.h"
+#include "Trace.h"
+#include <cstdlib>
+#include <cmath>
 
 // For Visualisation Window 
 const float CELL_SIZE = 20.0f;  
 const float PADDING = 40.0f;    
 const unsigned int FONT_SIZE = 24;
 const float TITLE_HEIGHT = 40.0f; 
+const float MAX_MAZE_WIDTH = 1400.0f;  // Bigger mazes start zoomed out (see MazeView)
+const float MAX_MAZE_HEIGHT = 850.0f;
 
 // To simulate the speed of visualisation
 const sf::Time TIME_PER_STEP = sf::milliseconds(5); 
 const sf::Time PAUSE_ON_FINISH = sf::seconds(2.5f); 
+const sf::Time TIME_PER_AGENT_MOVE = sf::milliseconds(150); // Slow enough to follow each agent
 
 // Storing state values
 enum class VizState {
@@ -43,49 +59,107 @@ struct AlgoStats {
 
 
 
- //@brief Gets the SFML color for a specific cell type.
- 
-sf::Color getCellColor(char cellType, sf::Color traversalColor) {
-    switch (cellType) {
-        case '#': return sf::Color(50, 50, 50);    // Wall
-        case ' ': return sf::Color::White;          // Empty
-        case 'S': return sf::Color::Green;          // Start
-        case 'E': return sf::Color::Yellow;         // End 
-        case 'X': return sf::Color::Red;            // Final Path
-        default:  return traversalColor;            // Algorithm's visited color
+ // @brief Camera state and controls, shown under the title
+std::string viewStatus(const MazeView& view) {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "Zoom %.2f px/cell", view.getZoom());
+    std::string status = buffer;
+    if (view.getLevel() > 0) {
+        int block = 1 << view.getLevel();
+        status += " (" + std::to_string(block) + "x" + std::to_string(block) + " blocks)";
     }
+    return status + "   Wheel/+/-: zoom, drag/WASD: pan, 0: fit";
 }
 
 
- // @brief Draws a single maze (either base or from a solver) to the window
+ // @brief Draws a maze (either base or from a solver) to the window
 void drawMaze(sf::RenderWindow& window,
-              const std::vector<std::string>& grid, // Data Structure: Using std::vector<std::string> as the 2D grid
+              MazeView& view,
               sf::Font& font,
               const std::string& title,
-              sf::Color traversalColor) 
+              const std::string& status)
 {
+    TRACE_SCOPE("drawMaze");
     sf::Text titleText(title, font, FONT_SIZE);
     titleText.setPosition(PADDING, PADDING / 2.0f);
     titleText.setFillColor(sf::Color::White);
     window.draw(titleText);
 
-    // Draw maze
-    sf::RectangleShape cellRect(sf::Vector2f(CELL_SIZE, CELL_SIZE));
-    float gridBaseY = PADDING + TITLE_HEIGHT;
-    
-    for (size_t r = 0; r < grid.size(); ++r) {
-        for (size_t c = 0; c < grid[r].size(); ++c) {
-            cellRect.setPosition(PADDING + c * CELL_SIZE, gridBaseY + r * CELL_SIZE);
-            
-            char cellType = grid[r][c];
-            cellRect.setFillColor(getCellColor(cellType, traversalColor));
-            
-            window.draw(cellRect);
+    sf::Text statusText(status, font, 14);
+    statusText.setPosition(PADDING, PADDING / 2.0f + FONT_SIZE + 8.0f);
+    statusText.setFillColor(sf::Color(255, 255, 255, 150));
+    window.draw(statusText);
+
+    // Draw maze: only the cells (or blocks) in view
+    view.draw(window);
+}
+
+
+
+ // @brief Builds the flow field overlay: a short line from each visible open
+ // cell towards its next move, shaded from yellow (near the goal) to blue (far).
+ // Empty while the view is zoomed out to blocks.
+sf::VertexArray buildFlowOverlay(const FlowField& field, const MazeView& view) {
+    sf::VertexArray lines(sf::Lines);
+    if (view.getLevel() > 0) return lines;
+    float farthest = (float)std::max(1, (int)field.getMaxDistance());
+    float cellSize = view.getZoom();
+
+    int r0, c0, r1, c1;
+    view.visibleCells(r0, c0, r1, c1);
+    for (int r = r0; r < r1; ++r) {
+        for (int c = c0; c < c1; ++c) {
+            if (field.nextMove(r, c) == FlowField::NO_MOVE) continue;
+
+            std::pair<int, int> next = field.nextCell(r, c);
+            float t = field.distance(r, c) / farthest;
+            sf::Color color((sf::Uint8)(255 * (1 - t)), (sf::Uint8)(200 * (1 - t)), (sf::Uint8)(255 * t));
+
+            sf::Vector2f from = view.toScreen(c + 0.5f, r + 0.5f);
+            sf::Vector2f to(from.x + (next.second - c) * cellSize * 0.45f, from.y + (next.first - r) * cellSize * 0.45f);
+            lines.append(sf::Vertex(from, color));
+            lines.append(sf::Vertex(to, color));
         }
     }
+    return lines;
 }
 
+ // @brief Draws each agent as a square gliding from its previous cell to its
+ // current one ('progress' 0..1 of the move), with a small square of the same
+ // colour on its goal. Colours are spread around the hue wheel by index.
+sf::VertexArray buildAgentOverlay(const CooperativeAStar& agents,
+                                  const std::vector<std::pair<int, int>>& previous,
+                                  float progress,
+                                  const MazeView& view)
+{
+    sf::VertexArray quads(sf::Quads);
+    float cellSize = view.getZoom();
+    auto square = [&](float c, float r, float scale, sf::Color color) {
+        float half = std::max(1.5f, cellSize * scale / 2.0f);
+        sf::Vector2f center = view.toScreen(c + 0.5f, r + 0.5f);
+        quads.append(sf::Vertex({center.x - half, center.y - half}, color));
+        quads.append(sf::Vertex({center.x + half, center.y - half}, color));
+        quads.append(sf::Vertex({center.x + half, center.y + half}, color));
+        quads.append(sf::Vertex({center.x - half, center.y + half}, color));
+    };
 
+    for (int a = 0; a < agents.getAgentCount(); ++a) {
+        float hue = std::fmod(a * 0.618034f, 1.0f) * 6.0f;
+        float x = 1.0f - std::fabs(std::fmod(hue, 2.0f) - 1.0f);
+        float rgb[6][3] = {{1, x, 0}, {x, 1, 0}, {0, 1, x}, {0, x, 1}, {x, 0, 1}, {1, 0, x}};
+        float* mix = rgb[(int)hue % 6];
+        sf::Color color((sf::Uint8)(55 + 200 * mix[0]), (sf::Uint8)(55 + 200 * mix[1]), (sf::Uint8)(55 + 200 * mix[2]));
+
+        std::pair<int, int> goal = agents.getGoal(a);
+        square((float)goal.second, (float)goal.first, 0.35f, color);
+
+        std::pair<int, int> from = previous[a], to = agents.getPosition(a);
+        float r = from.first + (to.first - from.first) * progress;
+        float c = from.second + (to.second - from.second) * progress;
+        square(c, r, 0.8f, color);
+    }
+    return quads;
+}
 
  // @brief Helper function to create a solver by its index
 std::unique_ptr<Solver> createSolver(int index, Maze& maze) {
@@ -95,15 +169,172 @@ std::unique_ptr<Solver> createSolver(int index, Maze& maze) {
         case 2: return std::make_unique<AStar_Solver>(maze);
         case 3: return std::make_unique<Dijkstra_Solver>(maze);
         case 4: return std::make_unique<GreedyBestFirst_Solver>(maze);
+        case 5: return std::make_unique<ParallelBFS_Solver>(maze);
+        case 6: return std::make_unique<HDAStar_Solver>(maze);
         default: return nullptr;
     }
 }
 
 
-int main() {
+// @brief Plays back a recorded EventLog; the solver is never run again.
+// Space: play/pause, Left/Right: one step, Up/Down: speed x2 / /2,
+// Home/End: first/last step, 1-9: seek to 10%..90%; camera controls as in MazeView
+int runReplay(const std::string& path) {
+    EventLog log;
+    if (!log.load(path)) {
+        std::cerr << "Error: Could not read event log '" << path << "'.\n";
+        return 1;
+    }
+
+    const int rows = log.getRows(), cols = log.getCols();
+    const std::vector<std::string> baseGrid = log.baseGrid();
+
+    // Shrink cells so big mazes still fit on screen; the view can zoom in again
+    float cellSize = std::min(CELL_SIZE, std::min(MAX_MAZE_WIDTH / cols, MAX_MAZE_HEIGHT / rows));
+    unsigned int windowWidth = (unsigned int)(cols * cellSize + PADDING * 2);
+    unsigned int windowHeight = (unsigned int)(rows * cellSize + PADDING * 2 + TITLE_HEIGHT);
+    sf::RenderWindow window(sf::VideoMode(windowWidth, windowHeight), "Maze Solver Replay");
+
+    sf::Font font;
+    if (!font.loadFromFile("arial.ttf")) {
+        std::cerr << "Error: Could not load 'arial.ttf'.\n";
+        return -1;
+    }
+
+    const sf::Color expandedColor(0, 150, 255);
+    const sf::Color enqueuedColor(170, 215, 255);
+
+    // Events only ever recolour cells; the view redraws what is on screen
+    MazeView view(PADDING, PADDING + TITLE_HEIGHT, cols * cellSize, rows * cellSize);
+    view.setColors(expandedColor, enqueuedColor);
+
+    auto resetColors = [&]() { view.setGrid(baseGrid); };
+    auto applyEvent = [&](const EventLog::Event& e) { view.apply(e); };
+
+    EventLog::Cursor cursor(log);
+    resetColors();
+
+    // Seeking back restarts from the first step; decoding is far cheaper than solving
+    auto seek = [&](long target) {
+        TRACE_SCOPE("replay seek");
+        target = std::max(log.getFirstStep(), std::min(target, log.getStepCount()));
+        if (target < cursor.step()) {
+            cursor.reset();
+            resetColors();
+        }
+        cursor.advanceTo(target, applyEvent);
+    };
+
+    bool playing = true;
+    float stepsPerSecond = 200.0f;
+    float pendingSteps = 0.0f;
+    sf::Clock frameClock;
+
+    sf::Text titleText("", font, FONT_SIZE);
+    titleText.setPosition(PADDING, PADDING / 2.0f);
+    titleText.setFillColor(sf::Color::White);
+    sf::Text statusText("", font, 14);
+    statusText.setPosition(PADDING, PADDING / 2.0f + FONT_SIZE + 8.0f);
+    statusText.setFillColor(sf::Color(255, 255, 255, 150));
+
+    while (window.isOpen()) {
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) {
+                window.close();
+            }
+            if (view.handleEvent(event)) continue;
+            if (event.type != sf::Event::KeyPressed) continue;
+
+            switch (event.key.code) {
+                case sf::Keyboard::Space: playing = !playing; break;
+                case sf::Keyboard::Right: seek(cursor.step() + 1); break;
+                case sf::Keyboard::Left:  seek(cursor.step() - 1); break;
+                case sf::Keyboard::Up:    stepsPerSecond = std::min(stepsPerSecond * 2.0f, 1e7f); break;
+                case sf::Keyboard::Down:  stepsPerSecond = std::max(stepsPerSecond / 2.0f, 1.0f); break;
+                case sf::Keyboard::Home:  seek(log.getFirstStep()); break;
+                case sf::Keyboard::End:   seek(log.getStepCount()); break;
+                default:
+                    if (event.key.code >= sf::Keyboard::Num1 && event.key.code <= sf::Keyboard::Num9) {
+                        long span = log.getStepCount() - log.getFirstStep();
+                        seek(log.getFirstStep() + span * (event.key.code - sf::Keyboard::Num0) / 10);
+                    }
+                    break;
+            }
+        }
+
+        TRACE_SCOPE("frame");
+        float dt = frameClock.restart().asSeconds();
+        if (playing && cursor.step() < log.getStepCount()) {
+            pendingSteps += stepsPerSecond * dt;
+            long whole = (long)pendingSteps;
+            pendingSteps -= whole;
+            seek(cursor.step() + whole);
+        }
+
+        titleText.setString("Replay: " + log.getAlgorithm() + "   step " + std::to_string(cursor.step()) +
+                            " / " + std::to_string(log.getStepCount()) + "   " +
+                            std::to_string((long)stepsPerSecond) + " steps/s" + (playing ? "" : "  (paused)"));
+        statusText.setString(viewStatus(view));
+
+        window.clear(sf::Color(20, 20, 20));
+        window.draw(titleText);
+        window.draw(statusText);
+        view.draw(window);
+        TRACE_SCOPE("display");
+        window.display();
+    }
+    return 0;
+}
+
+
+// Trace file from "--trace <file>" (see Trace.h); written when the program exits
+static std::string g_tracePath;
+
+static void writeTrace() {
+    if (Trace::write(g_tracePath)) {
+        std::cerr << "Trace: " << Trace::getEventCount() << " events written to " << g_tracePath << "\n";
+    } else {
+        std::cerr << "Error: Could not write trace '" << g_tracePath << "'.\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // "--trace <file>" can go anywhere; it is removed before the other arguments are read
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) != "--trace") continue;
+        g_tracePath = argv[i + 1];
+        for (int j = i; j + 2 <= argc; ++j) argv[j] = argv[j + 2];
+        argc -= 2;
+        Trace::enable();
+        Trace::setThreadName("main");
+        std::atexit(writeTrace);
+        break;
+    }
+
+    // Replaying a recorded run opens its own window
+    if (argc > 2 && std::string(argv[1]) == "replay") {
+        return runReplay(argv[2]);
+    }
+
+    // "window [rows] [cols] [seed] [wall-density]" opens the visualizer on
+    // another maze; any other arguments select a headless command
+    bool windowCommand = argc > 1 && std::string(argv[1]) == "window";
+    if (argc > 1 && !windowCommand) {
+        return runHeadless(argc, argv);
+    }
+
     // Base maze
-    const int R = 31, C = 51; 
-    Maze baseMaze(R, C);
+    int R = 31, C = 51; 
+    unsigned seed = 0;
+    int wallDensity = 25;
+    if (windowCommand) {
+        if (argc > 2) R = std::max(5, std::atoi(argv[2]));
+        if (argc > 3) C = std::max(5, std::atoi(argv[3]));
+        if (argc > 4) seed = (unsigned)std::atoi(argv[4]);
+        if (argc > 5) wallDensity = std::atoi(argv[5]);
+    }
+    Maze baseMaze(R, C, seed, wallDensity);
     Maze mazeCopy = baseMaze; 
 
     // All Algorithms implemented
@@ -113,14 +344,18 @@ int main() {
         "2. Depth-First Search (DFS)",
         "3. A* Search",
         "4. Dijkstra's Algorithm",
-        "5. Greedy Best-First Search"
+        "5. Greedy Best-First Search",
+        "6. Parallel BFS",
+        "7. Hash-Distributed A* (HDA*)"
     };
     std::vector<sf::Color> traversalColors = {
         sf::Color(0, 150, 255),  // BFS (Blue)
         sf::Color(0, 200, 100),  // DFS (Green)
         sf::Color(200, 0, 200),  // A* (Purple)
         sf::Color(255, 150, 0),  // Dijkstra (Orange)
-        sf::Color(0, 200, 200)   // Greedy (Cyan)
+        sf::Color(0, 200, 200),  // Greedy (Cyan)
+        sf::Color(100, 100, 255), // Parallel BFS (Indigo)
+        sf::Color(255, 100, 150)  // HDA* (Pink)
     };
     int currentAlgoIndex = 0;
 
@@ -128,9 +363,10 @@ int main() {
     std::map<std::string, AlgoStats> results;
     int shortestPath = std::numeric_limits<int>::max();
 
-    // SFML Window Setup
-    const float mazeWidth = baseMaze.getCols() * CELL_SIZE;
-    const float mazeHeight = baseMaze.getRows() * CELL_SIZE;
+    // SFML Window Setup (big mazes start zoomed out to fit)
+    const float cellSize = std::min(CELL_SIZE, std::min(MAX_MAZE_WIDTH / C, MAX_MAZE_HEIGHT / R));
+    const float mazeWidth = baseMaze.getCols() * cellSize;
+    const float mazeHeight = baseMaze.getRows() * cellSize;
     unsigned int windowWidth = (unsigned int)(mazeWidth + PADDING * 2);
     unsigned int windowHeight = (unsigned int)(mazeHeight + PADDING * 2 + TITLE_HEIGHT);
 
@@ -158,24 +394,131 @@ int main() {
     baseGrid[baseStart.first][baseStart.second] = 'S';
     baseGrid[baseGoal.first][baseGoal.second] = 'E';
 
+    // Pan/zoom view; it is fed the cells each step changes, never whole grids
+    MazeView view(PADDING, PADDING + TITLE_HEIGHT, mazeWidth, mazeHeight);
+    view.setGrid(baseGrid);
+
+    // Solver events of one tick, applied to the view and then dropped
+    EventLog tickEvents(R, C);
+
+    // Steps per tick; big mazes start faster (Up/Down to change)
+    int stepsPerTick = std::max(1, R * C / 2000);
+
+    // Flow field towards the goal, drawn over the grid with [F]; built on first use
+    FlowField flowField;
+    bool showFlow = false;
+
+    // Agents moving to their own goals without colliding, toggled with [M]
+    // on the base maze
+    std::unique_ptr<CooperativeAStar> agentSim;
+    std::vector<std::pair<int, int>> agentPrevious;
+    sf::Clock agentClock;
+    unsigned agentRounds = 0; // New agents every time
+
+    // Live readings, toggled with [H]
+    PerfHud hud;
+
+    // Finished runs are cached, so replaying the same maze shows results at once
+    ResultCache resultCache;
+    bool showingCached = false; // A cached result is shown instead of a live solver
+
+    // Stores the stats of the current algorithm for the results screen
+    auto recordStats = [&](const AlgoStats& stats) {
+        results[titles[currentAlgoIndex]] = stats; 
+
+        // Update "true" shortest path from complete algorithms
+        if (stats.pathFound && (titles[currentAlgoIndex].find("BFS") != std::string::npos || 
+                               titles[currentAlgoIndex].find("A*") != std::string::npos || 
+                               titles[currentAlgoIndex].find("Dijkstra") != std::string::npos)) 
+        {
+            if (stats.pathLength < shortestPath) {
+                shortestPath = stats.pathLength;
+            }
+        }
+    };
+
+    // Starts the current algorithm, or shows its cached result straight away
+    auto startAlgorithm = [&]() {
+        mazeCopy = baseMaze; // Refresh the maze
+        const ResultCache::Entry* hit = resultCache.find(mazeCopy, titles[currentAlgoIndex]);
+        view.setColors(traversalColors[currentAlgoIndex], sf::Color::White);
+        if (hit) {
+            currentSolver = nullptr;
+            std::vector<std::string> cachedGrid = hit->renderGrid(mazeCopy, '.');
+            cachedGrid[baseStart.first][baseStart.second] = 'S';
+            cachedGrid[baseGoal.first][baseGoal.second] = 'E';
+            view.setGrid(cachedGrid);
+            showingCached = true;
+
+            AlgoStats stats;
+            stats.nodesExplored = hit->nodesExplored;
+            stats.pathLength = hit->pathLength;
+            stats.timeTakenMs = hit->timeTaken.asMicroseconds() / 1000.0f;
+            stats.pathFound = hit->found;
+            recordStats(stats);
+            state = VizState::Paused;
+        } else {
+            showingCached = false;
+            view.setGrid(baseGrid);
+            currentSolver = createSolver(currentAlgoIndex, mazeCopy);
+            currentSolver->setEventLog(&tickEvents);
+            state = VizState::Running;
+        }
+        stepClock.restart();
+        hud.reset();
+    };
+
 
     // Main loop
     while (window.isOpen()) {
-        
+        TRACE_SCOPE("frame");
+        hud.beginFrame();
+
         sf::Event event;
         while (window.pollEvent(event)) {
             if (event.type == sf::Event::Closed) {
                 window.close();
             }
+            if (view.handleEvent(event)) continue;
             
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F) {
+                showFlow = !showFlow;
+                if (showFlow && flowField.getRows() == 0) flowField.build(baseMaze);
+            }
+
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::M && state == VizState::Starting) {
+                if (agentSim) {
+                    agentSim = nullptr;
+                } else {
+                    // About one agent per 25 open cells
+                    int open = 0;
+                    for (const std::string& row : baseMaze.grid) open += (int)std::count(row.begin(), row.end(), ' ');
+                    int count = std::max(4, std::min(open / 25, 300));
+                    auto agents = CooperativeAStar::randomAgents(baseMaze, count, seed + ++agentRounds);
+                    agentSim = std::make_unique<CooperativeAStar>(baseMaze, agents, 8);
+                    agentPrevious.clear();
+                    for (int a = 0; a < agentSim->getAgentCount(); ++a) agentPrevious.push_back(agentSim->getPosition(a));
+                    agentClock.restart();
+                }
+            }
+
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::H) {
+                hud.toggle();
+            }
+
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Up) {
+                stepsPerTick = std::min(stepsPerTick * 2, 1 << 24);
+            }
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Down) {
+                stepsPerTick = std::max(stepsPerTick / 2, 1);
+            }
+
             if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Space) {
                 
                 if (state == VizState::Starting) {
                     // Start the first algorithm 
-                    mazeCopy = baseMaze; // Refresh the maze
-                    currentSolver = createSolver(currentAlgoIndex, mazeCopy);
-                    state = VizState::Running;
-                    stepClock.restart();
+                    agentSim = nullptr;
+                    startAlgorithm();
                 } 
                 else if (state == VizState::Paused) {
                     // Move to next screen
@@ -183,12 +526,10 @@ int main() {
                     if (currentAlgoIndex >= titles.size()) {
                         state = VizState::ShowingResults;
                         currentSolver = nullptr; // Clear the solver
+                        showingCached = false;
                     } 
                     else {
-                        mazeCopy = baseMaze; // Refresh the maze
-                        currentSolver = createSolver(currentAlgoIndex, mazeCopy);
-                        state = VizState::Running;
-                        stepClock.restart();
+                        startAlgorithm();
                     }
                 }
                 // Results screen
@@ -196,6 +537,7 @@ int main() {
                     currentAlgoIndex = 0;
                     results.clear(); // Clear the std::map
                     shortestPath = std::numeric_limits<int>::max();
+                    view.setGrid(baseGrid);
                     state = VizState::Starting;
                 }
             }
@@ -205,7 +547,20 @@ int main() {
         if (state == VizState::Running && currentSolver && !currentSolver->isFinished()) {
             if (stepClock.getElapsedTime() > TIME_PER_STEP) {
                 stepClock.restart();
-                currentSolver->step();
+                sf::Clock stepTimer;
+                {
+                    TRACE_SCOPE(currentSolver->isSearching() ? "step" : "trace step");
+                    for (int i = 0; i < stepsPerTick && !currentSolver->isFinished(); ++i) {
+                        currentSolver->step();
+                        tickEvents.endStep();
+                    }
+                }
+
+                // Only the cells this tick touched reach the view
+                EventLog::Cursor cursor(tickEvents);
+                cursor.advanceTo(tickEvents.getStepCount(), [&](const EventLog::Event& e) { view.apply(e); });
+                tickEvents = EventLog(R, C);
+                hud.addStepTime(stepTimer.getElapsedTime());
                 
                 // When it finishes, change state
                 if (currentSolver->isFinished()) {
@@ -216,43 +571,55 @@ int main() {
                     AlgoStats stats;
                     stats.nodesExplored = currentSolver->getNodesExplored();
                     stats.pathLength = currentSolver->getPathLength();
-                    stats.timeTakenMs = currentSolver->getTimeTaken().asMilliseconds(); 
+                    stats.timeTakenMs = currentSolver->getTimeTaken().asMicroseconds() / 1000.0f;
                     stats.pathFound = currentSolver->isPathFound();
                     
-                    results[titles[currentAlgoIndex]] = stats; 
-
-                    // Update "true" shortest path from complete algorithms
-                    if (stats.pathFound && (titles[currentAlgoIndex].find("BFS") != std::string::npos || 
-                                           titles[currentAlgoIndex].find("A*") != std::string::npos || 
-                                           titles[currentAlgoIndex].find("Dijkstra") != std::string::npos)) 
-                    {
-                        if (stats.pathLength < shortestPath) {
-                            shortestPath = stats.pathLength;
-                        }
-                    }
+                    recordStats(stats);
+                    resultCache.store(mazeCopy, titles[currentAlgoIndex], *currentSolver);
                 }
             }
         }
         
+        // One move for every agent per TIME_PER_AGENT_MOVE
+        if (agentSim && agentClock.getElapsedTime() > TIME_PER_AGENT_MOVE) {
+            agentClock.restart();
+            for (int a = 0; a < agentSim->getAgentCount(); ++a) agentPrevious[a] = agentSim->getPosition(a);
+            agentSim->step();
+        }
+
+        // Sampled between ticks, outside the solver's own timing
+        hud.sample(currentSolver.get());
+        sf::Clock drawTimer;
+
         window.clear(sf::Color(20, 20, 20));
 
+        std::string status = viewStatus(view);
         if (state == VizState::Starting) {
             // Draw the base maze
-            drawMaze(window, baseGrid, font, "Base Maze (Press Space)", sf::Color::Transparent);
+            if (agentSim) {
+                const CooperativeAStar::Stats& stats = agentSim->getStats();
+                status += "   Agents: " + std::to_string(agentSim->getArrived()) + "/" +
+                          std::to_string(agentSim->getAgentCount()) + " home, move " + std::to_string(stats.ticks) +
+                          ", " + std::to_string(stats.collisions) + " collisions";
+            }
+            drawMaze(window, view, font, "Base Maze (Press Space, F: flow field, H: HUD, M: agents)", status);
+            if (showFlow) view.drawClipped(window, buildFlowOverlay(flowField, view));
+            if (agentSim) {
+                float progress = std::min(1.0f, agentClock.getElapsedTime().asSeconds() / TIME_PER_AGENT_MOVE.asSeconds());
+                view.drawClipped(window, buildAgentOverlay(*agentSim, agentPrevious, progress, view));
+            }
         } 
-        else if (currentSolver) { 
-            // Get the solver's current grid (likely a std::vector<std::string>)
-            auto grid = currentSolver->getGrid();
-            // Add Start/End back in
-            grid[baseStart.first][baseStart.second] = 'S';
-            grid[baseGoal.first][baseGoal.second] = 'E';
-
-            // Draw the solver's grid
-            drawMaze(window, grid, font, titles[currentAlgoIndex], traversalColors[currentAlgoIndex]);
+        else if (currentSolver || showingCached) { 
+            // Draw the solver's cells, kept up to date from its events
+            std::string title = titles[currentAlgoIndex] + (currentSolver ? "" : " (cached)");
+            status += "   Up/Down: speed (" + std::to_string(stepsPerTick) + " steps per tick)";
+            drawMaze(window, view, font, title, status);
+            if (showFlow) view.drawClipped(window, buildFlowOverlay(flowField, view));
             
             if (state == VizState::Paused) {
                 window.draw(instructionText);
             }
+            hud.draw(window, font, windowWidth - PADDING, PADDING + TITLE_HEIGHT + 10.0f);
         }
         else if (state == VizState::ShowingResults) {
             window.clear(sf::Color::White); // White background for results
@@ -335,6 +702,8 @@ int main() {
             window.draw(resetText);
         }
 
+        hud.addDrawTime(drawTimer.getElapsedTime());
+        TRACE_SCOPE("display");
         window.display();
     }
 